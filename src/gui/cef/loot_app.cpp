@@ -25,6 +25,9 @@
 
 #include "gui/cef/loot_app.h"
 
+#include <algorithm>
+#include <chrono>
+
 #include <include/views/cef_browser_view.h>
 #include <include/views/cef_window.h>
 #include <boost/locale.hpp>
@@ -32,6 +35,7 @@
 #include "gui/cef/loot_handler.h"
 #include "gui/cef/loot_scheme_handler_factory.h"
 #include "gui/cef/window_delegate.h"
+#include "gui/state/auto_sort.h"
 #include "gui/state/logging.h"
 #include "gui/state/loot_paths.h"
 
@@ -41,7 +45,8 @@ CommandLineOptions::CommandLineOptions() : CommandLineOptions(0, nullptr) {}
 #endif
 
 CommandLineOptions::CommandLineOptions(int argc, const char* const* argv) :
-    autoSort(false) {
+    autoSort(false),
+    updateMasterlists(false) {
   // Record command line arguments.
   CefRefPtr<CefCommandLine> command_line = CefCommandLine::CreateCommandLine();
 
@@ -63,7 +68,12 @@ CommandLineOptions::CommandLineOptions(int argc, const char* const* argv) :
     lootDataPath = command_line->GetSwitchValue("loot-data-path");
   }
 
+  if (command_line->HasSwitch("trace-file")) {
+    traceFile = command_line->GetSwitchValue("trace-file");
+  }
+
   autoSort = command_line->HasSwitch("auto-sort");
+  updateMasterlists = command_line->HasSwitch("update-masterlists");
 }
 
 LootApp::LootApp(CommandLineOptions options) :
@@ -74,6 +84,92 @@ std::filesystem::path LootApp::getL10nPath() const {
   return lootState_.getL10nPath();
 }
 
+int LootApp::RunAutoSort() {
+  auto start = std::chrono::steady_clock::now();
+
+  lootState_.init(commandLineOptions_.defaultGame, true);
+  lootState_.waitForInit();
+
+  auto logger = getLogger();
+  if (!lootState_.getInitErrors().empty()) {
+    if (logger) {
+      for (const auto& error : lootState_.getInitErrors()) {
+        logger->error("Auto-sort could not start. {}", error);
+      }
+    }
+    return 1;
+  }
+
+  Timeline timeline;
+  bool succeeded = false;
+  try {
+    succeeded = AutoSort(lootState_.GetCurrentGame(),
+                         lootState_.updateMasterlist(),
+                         timeline);
+  } catch (std::exception& e) {
+    if (logger) {
+      logger->error("Auto-sort failed. Error: {}", e.what());
+    }
+  }
+  timeline.Log("Auto-sort timeline");
+
+  try {
+    lootState_.save(lootState_.getSettingsPath());
+  } catch (std::exception& e) {
+    if (logger) {
+      logger->error("Failed to save LOOT's settings. Error: {}", e.what());
+    }
+  }
+
+  if (logger) {
+    logger->info(
+        "Auto-sort {} after {} ms.",
+        succeeded ? "succeeded" : "failed",
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+  }
+
+  return succeeded ? 0 : 1;
+}
+
+int LootApp::RunMasterlistUpdates() {
+  lootState_.init(commandLineOptions_.defaultGame, false);
+  lootState_.waitForInit();
+
+  auto logger = getLogger();
+  if (!lootState_.getInitErrors().empty()) {
+    if (logger) {
+      for (const auto& error : lootState_.getInitErrors()) {
+        logger->error("Masterlist updates could not start. {}", error);
+      }
+    }
+    return 1;
+  }
+
+  // The summaries are logged as the updates finish.
+  auto summaries = lootState_.UpdateAllMasterlists();
+  auto failed = std::any_of(
+      summaries.cbegin(),
+      summaries.cend(),
+      [](const GamesManager::MasterlistUpdateSummary& summary) {
+        return summary.error.has_value();
+      });
+
+  return failed ? 1 : 0;
+}
+
+void LootApp::FlushSettings() {
+  try {
+    lootState_.flushAutoSave();
+  } catch (std::exception& e) {
+    auto logger = getLogger();
+    if (logger) {
+      logger->error("Failed to save LOOT's settings. Error: {}", e.what());
+    }
+  }
+}
+
 void LootApp::OnBeforeCommandLineProcessing(
     const CefString& process_type,
     CefRefPtr<CefCommandLine> command_line) {
@@ -98,9 +194,12 @@ void LootApp::OnContextInitialized() {
   // Make sure this is running in the UI thread.
   assert(CefCurrentlyOn(TID_UI));
 
-  // Initialise LOOT's state.
+  // Initialise LOOT's state. Games are initialised in the background while
+  // the browser is created.
   lootState_.init(commandLineOptions_.defaultGame, commandLineOptions_.autoSort);
 
+  auto browserCreationStart = std::chrono::steady_clock::now();
+
   // Set the handler for browser-level callbacks.
   CefRefPtr<LootHandler> handler(new LootHandler(lootState_));
 
@@ -123,6 +222,14 @@ void LootApp::OnContextInitialized() {
 
   CefWindow::CreateTopLevelWindow(
       new WindowDelegate(browser_view, lootState_.getWindowPosition()));
+
+  lootState_.getStartupTimeline().Record("Browser creation",
+                                         browserCreationStart,
+                                         std::chrono::steady_clock::now());
+
+  // Queries are created on this thread, so blocking here ensures that game
+  // state is ready before any query can use it.
+  lootState_.waitForInit();
 }
 
 void LootApp::OnWebKitInitialized() {
@@ -40,8 +40,10 @@ struct CommandLineOptions {
   CommandLineOptions(int argc, const char *const *argv);
 
   bool autoSort;
+  bool updateMasterlists;
   std::string defaultGame;
   std::string lootDataPath;
+  std::string traceFile;
 };
 
 class LootApp : public CefApp,
@@ -52,6 +54,19 @@ public:
 
   std::filesystem::path getL10nPath() const;
 
+  // Sorts and applies the load order of the game given on the command line
+  // without creating a browser, and returns the process exit code.
+  int RunAutoSort();
+
+  // Updates the masterlists of all installed games without creating a
+  // browser, and returns the process exit code.
+  int RunMasterlistUpdates();
+
+  // Blocks until any settings changes that are being saved in the background
+  // have been written. A failed save is logged, as LOOT's window has closed
+  // by the time this is called.
+  void FlushSettings();
+
   // Override CefApp methods.
   virtual void OnBeforeCommandLineProcessing(
       const CefString& process_type,
@@ -35,12 +35,17 @@
 #include <include/views/cef_browser_view.h>
 #include <include/views/cef_window.h>
 #include <boost/algorithm/string.hpp>
+#include <boost/format.hpp>
+#include <boost/locale.hpp>
 
 #include "gui/cef/loot_scheme_handler_factory.h"
 #include "gui/cef/query/query_handler.h"
 #include "gui/helpers.h"
 #include "gui/state/loot_paths.h"
 
+#undef min
+#include <json.hpp>
+
 namespace loot {
 LootSettings::WindowPosition getWindowPosition(CefRefPtr<CefBrowser> browser) {
   auto browserView = CefBrowserView::GetForBrowser(browser);
@@ -172,14 +177,32 @@ bool LootHandler::DoClose(CefRefPtr<CefBrowser> browser) {
   }
 
   try {
-    lootState_.save(lootState_.getSettingsPath());
+    lootState_.FlushPendingWrites();
+    lootState_.flushAutoSave();
   } catch (std::exception& e) {
     auto logger = getLogger();
     if (logger) {
-      logger->error("Failed to save LOOT's settings. Error: {}", e.what());
+      logger->error("Failed to save changes before closing: {}", e.what());
     }
+
+    // Keep the window open so that the user sees the error. The error has
+    // been cleared, so closing again will succeed.
+    auto message = (boost::format(boost::locale::translate(
+                        "Some of your changes could not be saved. Details: "
+                        "%1%")) %
+                    e.what())
+                       .str();
+    browser->GetMainFrame()->ExecuteJavaScript(
+        "loot.onWriteError(" + nlohmann::json(message).dump() + ");",
+        browser->GetMainFrame()->GetURL(),
+        0);
+    return true;
   }
 
+  // The settings are saved in the background, and LOOT waits for the save to
+  // finish once CEF has shut down.
+  lootState_.storeLastGameAndVersion();
+
   // Allow the close. For windowed browsers this will result in the OS close
   // event being sent.
   return false;
@@ -48,7 +48,7 @@ public:
       isMaster(file->IsMaster()),
       isLightMaster(file->IsLightMaster()),
       loadsArchive(file->LoadsArchive()),
-      crc(file->GetCRC()),
+      crc(game.FindPluginCrc(*file)),
       loadOrderIndex(game.GetActiveLoadOrderIndex(file, game.GetLoadOrder())),
       currentTags(file->GetBashTags()),
       language(language) {}
@@ -34,6 +34,7 @@ along with LOOT.  If not, see
 
 #include "gui/cef/query/derived_plugin_metadata.h"
 #include "gui/state/loot_settings.h"
+#include "gui/state/tracing.h"
 
 namespace loot {
 void testConditionSyntax(const std::string& objectType,
@@ -379,6 +380,8 @@ void from_json(const nlohmann::json& json, PluginMetadata& metadata) {
 
 template<typename G>
 void to_json(nlohmann::json& json, const DerivedPluginMetadata<G>& plugin) {
+  TraceSpan span("Convert derived metadata to JSON", plugin.name);
+
   json = {
     { "name", plugin.name },
     { "isActive", plugin.isActive },
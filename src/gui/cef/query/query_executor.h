@@ -33,11 +33,13 @@ along with LOOT.  If not, see
 
 #include "gui/cef/query/query.h"
 #include "gui/state/logging.h"
+#include "gui/state/tracing.h"
 
 namespace loot {
 class QueryExecutor : public CefBaseRefCounted {
 public:
-  QueryExecutor(std::unique_ptr<Query> query) :
+  QueryExecutor(const std::string& name, std::unique_ptr<Query> query) :
+      name_(name),
       query_(std::move(query)),
       genericErrorMessage_(
           boost::locale::translate(
@@ -47,13 +49,16 @@ public:
               .str()) {}
 
   void execute(CefRefPtr<CefMessageRouterBrowserSide::Callback> callback) {
+    TraceSpan span("Query", name_);
     try {
+      recordTraceEvent("Executing query", name_);
       callback->Success(query_->executeLogic());
     } catch (std::exception& e) {
       auto logger = getLogger();
       if (logger) {
         logger->error("Exception while executing query: {}", e.what());
       }
+      logRecentTraceEvents("The query failed");
 
       callback->Failure(
           -1, query_->getErrorMessage().value_or(genericErrorMessage_));
@@ -61,6 +66,7 @@ public:
   }
 
 private:
+  const std::string name_;
   const std::unique_ptr<Query> query_;
   const std::string genericErrorMessage_;
 
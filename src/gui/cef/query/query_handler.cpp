@@ -38,6 +38,7 @@
 #include "gui/cef/loot_app.h"
 #include "gui/cef/loot_handler.h"
 #include "gui/cef/query/query_executor.h"
+#include "gui/cef/query/types/apply_load_order_profile_query.h"
 #include "gui/cef/query/types/apply_sort_query.h"
 #include "gui/cef/query/types/cancel_sort_query.h"
 #include "gui/cef/query/types/change_game_query.h"
@@ -47,6 +48,8 @@
 #include "gui/cef/query/types/copy_content_query.h"
 #include "gui/cef/query/types/copy_load_order_query.h"
 #include "gui/cef/query/types/copy_metadata_query.h"
+#include "gui/cef/query/types/delete_load_order_profile_query.h"
+#include "gui/cef/query/types/diff_load_order_profile_query.h"
 #include "gui/cef/query/types/discard_unapplied_changes_query.h"
 #include "gui/cef/query/types/editor_closed_query.h"
 #include "gui/cef/query/types/editor_opened_query.h"
@@ -56,15 +59,20 @@
 #include "gui/cef/query/types/get_game_types_query.h"
 #include "gui/cef/query/types/get_init_errors_query.h"
 #include "gui/cef/query/types/get_installed_games_query.h"
+#include "gui/cef/query/types/get_load_order_profiles_query.h"
 #include "gui/cef/query/types/get_settings_query.h"
 #include "gui/cef/query/types/get_themes_query.h"
 #include "gui/cef/query/types/get_version_query.h"
 #include "gui/cef/query/types/open_log_location_query.h"
 #include "gui/cef/query/types/open_readme_query.h"
+#include "gui/cef/query/types/prepare_sort_query.h"
 #include "gui/cef/query/types/redate_plugins_query.h"
+#include "gui/cef/query/types/restore_load_order_query.h"
 #include "gui/cef/query/types/save_filter_state_query.h"
+#include "gui/cef/query/types/save_load_order_profile_query.h"
 #include "gui/cef/query/types/save_user_groups_query.h"
 #include "gui/cef/query/types/sort_plugins_query.h"
+#include "gui/cef/query/types/update_all_masterlists_query.h"
 #include "gui/cef/query/types/update_masterlist_query.h"
 
 #undef min
@@ -76,8 +84,38 @@ void sendProgressUpdate(CefRefPtr<CefFrame> frame, const std::string& message) {
   if (logger) {
     logger->trace("Sending progress update: {}", message);
   }
-  frame->ExecuteJavaScript(
-      "loot.showProgress('" + message + "');", frame->GetURL(), 0);
+  frame->ExecuteJavaScript("loot.showProgress(" +
+                               nlohmann::json(message).dump() + ");",
+                           frame->GetURL(),
+                           0);
+}
+
+void sendMasterlistUpdate(CefRefPtr<CefFrame> frame,
+                          const std::string& gameFolder) {
+  auto logger = getLogger();
+  if (logger) {
+    logger->trace("Sending masterlist update for game: {}", gameFolder);
+  }
+  // Game folder names are set by the user, so encode the name as a JSON
+  // string to get a valid JavaScript string literal.
+  frame->ExecuteJavaScript("loot.onMasterlistUpdate(" +
+                               nlohmann::json(gameFolder).dump() + ");",
+                           frame->GetURL(),
+                           0);
+}
+
+void sendSortPrepared(CefRefPtr<CefFrame> frame,
+                      const std::string& gameFolder,
+                      bool loadOrderIsSorted) {
+  auto logger = getLogger();
+  if (logger) {
+    logger->trace("Sending background sort result for game: {}", gameFolder);
+  }
+  frame->ExecuteJavaScript("loot.onSortPrepared(" +
+                               nlohmann::json(gameFolder).dump() + ", " +
+                               nlohmann::json(loadOrderIsSorted).dump() + ");",
+                           frame->GetURL(),
+                           0);
 }
 
 QueryHandler::QueryHandler(LootState& lootState) : lootState_(lootState) {}
@@ -90,12 +128,22 @@ bool QueryHandler::OnQuery(CefRefPtr<CefBrowser> browser,
                            bool persistent,
                            CefRefPtr<Callback> callback) {
   try {
-    auto query = createQuery(browser, frame, request.ToString());
+    auto json = nlohmann::json::parse(request.ToString());
+    const std::string name = json.at("name");
+
+    if (name != "prepareSort" && name != "sortPlugins") {
+      // Sorting uses the result of a background sort, but anything else is
+      // likely to make it stale.
+      cancelBackgroundSort();
+    }
+
+    auto query = createQuery(browser, frame, name, json);
 
     if (!query)
       return false;
 
-    CefRefPtr<QueryExecutor> executor = new QueryExecutor(std::move(query));
+    CefRefPtr<QueryExecutor> executor =
+        new QueryExecutor(name, std::move(query));
 
     CefPostTask(TID_FILE,
                 base::Bind(&QueryExecutor::execute, executor, callback));
@@ -112,15 +160,36 @@ bool QueryHandler::OnQuery(CefRefPtr<CefBrowser> browser,
   return true;
 }
 
+std::function<void(std::string)> QueryHandler::getMasterlistUpdateSender(
+    CefRefPtr<CefFrame> frame) const {
+  if (!lootState_.updateMasterlist()) {
+    return nullptr;
+  }
+
+  return [frame](std::string gameFolder) {
+    sendMasterlistUpdate(frame, gameFolder);
+  };
+}
+
+void QueryHandler::cancelBackgroundSort() {
+  try {
+    lootState_.GetCurrentGame().CancelBackgroundSort();
+  } catch (std::runtime_error&) {
+    // There's no current game, so there's nothing to cancel.
+  }
+}
+
 std::unique_ptr<Query> QueryHandler::createQuery(
     CefRefPtr<CefBrowser> browser,
     CefRefPtr<CefFrame> frame,
-    const std::string& requestString) {
-  nlohmann::json json = nlohmann::json::parse(requestString);
+    const std::string& name,
+    const nlohmann::json& json) {
+  recordTraceEvent("Received query", name);
 
-  const std::string name = json.at("name");
-
-  if (name == "applySort") {
+  if (name == "applyLoadOrderProfile") {
+    return std::make_unique<ApplyLoadOrderProfileQuery<>>(
+        lootState_.GetCurrentGame(), json.at("profileName"));
+  } else if (name == "applySort") {
     return std::make_unique<ApplySortQuery<>>(
         lootState_.GetCurrentGame(), lootState_, json.at("pluginNames"));
   } else if (name == "cancelSort") {
@@ -131,7 +200,8 @@ std::unique_ptr<Query> QueryHandler::createQuery(
         lootState_,
         lootState_.getLanguage(),
         json.at("gameFolder"),
-        [frame](std::string message) { sendProgressUpdate(frame, message); });
+        [frame](std::string message) { sendProgressUpdate(frame, message); },
+        getMasterlistUpdateSender(frame));
   } else if (name == "clearAllMetadata") {
     return std::make_unique<ClearAllMetadataQuery<>>(lootState_.GetCurrentGame(),
                                                    lootState_.getLanguage());
@@ -152,6 +222,16 @@ std::unique_ptr<Query> QueryHandler::createQuery(
     return std::make_unique<CopyMetadataQuery<>>(lootState_.GetCurrentGame(),
                                                lootState_.getLanguage(),
                                                json.at("pluginName"));
+  } else if (name == "deleteLoadOrderProfile") {
+    return std::make_unique<DeleteLoadOrderProfileQuery<>>(
+        lootState_.GetCurrentGame(), json.at("profileName"));
+  } else if (name == "diffLoadOrderProfile") {
+    std::optional<std::string> baseProfileName;
+    if (json.count("baseProfileName") > 0) {
+      baseProfileName = json.at("baseProfileName").get<std::string>();
+    }
+    return std::make_unique<DiffLoadOrderProfileQuery<>>(
+        lootState_.GetCurrentGame(), json.at("profileName"), baseProfileName);
   } else if (name == "discardUnappliedChanges") {
     return std::make_unique<DiscardUnappliedChangesQuery>(lootState_);
   } else if (name == "editorClosed") {
@@ -160,23 +240,36 @@ std::unique_ptr<Query> QueryHandler::createQuery(
                                                lootState_.getLanguage(),
                                                json.at("editorState"));
   } else if (name == "editorOpened") {
-    return std::make_unique<EditorOpenedQuery>(lootState_);
+    return std::make_unique<EditorOpenedQuery<>>(lootState_.GetCurrentGame(),
+                                                 lootState_);
   } else if (name == "getConflictingPlugins") {
     return std::make_unique<GetConflictingPluginsQuery<>>(
         lootState_.GetCurrentGame(),
         lootState_.getLanguage(),
-        json.at("pluginName"));
+        json.at("pluginName"),
+        json.value("namesOnly", false));
   } else if (name == "getGameTypes") {
     return std::make_unique<GetGameTypesQuery>();
   } else if (name == "getGameData") {
     return std::make_unique<GetGameDataQuery<>>(
         lootState_.GetCurrentGame(),
         lootState_.getLanguage(),
-        [frame](std::string message) { sendProgressUpdate(frame, message); });
+        [frame](std::string message) { sendProgressUpdate(frame, message); },
+        true,
+        getMasterlistUpdateSender(frame));
   } else if (name == "getInitErrors") {
     return std::make_unique<GetInitErrorsQuery>(lootState_);
   } else if (name == "getInstalledGames") {
     return std::make_unique<GetInstalledGamesQuery>(lootState_);
+  } else if (name == "getLoadOrderProfiles") {
+    return std::make_unique<GetLoadOrderProfilesQuery<>>(
+        lootState_.GetCurrentGame());
+  } else if (name == "getReconciledGameData") {
+    return std::make_unique<GetGameDataQuery<>>(
+        lootState_.GetCurrentGame(),
+        lootState_.getLanguage(),
+        [frame](std::string message) { sendProgressUpdate(frame, message); },
+        false);
   } else if (name == "getSettings") {
     return std::make_unique<GetSettingsQuery>(lootState_);
   } else if (name == "getThemes") {
@@ -189,8 +282,18 @@ std::unique_ptr<Query> QueryHandler::createQuery(
     return std::make_unique<OpenReadmeQuery>(
         lootState_.getReadmePath(),
         json.at("relativeFilePath").get<std::string>());
+  } else if (name == "prepareSort") {
+    return std::make_unique<PrepareSortQuery<>>(
+        lootState_.GetCurrentGame(),
+        [frame](std::string gameFolder, bool loadOrderIsSorted) {
+          sendSortPrepared(frame, gameFolder, loadOrderIsSorted);
+        });
   } else if (name == "redatePlugins") {
-    return std::make_unique<RedatePluginsQuery<>>(lootState_.GetCurrentGame());
+    return std::make_unique<RedatePluginsQuery<>>(
+        lootState_.GetCurrentGame(), json.value("dryRun", false));
+  } else if (name == "restoreLoadOrder") {
+    return std::make_unique<RestoreLoadOrderQuery<>>(
+        lootState_.GetCurrentGame(), json.value("age", size_t(0)));
   } else if (name == "saveUserGroups") {
     return std::make_unique<SaveUserGroupsQuery<>>(lootState_.GetCurrentGame(),
                                                  json.at("userGroups"));
@@ -199,15 +302,22 @@ std::unique_ptr<Query> QueryHandler::createQuery(
         lootState_,
         json.at("filter").at("name"),
         json.at("filter").at("state"));
+  } else if (name == "saveLoadOrderProfile") {
+    return std::make_unique<SaveLoadOrderProfileQuery<>>(
+        lootState_.GetCurrentGame(), json.at("profileName"));
   } else if (name == "sortPlugins") {
     return std::make_unique<SortPluginsQuery<>>(
         lootState_.GetCurrentGame(),
         lootState_,
         lootState_.getLanguage(),
         [frame](std::string message) { sendProgressUpdate(frame, message); });
+  } else if (name == "updateAllMasterlists") {
+    return std::make_unique<UpdateAllMasterlistsQuery>(lootState_);
   } else if (name == "updateMasterlist") {
-    return std::make_unique<UpdateMasterlistQuery<>>(lootState_.GetCurrentGame(),
-                                                   lootState_.getLanguage());
+    return std::make_unique<UpdateMasterlistQuery<>>(
+        lootState_.GetCurrentGame(),
+        lootState_.getLanguage(),
+        json.value("fetch", true));
   } else if (name == "getAutoSort") {
     return std::make_unique<GetAutoSortQuery>(lootState_);
   }
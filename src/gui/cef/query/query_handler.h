@@ -26,7 +26,10 @@
 #ifndef LOOT_GUI_QUERY_HANDLER
 #define LOOT_GUI_QUERY_HANDLER
 
+#include <functional>
+
 #include <include/wrapper/cef_message_router.h>
+#include <json.hpp>
 
 #include "gui/cef/query/query.h"
 #include "gui/state/loot_state.h"
@@ -46,8 +49,13 @@ public:
 
 private:
   std::unique_ptr<Query> createQuery(CefRefPtr<CefBrowser> browser,
-                               CefRefPtr<CefFrame> frame,
-                               const std::string& request);
+                                     CefRefPtr<CefFrame> frame,
+                                     const std::string& name,
+                                     const nlohmann::json& json);
+  // Returns nullptr if the masterlist shouldn't be updated in the background.
+  std::function<void(std::string)> getMasterlistUpdateSender(
+      CefRefPtr<CefFrame> frame) const;
+  void cancelBackgroundSort();
 
   LootState& lootState_;
 };
@@ -0,0 +1,58 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QUERY_APPLY_LOAD_ORDER_PROFILE_QUERY
+#define LOOT_GUI_QUERY_APPLY_LOAD_ORDER_PROFILE_QUERY
+
+#include <json.hpp>
+
+#include "gui/cef/query/query.h"
+#include "gui/state/game/game.h"
+
+namespace loot {
+// Applies a saved load order without sorting. Installed plugins that aren't in
+// the profile keep their place relative to the profiled plugins.
+template<typename G = gui::Game>
+class ApplyLoadOrderProfileQuery : public Query {
+public:
+  ApplyLoadOrderProfileQuery(G& game, std::string profileName) :
+      game_(game),
+      profileName_(profileName) {}
+
+  std::string executeLogic() {
+    nlohmann::json json = {
+        {"loadOrder", game_.ApplyLoadOrderProfile(profileName_)},
+    };
+
+    return json.dump();
+  }
+
+private:
+  G& game_;
+  const std::string profileName_;
+};
+}
+
+#endif
@@ -35,16 +35,30 @@ public:
   ChangeGameQuery(GamesManager& gamesManager,
                   std::string language,
                   std::string gameFolder,
-                  std::function<void(std::string)> sendProgressUpdate) :
+                  std::function<void(std::string)> sendProgressUpdate,
+                  std::function<void(std::string)> sendMasterlistUpdate =
+                      nullptr) :
       gamesManager_(gamesManager),
       gameFolder_(gameFolder),
       language_(language),
-      sendProgressUpdate_(sendProgressUpdate) {}
+      sendProgressUpdate_(sendProgressUpdate),
+      sendMasterlistUpdate_(sendMasterlistUpdate) {}
 
   std::string executeLogic() {
     gamesManager_.SetCurrentGame(gameFolder_);
+    auto& game = gamesManager_.GetCurrentGame();
 
-    GetGameDataQuery<G> subQuery(gamesManager_.GetCurrentGame(), language_, sendProgressUpdate_);
+    // A game that was still initialised from when it was last used already
+    // has its plugins and metadata loaded, so they only need to be loaded
+    // again if they were changed while another game was current.
+    auto reloadPlugins =
+        !game.GetPlugins().empty() && game.RefreshLoadOrderState();
+
+    GetGameDataQuery<G> subQuery(game,
+                                 language_,
+                                 sendProgressUpdate_,
+                                 reloadPlugins,
+                                 sendMasterlistUpdate_);
 
     return subQuery.executeLogic();
   }
@@ -54,6 +68,7 @@ private:
   const std::string gameFolder_;
   const std::string language_;
   const std::function<void(std::string)> sendProgressUpdate_;
+  const std::function<void(std::string)> sendMasterlistUpdate_;
 };
 }
 
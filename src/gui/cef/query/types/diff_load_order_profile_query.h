@@ -0,0 +1,64 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QUERY_DIFF_LOAD_ORDER_PROFILE_QUERY
+#define LOOT_GUI_QUERY_DIFF_LOAD_ORDER_PROFILE_QUERY
+
+#include <json.hpp>
+
+#include "gui/cef/query/query.h"
+#include "gui/state/game/game.h"
+
+namespace loot {
+template<typename G = gui::Game>
+class DiffLoadOrderProfileQuery : public Query {
+public:
+  DiffLoadOrderProfileQuery(G& game,
+                            std::string profileName,
+                            std::optional<std::string> baseProfileName) :
+      game_(game),
+      profileName_(profileName),
+      baseProfileName_(baseProfileName) {}
+
+  std::string executeLogic() {
+    auto diff = game_.DiffLoadOrderProfile(profileName_, baseProfileName_);
+
+    nlohmann::json json = {
+        {"added", diff.added},
+        {"removed", diff.removed},
+        {"moved", diff.moved},
+    };
+
+    return json.dump();
+  }
+
+private:
+  G& game_;
+  const std::string profileName_;
+  const std::optional<std::string> baseProfileName_;
+};
+}
+
+#endif
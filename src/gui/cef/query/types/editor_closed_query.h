@@ -26,6 +26,10 @@ along with LOOT.  If not, see
 #ifndef LOOT_GUI_QUERY_EDITOR_CLOSED_QUERY
 #define LOOT_GUI_QUERY_EDITOR_CLOSED_QUERY
 
+#include <set>
+
+#include <boost/algorithm/string.hpp>
+
 #include "gui/cef/query/json.h"
 #include "gui/cef/query/types/metadata_query.h"
 #include "gui/state/game/game.h"
@@ -51,12 +55,31 @@ public:
   }
 
   std::string executeLogic() {
+    std::set<std::string> affectedPlugins;
     if (applyEdits_) {
-      applyUserEdits();
+      affectedPlugins = applyUserEdits();
     }
     counter_.DecrementUnappliedChangeCounter();
 
-    return this->generateJsonResponse(metadata_.GetName());
+    // The edited plugin always comes first.
+    nlohmann::json json = {{"plugins", nlohmann::json::array()}};
+    auto derivedMetadata = this->generateDerivedMetadata(metadata_.GetName());
+    if (derivedMetadata.has_value()) {
+      json["plugins"].push_back(derivedMetadata.value());
+    }
+
+    for (const auto& pluginName : affectedPlugins) {
+      if (boost::iequals(pluginName, metadata_.GetName())) {
+        continue;
+      }
+
+      derivedMetadata = this->generateDerivedMetadata(pluginName);
+      if (derivedMetadata.has_value()) {
+        json["plugins"].push_back(derivedMetadata.value());
+      }
+    }
+
+    return json.dump();
   }
 
 private:
@@ -97,7 +120,9 @@ private:
     return userMetadata;
   }
 
-  void applyUserEdits() {
+  // Returns the names of other plugins whose messages may be affected by the
+  // edits.
+  std::set<std::string> applyUserEdits() {
     auto logger = getLogger();
     if (logger) {
       logger->trace("Applying user edits for: {}", metadata_.GetName());
@@ -122,6 +147,18 @@ private:
 
     // Save edited userlist.
     this->getGame().SaveUserMetadata();
+
+    // The cards of plugins whose metadata refers to the edited plugin may
+    // display information about it.
+    auto affectedPlugins =
+        this->getGame().GetDependentPlugins(metadata_.GetName());
+
+    // Report any cycle the edits have caused now, rather than when sorting.
+    auto cyclePlugins =
+        this->getGame().CheckForCyclicInteractions(metadata_.GetName());
+    affectedPlugins.insert(cyclePlugins.begin(), cyclePlugins.end());
+
+    return affectedPlugins;
   }
 
   UnappliedChangeCounter& counter_;
@@ -27,20 +27,29 @@ along with LOOT.  If not, see
 #define LOOT_GUI_QUERY_EDITOR_OPENED_QUERY
 
 #include "gui/cef/query/query.h"
+#include "gui/state/game/game.h"
 #include "gui/state/unapplied_change_counter.h"
 
 namespace loot {
+template<typename G = gui::Game>
 class EditorOpenedQuery : public Query {
 public:
-  EditorOpenedQuery(UnappliedChangeCounter& unappliedChangeCounter) :
+  EditorOpenedQuery(G& game, UnappliedChangeCounter& unappliedChangeCounter) :
+      game_(game),
       unappliedChangeCounter_(unappliedChangeCounter) {}
 
   std::string executeLogic() {
     unappliedChangeCounter_.IncrementUnappliedChangeCounter();
+
+    // Prepare for checking the edits while the user makes them, rather than
+    // delaying the response when the editor is closed.
+    game_.BuildInteractionGraph();
+
     return "";
   }
 
 private:
+  G& game_;
   UnappliedChangeCounter& unappliedChangeCounter_;
 };
 }
@@ -36,9 +36,11 @@ class GetConflictingPluginsQuery : public MetadataQuery<G> {
 public:
   GetConflictingPluginsQuery(G& game,
                              std::string language,
-                             std::string pluginName) :
+                             std::string pluginName,
+                             bool namesOnly = false) :
       MetadataQuery<G>(game, language),
-      pluginName_(pluginName) {}
+      pluginName_(pluginName),
+      namesOnly_(namesOnly) {}
 
   std::string executeLogic() {
     auto logger = getLogger();
@@ -50,46 +52,83 @@ public:
     // Checking for FormID overlap will only work if the plugins have been
     // loaded, so check if the plugins have been fully loaded, and if not load
     // all plugins.
-    if (!this->getGame().ArePluginsFullyLoaded())
+    bool pluginsWereLoaded = false;
+    if (!this->getGame().ArePluginsFullyLoaded()) {
       this->getGame().LoadAllInstalledPlugins(false);
+      pluginsWereLoaded = true;
+    }
+
+    if (namesOnly_) {
+      return getNamesOnlyJsonResponse(pluginsWereLoaded);
+    }
 
     return getJsonResponse();
   }
 
 private:
-  std::string getJsonResponse() {
+  // The frontend already holds derived metadata for every plugin, and that
+  // metadata only changes here if the plugins had to be fully loaded (e.g. to
+  // get their CRCs), so only send it in that case.
+  std::string getNamesOnlyJsonResponse(bool includeMetadata) {
     nlohmann::json json = {
         {"generalMessages", this->getGeneralMessages()},
+        {"conflictingPlugins", nlohmann::json::array()},
         {"plugins", nlohmann::json::array()},
     };
 
-    auto plugin = this->getGame().GetPlugin(pluginName_);
-    if (!plugin) {
+    auto conflictIndex = this->getGame().GetConflictIndex();
+    auto snapshot = conflictIndex->GetSnapshot();
+    const auto& plugins = snapshot->GetPlugins();
+
+    auto pluginIndex = getPluginIndex(*snapshot);
+    for (auto i : conflictIndex->GetConflictingPlugins(pluginIndex)) {
+      json["conflictingPlugins"].push_back(plugins[i]->GetName());
+    }
+
+    if (includeMetadata) {
+      for (const auto& plugin : plugins) {
+        json["plugins"].push_back(this->generateDerivedMetadata(plugin));
+      }
+    }
+
+    return json.dump();
+  }
+
+  size_t getPluginIndex(const gui::PluginSnapshot& snapshot) const {
+    auto pluginIndex = snapshot.GetIndex(pluginName_);
+    if (!pluginIndex.has_value()) {
       throw std::runtime_error("The plugin \"" + pluginName_ +
                                "\" is not loaded.");
     }
 
-    for (const auto& otherPlugin : this->getGame().GetPlugins()) {
+    return pluginIndex.value();
+  }
+
+  std::string getJsonResponse() {
+    nlohmann::json json = {
+        {"generalMessages", this->getGeneralMessages()},
+        {"plugins", nlohmann::json::array()},
+    };
+
+    auto conflictIndex = this->getGame().GetConflictIndex();
+    auto snapshot = conflictIndex->GetSnapshot();
+
+    auto pluginIndex = getPluginIndex(*snapshot);
+
+    const auto& plugins = snapshot->GetPlugins();
+    for (size_t i = 0; i < plugins.size(); ++i) {
       json["plugins"].push_back({
-          {"metadata", this->generateDerivedMetadata(otherPlugin)},
-          {"conflicts", doPluginsConflict(plugin, otherPlugin)},
+          {"metadata", this->generateDerivedMetadata(plugins[i])},
+          {"conflicts",
+           conflictIndex->DoPluginsConflict(pluginIndex, i)},
       });
     }
 
     return json.dump();
   }
 
-  bool doPluginsConflict(
-      const std::shared_ptr<const PluginInterface>& plugin,
-      const std::shared_ptr<const PluginInterface>& otherPlugin) {
-    if (plugin->DoFormIDsOverlap(*otherPlugin)) {
-      return true;
-    } else {
-      return false;
-    }
-  }
-
   const std::string pluginName_;
+  const bool namesOnly_;
 };
 }
 
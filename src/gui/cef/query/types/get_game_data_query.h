@@ -38,9 +38,14 @@ class GetGameDataQuery : public MetadataQuery<G> {
 public:
   GetGameDataQuery(G& game,
                    std::string language,
-                   std::function<void(std::string)> sendProgressUpdate) :
+                   std::function<void(std::string)> sendProgressUpdate,
+                   bool reloadPlugins = true,
+                   std::function<void(std::string)> sendMasterlistUpdate =
+                       nullptr) :
       MetadataQuery<G>(game, language),
-      sendProgressUpdate_(sendProgressUpdate) {}
+      sendProgressUpdate_(sendProgressUpdate),
+      reloadPlugins_(reloadPlugins),
+      sendMasterlistUpdate_(sendMasterlistUpdate) {}
 
   std::string executeLogic() {
     sendProgressUpdate_(boost::locale::translate(
@@ -50,10 +55,29 @@ public:
        the game data, so also load the metadata lists. */
     bool isFirstLoad = this->getGame().GetPlugins().empty();
 
-    this->getGame().LoadAllInstalledPlugins(true);
+    // Read the masterlist snapshot before anything can update the masterlist.
+    std::optional<gui::MasterlistSnapshot> snapshot;
+    if (isFirstLoad) {
+      snapshot = this->getGame().GetMasterlistSnapshot();
+    }
+
+    // Parsing the metadata lists and updating the masterlist don't depend on
+    // the loaded plugins, so do them while the plugins are loaded. Only
+    // metadata reads need to wait for the parse.
+    if (isFirstLoad) {
+      this->getGame().LoadMetadataInBackground();
+
+      if (sendMasterlistUpdate_) {
+        this->getGame().UpdateMasterlistInBackground(
+            [sendMasterlistUpdate = sendMasterlistUpdate_,
+             folder = this->getGame().FolderName()]() {
+              sendMasterlistUpdate(folder);
+            });
+      }
+    }
 
-    if (isFirstLoad)
-      this->getGame().LoadMetadata();
+    if (isFirstLoad || reloadPlugins_)
+      this->getGame().LoadAllInstalledPlugins(true);
 
     // Sort plugins into their load order.
     std::vector<std::shared_ptr<const PluginInterface>> installed;
@@ -65,11 +89,37 @@ public:
       }
     }
 
-    return this->generateJsonResponse(installed.cbegin(), installed.cend());
+    // Respond using the masterlist snapshot if there is one, as the UI will
+    // ask for the full response once it's displayed the snapshot's.
+    if (snapshot.has_value()) {
+      auto response = this->generateJsonResponse(
+          installed.cbegin(), installed.cend(), snapshot.value());
+      cachePluginCrcs(isFirstLoad);
+
+      return response;
+    }
+
+    auto response =
+        this->generateJsonResponse(installed.cbegin(), installed.cend());
+
+    this->getGame().UpdateMasterlistSnapshot();
+    cachePluginCrcs(isFirstLoad);
+
+    return response;
   }
 
 private:
+  // Cards only show CRCs that are already known, so calculate any that are
+  // missing once the response is ready, for the next time plugins are loaded.
+  void cachePluginCrcs(bool isFirstLoad) {
+    if (isFirstLoad || reloadPlugins_) {
+      this->getGame().CachePluginCrcsInBackground();
+    }
+  }
+
   std::function<void(std::string)> sendProgressUpdate_;
+  const bool reloadPlugins_;
+  std::function<void(std::string)> sendMasterlistUpdate_;
 };
 }
 
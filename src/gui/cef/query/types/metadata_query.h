@@ -32,6 +32,7 @@ along with LOOT.  If not, see
 #include "gui/cef/query/derived_plugin_metadata.h"
 #include "gui/cef/query/query.h"
 #include "gui/state/game/helpers.h"
+#include "gui/state/tracing.h"
 #include "loot/exception/file_access_error.h"
 #include "loot/exception/git_state_error.h"
 
@@ -82,6 +83,9 @@ protected:
 
   DerivedPluginMetadata<G> generateDerivedMetadata(
       const std::shared_ptr<const PluginInterface>& plugin) {
+    // Don't copy the plugin's name unless it's going to be recorded.
+    TraceSpan span("Generate derived metadata",
+                   isTracingEnabled() ? plugin->GetName() : std::string());
     auto derived = DerivedPluginMetadata<G>(plugin, game_, language_);
 
     auto nonUserMetadata = getNonUserMetadata(plugin);
@@ -114,7 +118,9 @@ protected:
   std::string generateJsonResponse(const std::string& pluginName) {
     auto derivedMetadata = generateDerivedMetadata(pluginName);
     if (derivedMetadata.has_value()) {
-      return nlohmann::json(derivedMetadata.value()).dump();
+      nlohmann::json json = derivedMetadata.value();
+      TraceSpan span("Serialise JSON");
+      return json.dump();
     }
 
     return "";
@@ -140,6 +146,43 @@ protected:
       json["plugins"].push_back(generateDerivedMetadata(*it));
     }
 
+    TraceSpan span("Serialise JSON");
+    return json.dump();
+  }
+
+  // Generates a response from the masterlist snapshot, without waiting for
+  // libloot to load metadata. User metadata and install validity checks are
+  // left out.
+  template<typename InputIterator>
+  std::string generateJsonResponse(InputIterator firstPlugin,
+                                   InputIterator lastPlugin,
+                                   const gui::MasterlistSnapshot& snapshot) {
+    nlohmann::json json = {
+        {"folder", game_.FolderName()},
+        {"masterlist", getMasterlistInfo()},
+        {"generalMessages",
+         toSimpleMessages(game_.GetMessages(snapshot), language_)},
+        {"bashTags", snapshot.GetKnownBashTags()},
+        {"groups",
+         {
+             {"masterlist", snapshot.GetGroups()},
+             {"userlist", std::vector<Group>()},
+         }},
+        {"plugins", nlohmann::json::array()},
+        {"isFromSnapshot", true},
+    };
+
+    for (auto it = firstPlugin; it != lastPlugin; ++it) {
+      auto derived = DerivedPluginMetadata<G>(*it, game_, language_);
+
+      auto metadata = snapshot.GetPluginMetadata((*it)->GetName());
+      derived.setEvaluatedMetadata(
+          metadata.value_or(PluginMetadata((*it)->GetName())));
+
+      json["plugins"].push_back(derived);
+    }
+
+    TraceSpan span("Serialise JSON");
     return json.dump();
   }
 
@@ -190,13 +233,11 @@ private:
     try {
       return game_.GetMasterlistMetadata(pluginName, true);
     } catch (std::exception& e) {
-      if (logger_) {
-        logger_->error(
-            "\"{}\"'s masterlist metadata contains a condition that "
-            "could not be evaluated. Details: {}",
-            pluginName,
-            e.what());
-      }
+      LOOT_LOG_ERROR(logger_,
+                     "\"{}\"'s masterlist metadata contains a condition that "
+                     "could not be evaluated. Details: {}",
+                     pluginName,
+                     e.what());
 
       PluginMetadata master(pluginName);
       master.SetMessages({
@@ -217,13 +258,11 @@ private:
     try {
       return game_.GetUserMetadata(pluginName, true);
     } catch (std::exception& e) {
-      if (logger_) {
-        logger_->error(
-            "\"{}\"'s user metadata contains a condition that could "
-            "not be evaluated. Details: {}",
-            pluginName,
-            e.what());
-      }
+      LOOT_LOG_ERROR(logger_,
+                     "\"{}\"'s user metadata contains a condition that could "
+                     "not be evaluated. Details: {}",
+                     pluginName,
+                     e.what());
 
       PluginMetadata user(pluginName);
       user.SetMessages({
@@ -247,17 +286,15 @@ private:
       info = game_.GetMasterlistInfo();
       addSuffixIfModified(info);
     } catch (FileAccessError&) {
-      if (logger_) {
-        logger_->warn("No masterlist present at {}",
-                      game_.MasterlistPath().u8string());
-      }
+      LOOT_LOG_WARN(logger_,
+                    "No masterlist present at {}",
+                    game_.MasterlistPath().u8string());
       info.revision_id = translate("N/A: No masterlist present").str();
       info.revision_date = translate("N/A: No masterlist present").str();
     } catch (GitStateError&) {
-      if (logger_) {
-        logger_->warn("Not a Git repository: {}",
-                      game_.MasterlistPath().parent_path().u8string());
-      }
+      LOOT_LOG_WARN(logger_,
+                    "Not a Git repository: {}",
+                    game_.MasterlistPath().parent_path().u8string());
       info.revision_id = translate("Unknown: Git repository missing").str();
       info.revision_date = translate("Unknown: Git repository missing").str();
     }
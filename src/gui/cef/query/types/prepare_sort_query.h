@@ -0,0 +1,68 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QUERY_PREPARE_SORT_QUERY
+#define LOOT_GUI_QUERY_PREPARE_SORT_QUERY
+
+#include <functional>
+#include <string>
+
+#include "gui/cef/query/query.h"
+#include "gui/state/game/game.h"
+
+namespace loot {
+// Starts sorting the current game's plugins in the background, so that the
+// result is ready when the user asks for it. This isn't counted as a sort and
+// doesn't create any unapplied changes. Any other query cancels the sort, so
+// the frontend sends this after everything else that it does on load.
+template<typename G = gui::Game>
+class PrepareSortQuery : public Query {
+public:
+  PrepareSortQuery(G& game,
+                   std::function<void(std::string, bool)> sendSortPrepared) :
+      game_(game), sendSortPrepared_(sendSortPrepared) {}
+
+  std::string executeLogic() {
+    auto logger = getLogger();
+    if (logger) {
+      logger->info("Sorting plugins in the background.");
+    }
+
+    game_.SortPluginsInBackground(
+        [sendSortPrepared = sendSortPrepared_,
+         folder = game_.FolderName()](bool loadOrderIsSorted) {
+          sendSortPrepared(folder, loadOrderIsSorted);
+        });
+
+    return "";
+  }
+
+private:
+  G& game_;
+  const std::function<void(std::string, bool)> sendSortPrepared_;
+};
+}
+
+#endif
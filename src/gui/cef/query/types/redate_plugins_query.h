@@ -26,6 +26,11 @@ along with LOOT.  If not, see
 #ifndef LOOT_GUI_QUERY_REDATE_PLUGINS_QUERY
 #define LOOT_GUI_QUERY_REDATE_PLUGINS_QUERY
 
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <json.hpp>
+
 #include "gui/cef/query/query.h"
 #include "gui/state/game/game.h"
 
@@ -33,16 +38,40 @@ namespace loot {
 template<typename G = gui::Game>
 class RedatePluginsQuery : public Query {
 public:
-  RedatePluginsQuery(G& game) :
-      game_(game) {}
+  RedatePluginsQuery(G& game, bool dryRun) : game_(game), dryRun_(dryRun) {}
 
   std::string executeLogic() {
-    game_.RedatePlugins();
-    return "";
+    if (!dryRun_) {
+      game_.RedatePlugins();
+      return "";
+    }
+
+    auto redates = nlohmann::json::array();
+    for (const auto& redate : game_.PlanPluginRedates()) {
+      redates.push_back({
+          {"name", redate.pluginName},
+          {"currentTime", toUnixTime(redate.currentTime)},
+          {"newTime", toUnixTime(redate.newTime)},
+      });
+    }
+
+    nlohmann::json json = {{"plugins", redates}};
+    return json.dump();
   }
 
 private:
+  static int64_t toUnixTime(std::filesystem::file_time_type time) {
+    using std::chrono::system_clock;
+    auto systemTime = system_clock::now() +
+                      std::chrono::duration_cast<system_clock::duration>(
+                          time - std::filesystem::file_time_type::clock::now());
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               systemTime.time_since_epoch())
+        .count();
+  }
+
   G& game_;
+  const bool dryRun_;
 };
 }
 
@@ -0,0 +1,68 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QUERY_RESTORE_LOAD_ORDER_QUERY
+#define LOOT_GUI_QUERY_RESTORE_LOAD_ORDER_QUERY
+
+#include <boost/locale.hpp>
+#include <json.hpp>
+
+#include "gui/cef/query/query.h"
+#include "gui/state/game/game.h"
+
+namespace loot {
+// Restores a load order from the game's load order journal. An age of zero
+// restores the load order that was most recently replaced.
+template<typename G = gui::Game>
+class RestoreLoadOrderQuery : public Query {
+public:
+  RestoreLoadOrderQuery(G& game, size_t age) : game_(game), age_(age) {}
+
+  std::string executeLogic() {
+    if (age_ >= game_.CountRecordedLoadOrders()) {
+      errorMessage_ = boost::locale::translate(
+          "There is no recorded load order to restore.");
+      throw std::out_of_range("No load order has been recorded at that age");
+    }
+
+    nlohmann::json json = {
+        {"loadOrder", game_.RestoreLoadOrder(age_)},
+    };
+
+    return json.dump();
+  }
+
+  std::optional<std::string> getErrorMessage() override {
+    return errorMessage_;
+  }
+
+private:
+  G& game_;
+  const size_t age_;
+  std::optional<std::string> errorMessage_;
+};
+}
+
+#endif
@@ -28,6 +28,8 @@ along with LOOT.  If not, see
 
 #include "gui/cef/query/query.h"
 #include "gui/state/game/game.h"
+#include "loot/exception/cyclic_interaction_error.h"
+#include "loot/exception/undefined_group_error.h"
 
 namespace loot {
 template<typename G = gui::Game>
@@ -43,6 +45,8 @@ public:
       logger->trace("Setting user groups.");
     }
 
+    validateGroups();
+
     game_.SetUserGroups(groups_);
     game_.SaveUserMetadata();
 
@@ -53,9 +57,41 @@ public:
     return json.dump();
   }
 
+  std::optional<std::string> getErrorMessage() override { return errorMessage_; }
+
 private:
+  // Check the groups before saving them, so that a cycle between groups is
+  // reported immediately instead of causing sorting to fail. Cycles that also
+  // involve plugins are still only found by sorting.
+  void validateGroups() {
+    try {
+      game_.ValidateUserGroups(groups_);
+    } catch (CyclicInteractionError& e) {
+      std::string cycle;
+      for (const auto& vertex : e.GetCycle()) {
+        cycle += vertex.GetName() + " \u2192 ";
+      }
+      cycle += e.GetCycle().front().GetName();
+
+      errorMessage_ =
+          (boost::format(boost::locale::translate(
+               "Cyclic interaction detected between \"%1%\" and \"%2%\": %3%")) %
+           e.GetCycle().front().GetName() % e.GetCycle().back().GetName() %
+           cycle)
+              .str();
+      throw;
+    } catch (UndefinedGroupError& e) {
+      errorMessage_ = (boost::format(boost::locale::translate(
+                           "The group \"%1%\" does not exist.")) %
+                       e.GetGroupName())
+                          .str();
+      throw;
+    }
+  }
+
   G& game_;
   const std::vector<Group> groups_;
+  std::optional<std::string> errorMessage_;
 };
 }
 
@@ -113,6 +113,7 @@ private:
       json["plugins"].push_back(derivedMetadata);
     }
 
+    TraceSpan span("Serialise JSON");
     return json.dump();
   }
 
@@ -0,0 +1,74 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_QUERY_UPDATE_ALL_MASTERLISTS_QUERY
+#define LOOT_GUI_QUERY_UPDATE_ALL_MASTERLISTS_QUERY
+
+#include <json.hpp>
+
+#include "gui/cef/query/query.h"
+#include "gui/state/game/games_manager.h"
+
+namespace loot {
+class UpdateAllMasterlistsQuery : public Query {
+public:
+  UpdateAllMasterlistsQuery(GamesManager& gamesManager) :
+      gamesManager_(gamesManager) {}
+
+  std::string executeLogic() {
+    auto logger = getLogger();
+    if (logger) {
+      logger->info("Updating the masterlists for all installed games.");
+    }
+
+    nlohmann::json json = {{"games", nlohmann::json::array()}};
+    for (const auto& summary : gamesManager_.UpdateAllMasterlists()) {
+      nlohmann::json game = {
+          {"folder", summary.folderName},
+          {"wasChanged", summary.wasChanged},
+          {"isUsingFallback", summary.isUsingFallback},
+      };
+
+      if (summary.error.has_value()) {
+        game["error"] = summary.error.value();
+      } else {
+        game["masterlist"] = {
+            {"revision", summary.masterlist.revision_id},
+            {"date", summary.masterlist.revision_date},
+        };
+      }
+
+      json["games"].push_back(game);
+    }
+
+    return json.dump();
+  }
+
+private:
+  GamesManager& gamesManager_;
+};
+}
+
+#endif
@@ -26,15 +26,19 @@ along with LOOT.  If not, see
 #ifndef LOOT_GUI_QUERY_UPDATE_MASTERLIST_QUERY
 #define LOOT_GUI_QUERY_UPDATE_MASTERLIST_QUERY
 
+#include <algorithm>
+#include <map>
+
 #include "gui/cef/query/types/metadata_query.h"
 #include "gui/state/game/game.h"
+#include "gui/state/game/helpers.h"
 
 namespace loot {
 template<typename G = gui::Game>
 class UpdateMasterlistQuery : public MetadataQuery<G> {
 public:
-  UpdateMasterlistQuery(G& game, std::string language) :
-      MetadataQuery<G>(game, language) {}
+  UpdateMasterlistQuery(G& game, std::string language, bool fetch = true) :
+      MetadataQuery<G>(game, language), fetch_(fetch) {}
 
   std::string executeLogic() {
     auto logger = getLogger();
@@ -42,16 +46,61 @@ public:
       logger->debug("Updating and parsing masterlist.");
     }
 
+    auto plugins = this->getGame().GetPlugins();
+    auto groups = this->getGame().GetMasterlistGroups();
+    std::map<std::string, std::optional<PluginMetadata>> oldMetadata;
+    for (const auto& plugin : plugins) {
+      oldMetadata.emplace(plugin->GetName(),
+                          this->getGame().GetMasterlistMetadata(
+                              plugin->GetName()));
+    }
+
     if (!updateMasterlist())
       return "null";
 
-    auto plugins = this->getGame().GetPlugins();
-    return this->generateJsonResponse(plugins.cbegin(), plugins.cend());
+    // Only plugins with changed masterlist metadata need to be evaluated
+    // again, unless the groups have changed, as they're used to check every
+    // plugin's group.
+    if (this->getGame().GetMasterlistGroups() == groups) {
+      auto it = std::remove_if(
+          plugins.begin(),
+          plugins.end(),
+          [&](const std::shared_ptr<const PluginInterface>& plugin) {
+            return !hasChangedMetadata(plugin->GetName(),
+                                       oldMetadata.at(plugin->GetName()));
+          });
+      plugins.erase(it, plugins.end());
+    }
+
+    if (logger) {
+      logger->debug("Evaluating metadata for {} plugins after the update.",
+                    plugins.size());
+    }
+    auto response =
+        this->generateJsonResponse(plugins.cbegin(), plugins.cend());
+
+    this->getGame().UpdateMasterlistSnapshot();
+
+    return response;
   }
 
 private:
+  bool hasChangedMetadata(const std::string& pluginName,
+                          const std::optional<PluginMetadata>& oldMetadata) {
+    auto newMetadata = this->getGame().GetMasterlistMetadata(pluginName);
+    if (!oldMetadata.has_value() || !newMetadata.has_value()) {
+      return oldMetadata.has_value() != newMetadata.has_value();
+    }
+
+    return !HasSameMetadata(oldMetadata.value(), newMetadata.value());
+  }
+
   bool updateMasterlist() {
     try {
+      if (!fetch_) {
+        return this->getGame().LoadMasterlistUpdate();
+      }
+
       return this->getGame().UpdateMasterlist();
     } catch (std::exception&) {
       try {
@@ -61,6 +110,8 @@ private:
       throw;
     }
   }
+
+  const bool fetch_;
 };
 }
 
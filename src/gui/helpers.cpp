@@ -39,6 +39,8 @@
 #include <shlwapi.h>
 #include <windows.h>
 #else
+#include <fcntl.h>
+#include <unistd.h>
 #include <unicode/uchar.h>
 #include <unicode/unistr.h>
 using icu::UnicodeString;
@@ -63,6 +65,42 @@ void OpenInDefaultApplication(const std::filesystem::path& file) {
 #endif
 }
 
+void SyncFile(const std::filesystem::path& file) {
+#ifdef _WIN32
+  HANDLE handle = CreateFile(file.wstring().c_str(),
+                             GENERIC_WRITE,
+                             FILE_SHARE_READ | FILE_SHARE_WRITE,
+                             NULL,
+                             OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL,
+                             NULL);
+  if (handle == INVALID_HANDLE_VALUE)
+    throw std::system_error(
+        GetLastError(), std::system_category(), "Failed to open file to sync.");
+
+  auto synced = FlushFileBuffers(handle);
+  auto error = GetLastError();
+  CloseHandle(handle);
+
+  if (!synced)
+    throw std::system_error(
+        error, std::system_category(), "Failed to sync file to disk.");
+#else
+  int fd = open(file.c_str(), O_RDONLY);
+  if (fd == -1)
+    throw std::system_error(
+        errno, std::system_category(), "Failed to open file to sync.");
+
+  auto result = fsync(fd);
+  auto error = errno;
+  close(fd);
+
+  if (result != 0)
+    throw std::system_error(
+        error, std::system_category(), "Failed to sync file to disk.");
+#endif
+}
+
 #ifdef _WIN32
 std::wstring ToWinWide(const std::string& str) {
   size_t len = MultiByteToWideChar(CP_UTF8, 0, str.c_str(), str.length(), 0, 0);
@@ -158,4 +196,45 @@ int CompareFilenames(const std::string& lhs, const std::string& rhs) {
   return unicodeLhs.caseCompare(unicodeRhs, U_FOLD_CASE_DEFAULT);
 #endif
 }
+
+std::string NormalizeFilename(const std::string& filename) {
+#ifdef _WIN32
+  // Use the invariant locale's uppercase mapping, as that's the closest
+  // equivalent to the case conversion CompareStringOrdinal performs.
+  auto wideFilename = ToWinWide(filename);
+  int length = LCMapStringEx(LOCALE_NAME_INVARIANT,
+                             LCMAP_UPPERCASE,
+                             wideFilename.c_str(),
+                             wideFilename.length(),
+                             NULL,
+                             0,
+                             NULL,
+                             NULL,
+                             0);
+  if (length == 0 && !wideFilename.empty()) {
+    throw std::system_error(GetLastError(),
+                            std::system_category(),
+                            "Failed to normalise filename.");
+  }
+
+  std::wstring normalizedFilename(length, 0);
+  LCMapStringEx(LOCALE_NAME_INVARIANT,
+                LCMAP_UPPERCASE,
+                wideFilename.c_str(),
+                wideFilename.length(),
+                &normalizedFilename[0],
+                length,
+                NULL,
+                NULL,
+                0);
+
+  return FromWinWide(normalizedFilename);
+#else
+  std::string normalizedFilename;
+  UnicodeString::fromUTF8(filename)
+      .foldCase(U_FOLD_CASE_DEFAULT)
+      .toUTF8String(normalizedFilename);
+  return normalizedFilename;
+#endif
+}
 }
@@ -30,6 +30,11 @@
 namespace loot {
 void OpenInDefaultApplication(const std::filesystem::path& file);
 
+// Blocks until the file's contents have been written to disk, so that a
+// following rename can't leave an empty or partially-written file in place if
+// the system crashes.
+void SyncFile(const std::filesystem::path& file);
+
 #ifdef _WIN32
 std::wstring ToWinWide(const std::string& str);
 
@@ -45,5 +50,9 @@ std::string RegKeyStringValue(const std::string& rootKey,
 // lhs > rhs. The comparison may give different results on Linux, but is still
 // locale-invariant.
 int CompareFilenames(const std::string& lhs, const std::string& rhs);
+
+// Normalise a filename so that two filenames that CompareFilenames() treats as
+// equal produce the same output, making it usable as a hash key.
+std::string NormalizeFilename(const std::string& filename);
 }
 #endif
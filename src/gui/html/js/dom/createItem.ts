@@ -49,3 +49,11 @@ export function createGroupItem(group: Group): HTMLElement {
 
   return item;
 }
+
+export function createLoadOrderProfileItem(profileName: string): HTMLElement {
+  const item = document.createElement('paper-item');
+  item.setAttribute('value', profileName);
+  item.textContent = profileName;
+
+  return item;
+}
@@ -22,6 +22,7 @@ import {
   createGameTypeItem,
   createGroupItem,
   createLanguageItem,
+  createLoadOrderProfileItem,
   createMessageItem,
   createThemeItem
 } from './createItem';
@@ -263,6 +264,29 @@ export function fillGroupsList(groups: Group[]): void {
   }
 }
 
+export function fillLoadOrderProfilesList(
+  profileNames: string[],
+  selectedProfileName?: string
+): void {
+  const profileSelect = getElementById(
+    'loadOrderProfileSelect'
+  ) as LootDropdownMenu;
+
+  while (profileSelect.firstElementChild) {
+    profileSelect.removeChild(profileSelect.firstElementChild);
+  }
+
+  profileNames.forEach(profileName => {
+    profileSelect.appendChild(createLoadOrderProfileItem(profileName));
+  });
+
+  if (selectedProfileName !== undefined) {
+    profileSelect.value = selectedProfileName;
+  } else {
+    profileSelect.value = profileNames.length > 0 ? profileNames[0] : '';
+  }
+}
+
 export function initialiseGroupsEditor(
   getter: (groupName: string) => string[]
 ): void {
@@ -434,6 +458,14 @@ export function enableGameOperations(shouldEnable: boolean): void {
     'copyLoadOrderButton'
   ) as PaperIconItemElement).disabled = !shouldEnable;
 
+  (getElementById(
+    'restoreLoadOrderButton'
+  ) as PaperIconItemElement).disabled = !shouldEnable;
+
+  (getElementById(
+    'loadOrderProfilesButton'
+  ) as PaperIconItemElement).disabled = !shouldEnable;
+
   (getElementById(
     'refreshContentButton'
   ) as PaperIconItemElement).disabled = !shouldEnable;
@@ -2,15 +2,19 @@ import * as marked from 'marked';
 
 import { IronListElement } from '@polymer/iron-list';
 import { PaperCheckboxElement } from '@polymer/paper-checkbox';
+import { PaperInputElement } from '@polymer/paper-input/paper-input';
 import {
   askQuestion,
   closeProgress,
+  showMessage,
   showNotification,
   showProgress
 } from './dialog';
 import {
   fillGroupsList,
+  fillLoadOrderProfilesList,
   initialiseAutocompleteBashTags,
+  openDialog,
   updateSettingsDialog,
   enableGameOperations,
   setGameMenuItems,
@@ -23,10 +27,12 @@ import { Plugin } from './plugin';
 import {
   changeGame,
   updateMasterlist as updateMasterlistQuery,
+  updateAllMasterlists,
   sortPlugins,
   cancelSort,
   clearAllMetadata,
   getGameData,
+  getReconciledGameData,
   closeSettings,
   saveUserGroups,
   editorClosed,
@@ -36,16 +42,25 @@ import {
   discardUnappliedChanges,
   applySort,
   redatePlugins,
+  planPluginRedates,
   copyContent,
   copyLoadOrder,
   openReadme,
   openLogLocation,
   editorOpened,
-  copyMetadata
+  copyMetadata,
+  prepareSort,
+  restoreLoadOrder,
+  getLoadOrderProfiles,
+  saveLoadOrderProfile,
+  applyLoadOrderProfile,
+  deleteLoadOrderProfile,
+  diffLoadOrderProfile
 } from './query';
 import {
   FilterStates,
   GameContent,
+  GameData,
   GameSettings,
   LootSettings
 } from './interfaces';
@@ -168,6 +183,38 @@ function isGameFolderChangeEvent(evt: Event): evt is LootGameFolderChangeEvent {
   return evt instanceof CustomEvent && typeof evt.detail.folder === 'string';
 }
 
+/* Show whether the current load order is known to already be sorted. Passing
+false shows nothing, as the load order may or may not be sorted. */
+function showLoadOrderIsSorted(isSorted: boolean): void {
+  const tooltip = querySelector(
+    getElementById('mainToolbar'),
+    'paper-tooltip[for=sortButton]'
+  );
+  tooltip.textContent = isSorted
+    ? window.loot.l10n.translate('Sort Plugins (load order is already sorted)')
+    : window.loot.l10n.translate('Sort Plugins');
+}
+
+/* Sort on another thread so that the result is ready when the user sorts.
+   Any other query cancels the sort, so send this after everything else that
+   is done when a game is loaded. */
+export function prepareSortInBackground(): void {
+  prepareSort().catch(handlePromiseError);
+}
+
+export function onSortPrepared(
+  gameFolder: string,
+  loadOrderIsSorted: boolean
+): void {
+  if (
+    window.loot.game !== undefined &&
+    window.loot.game.folder === gameFolder &&
+    window.loot.state.isInDefaultState()
+  ) {
+    showLoadOrderIsSorted(loadOrderIsSorted);
+  }
+}
+
 export function onSidebarFilterToggle(evt: Event): void {
   if (!isPaperCheckboxChangeEvent(evt)) {
     throw new TypeError(`Expected a PaperCheckboxChangeEvent, got ${evt}`);
@@ -215,19 +262,21 @@ export function onConflictsFilter(evt: Event): void {
       .activateConflictsFilter(evt.currentTarget.value)
       .then(response => {
         currentGame.generalMessages = response.generalMessages;
-        currentGame.plugins = currentGame.plugins.reduce(
-          (plugins: Plugin[], plugin) => {
-            const responsePlugin = response.plugins.find(
-              item => item.name === plugin.name
-            );
-            if (responsePlugin) {
-              plugin.update(responsePlugin);
-              plugins.push(plugin);
-            }
-            return plugins;
-          },
-          []
-        );
+        if (response.plugins.length > 0) {
+          currentGame.plugins = currentGame.plugins.reduce(
+            (plugins: Plugin[], plugin) => {
+              const responsePlugin = response.plugins.find(
+                item => item.name === plugin.name
+              );
+              if (responsePlugin) {
+                plugin.update(responsePlugin);
+                plugins.push(plugin);
+              }
+              return plugins;
+            },
+            []
+          );
+        }
 
         window.loot.filters.apply(currentGame.plugins);
 
@@ -289,12 +338,57 @@ export function onChangeGame(evt: Event): void {
       window.loot.game.initialiseUI(window.loot.filters);
 
       closeProgress();
+
+      if (result.isFromSnapshot) {
+        return reconcileGameData(window.loot.game);
+      }
+
+      return undefined;
+    })
+    .then(() => {
+      loadBackgroundMasterlistUpdate();
+      prepareSortInBackground();
     })
     .catch(handlePromiseError);
 }
 
-/* Masterlist update process, minus progress dialog. */
-function updateMasterlist(): Promise<void> {
+function updateGameData(game: Game, data: GameData): void {
+  /* Update JS variables. */
+  game.masterlist = data.masterlist;
+  game.generalMessages = data.generalMessages;
+  game.setGroups(data.groups);
+
+  /* Update Bash Tag autocomplete suggestions. */
+  initialiseAutocompleteBashTags(data.bashTags);
+
+  data.plugins.forEach(dataPlugin => {
+    const existingPlugin = game.plugins.find(
+      plugin => plugin.name === dataPlugin.name
+    );
+    if (existingPlugin) {
+      existingPlugin.update(dataPlugin);
+    }
+  });
+}
+
+/* Replaces game data that was displayed from the masterlist snapshot with the
+   full data once the metadata lists have been loaded. */
+export async function reconcileGameData(game: Game): Promise<void> {
+  enableGameOperations(false);
+  try {
+    updateGameData(game, await getReconciledGameData());
+  } finally {
+    enableGameOperations(true);
+  }
+}
+
+/* The folder of the game whose masterlist was updated in the background, if
+   the update hasn't been loaded yet. */
+let backgroundMasterlistUpdateFolder: string | undefined;
+
+/* Masterlist update process, minus progress dialog. If fetch is false, an
+   update that has already been fetched is loaded. */
+function updateMasterlist(fetch = true): Promise<void> {
   const currentGame = window.loot.game;
   if (currentGame === undefined) {
     // There's nothing to do if no game has been loaded.
@@ -302,28 +396,19 @@ function updateMasterlist(): Promise<void> {
     throw new Error('Attempted to update masterlist with no game loaded.');
   }
 
+  if (backgroundMasterlistUpdateFolder === currentGame.folder) {
+    backgroundMasterlistUpdateFolder = undefined;
+  }
+
   showProgress(
     window.loot.l10n.translate('Updating and parsing masterlist...')
   );
-  return updateMasterlistQuery()
+  return updateMasterlistQuery(fetch)
     .then(result => {
       if (result) {
-        /* Update JS variables. */
-        currentGame.masterlist = result.masterlist;
-        currentGame.generalMessages = result.generalMessages;
-        currentGame.setGroups(result.groups);
+        showLoadOrderIsSorted(false);
 
-        /* Update Bash Tag autocomplete suggestions. */
-        initialiseAutocompleteBashTags(result.bashTags);
-
-        result.plugins.forEach(resultPlugin => {
-          const existingPlugin = currentGame.plugins.find(
-            plugin => plugin.name === resultPlugin.name
-          );
-          if (existingPlugin) {
-            existingPlugin.update(resultPlugin);
-          }
-        });
+        updateGameData(currentGame, result);
 
         showNotification(
           window.loot.l10n.translateFormatted(
@@ -347,6 +432,65 @@ export function onUpdateMasterlist(): void {
     .catch(handlePromiseError);
 }
 
+/* Loads a masterlist update that was fetched in the background, if it's for
+   the current game and nothing else is going on. */
+export function loadBackgroundMasterlistUpdate(): void {
+  if (
+    window.loot.game !== undefined &&
+    window.loot.game.folder === backgroundMasterlistUpdateFolder &&
+    window.loot.state.isInDefaultState()
+  ) {
+    updateMasterlist(false)
+      .then(() => {
+        closeProgress();
+      })
+      .catch(handlePromiseError);
+  }
+}
+
+export function onUpdateAllMasterlists(): void {
+  showProgress(window.loot.l10n.translate('Updating all masterlists...'));
+  updateAllMasterlists()
+    .then(summaries => {
+      const failedCount = summaries.filter(summary => summary.error).length;
+      const changedCount = summaries.filter(summary => summary.wasChanged)
+        .length;
+      const fallbackCount = summaries.filter(
+        summary => summary.isUsingFallback
+      ).length;
+
+      showNotification(
+        window.loot.l10n.translateFormatted(
+          'Masterlists updated: %s changed, %s using an older revision due to a syntax error, %s failed.',
+          changedCount.toString(),
+          fallbackCount.toString(),
+          failedCount.toString()
+        )
+      );
+
+      /* Load the current game's update, which has already been fetched. */
+      const currentGame = window.loot.game;
+      const currentSummary = summaries.find(
+        summary =>
+          currentGame !== undefined && summary.folder === currentGame.folder
+      );
+      if (currentSummary && currentSummary.wasChanged) {
+        return updateMasterlist(false);
+      }
+
+      return undefined;
+    })
+    .then(() => {
+      closeProgress();
+    })
+    .catch(handlePromiseError);
+}
+
+export function onMasterlistUpdate(gameFolder: string): void {
+  backgroundMasterlistUpdateFolder = gameFolder;
+  loadBackgroundMasterlistUpdate();
+}
+
 export function onSortPlugins(): Promise<void> {
   const currentGame = window.loot.game;
   if (currentGame === undefined) {
@@ -358,11 +502,13 @@ export function onSortPlugins(): Promise<void> {
     window.loot.filters.apply(currentGame.plugins);
   }
 
+  showLoadOrderIsSorted(false);
+
   let promise = Promise.resolve();
   // window.loot.settings being undefined is an unexpected failure state, no
   // point updating the masterlist in it.
   if (window.loot.settings && window.loot.settings.updateMasterlist) {
-    promise = promise.then(updateMasterlist);
+    promise = promise.then(() => updateMasterlist());
   }
   return promise
     .then(sortPlugins)
@@ -408,6 +554,7 @@ export function onSortPlugins(): Promise<void> {
         /* Send discardUnappliedChanges query. Not doing so prevents LOOT's window
          from closing. */
         discardUnappliedChanges();
+        showLoadOrderIsSorted(true);
         closeProgress();
         showNotification(
           window.loot.l10n.translate(
@@ -438,6 +585,7 @@ export function onApplySort(): Promise<void> {
   return applySort(pluginNames)
     .then(() => {
       currentGame.applySort();
+      showLoadOrderIsSorted(true);
 
       window.loot.state.exitSortingState();
     })
@@ -462,24 +610,40 @@ export function onCancelSort(): Promise<void> {
 }
 
 export function onRedatePlugins(/* evt */): void {
-  askQuestion(
-    window.loot.l10n.translate('Redate Plugins?'),
-    window.loot.l10n.translate(
-      'This feature is provided so that modders using the Creation Kit may set the load order it uses. A side-effect is that any subscribed Steam Workshop mods will be re-downloaded by Steam (this does not affect Skyrim Special Edition). Do you wish to continue?'
-    ),
-    window.loot.l10n.translate('Redate'),
-    result => {
-      if (result) {
-        redatePlugins()
-          .then(() => {
-            showNotification(
-              window.loot.l10n.translate('Plugins were successfully redated.')
-            );
-          })
-          .catch(handlePromiseError);
+  planPluginRedates()
+    .then(redates => {
+      if (redates.length === 0) {
+        showNotification(
+          window.loot.l10n.translate('No plugins need to be redated.')
+        );
+        return;
       }
-    }
-  );
+
+      askQuestion(
+        window.loot.l10n.translate('Redate Plugins?'),
+        `${window.loot.l10n.translateFormatted(
+          '%s plugins will be redated.',
+          redates.length.toString()
+        )} ${window.loot.l10n.translate(
+          'This feature is provided so that modders using the Creation Kit may set the load order it uses. A side-effect is that any subscribed Steam Workshop mods will be re-downloaded by Steam (this does not affect Skyrim Special Edition). Do you wish to continue?'
+        )}`,
+        window.loot.l10n.translate('Redate'),
+        result => {
+          if (result) {
+            redatePlugins()
+              .then(() => {
+                showNotification(
+                  window.loot.l10n.translate(
+                    'Plugins were successfully redated.'
+                  )
+                );
+              })
+              .catch(handlePromiseError);
+          }
+        }
+      );
+    })
+    .catch(handlePromiseError);
 }
 
 export function onClearAllMetadata(): void {
@@ -490,6 +654,8 @@ export function onClearAllMetadata(): void {
     );
   }
 
+  showLoadOrderIsSorted(false);
+
   askQuestion(
     '',
     window.loot.l10n.translate(
@@ -576,6 +742,123 @@ export function onContentRefresh(): void {
       window.loot.game.initialiseUI(window.loot.filters);
 
       closeProgress();
+
+      return prepareSortInBackground();
+    })
+    .catch(handlePromiseError);
+}
+
+export function onRestoreLoadOrder(): void {
+  restoreLoadOrder()
+    .then(() => {
+      showNotification(
+        window.loot.l10n.translate('The previous load order has been restored.')
+      );
+
+      onContentRefresh();
+    })
+    .catch(handlePromiseError);
+}
+
+function getSelectedLoadOrderProfile(): string {
+  return (getElementById('loadOrderProfileSelect') as LootDropdownMenu).value;
+}
+
+export function onSelectLoadOrderProfile(): void {
+  const diffElement = getElementById('loadOrderProfileDiff');
+  const profileName = getSelectedLoadOrderProfile();
+  if (!profileName) {
+    diffElement.textContent = '';
+    return;
+  }
+
+  diffLoadOrderProfile(profileName)
+    .then(diff => {
+      diffElement.textContent = window.loot.l10n.translateFormatted(
+        'Applying this profile will move %s plugins. %s of its plugins are not installed, and %s installed plugins are not in it.',
+        diff.moved.length.toString(),
+        diff.added.length.toString(),
+        diff.removed.length.toString()
+      );
+    })
+    .catch(handlePromiseError);
+}
+
+function fillLoadOrderProfiles(selectedProfileName?: string): Promise<void> {
+  return getLoadOrderProfiles().then(profileNames => {
+    fillLoadOrderProfilesList(profileNames, selectedProfileName);
+    /* The selected profile may not have changed, but the load order may
+       have, so always update the diff. */
+    onSelectLoadOrderProfile();
+  });
+}
+
+export function onShowLoadOrderProfilesDialog(): void {
+  fillLoadOrderProfiles()
+    .then(() => {
+      openDialog('loadOrderProfilesDialog');
+    })
+    .catch(handlePromiseError);
+}
+
+export function onSaveLoadOrderProfile(): void {
+  const nameInput = getElementById('loadOrderProfileName') as PaperInputElement;
+  const profileName = (nameInput.value || '').trim();
+  if (!profileName) {
+    return;
+  }
+
+  saveLoadOrderProfile(profileName)
+    .then(() => fillLoadOrderProfiles(profileName))
+    .then(() => {
+      nameInput.value = '';
+      showNotification(
+        window.loot.l10n.translateFormatted(
+          'The current load order has been saved as "%s".',
+          profileName
+        )
+      );
+    })
+    .catch(handlePromiseError);
+}
+
+export function onDeleteLoadOrderProfile(): void {
+  const profileName = getSelectedLoadOrderProfile();
+  if (!profileName) {
+    return;
+  }
+
+  deleteLoadOrderProfile(profileName)
+    .then(() => fillLoadOrderProfiles())
+    .catch(handlePromiseError);
+}
+
+export function onCloseLoadOrderProfilesDialog(evt: Event): void {
+  if (!isIronOverlayClosedEvent(evt)) {
+    throw new TypeError(`Expected a IronOverlayClosedEvent, got ${evt}`);
+  }
+
+  if (evt.target.id !== 'loadOrderProfilesDialog') {
+    /* The event can be fired by the dropdown in the dialog, so ignore any
+       events that don't come from the dialog itself. */
+    return;
+  }
+
+  const profileName = getSelectedLoadOrderProfile();
+  if (!evt.detail.confirmed || !profileName) {
+    return;
+  }
+
+  applyLoadOrderProfile(profileName)
+    .then(() => {
+      showNotification(
+        window.loot.l10n.translateFormatted(
+          'The load order profile "%s" has been applied.',
+          profileName
+        )
+      );
+
+      onContentRefresh();
     })
     .catch(handlePromiseError);
 }
@@ -627,6 +910,10 @@ export function onQuit(): void {
   }
 }
 
+export function onWriteError(message: string): void {
+  showMessage(window.loot.l10n.translate('Error'), message);
+}
+
 export function onApplySettings(evt: Event): void {
   if (!(getElementById('gameTable') as EditableTable).validate()) {
     evt.stopPropagation();
@@ -729,6 +1016,8 @@ export function onSaveUserGroups(evt: Event): void {
     return;
   }
 
+  showLoadOrderIsSorted(false);
+
   /* Send the settings back to the C++ side. */
   const userGroups = editor.getUserGroups();
   saveUserGroups(userGroups)
@@ -779,10 +1068,11 @@ export function onEditorClose(evt: Event): void {
     throw new Error('Attempted to save metadata edits with no game loaded.');
   }
 
+  showLoadOrderIsSorted(false);
+
+  const { plugins } = window.loot.game;
   const pluginName = querySelector(evt.target, 'h1').textContent;
-  const plugin = window.loot.game.plugins.find(
-    item => item.name === pluginName
-  );
+  const plugin = plugins.find(item => item.name === pluginName);
   if (plugin === undefined) {
     throw new Error(`Cannot find plugin with name "${pluginName}"`);
   }
@@ -798,8 +1088,15 @@ export function onEditorClose(evt: Event): void {
   };
 
   editorClosed(editorState)
-    .then(result => {
-      plugin.update(result);
+    .then(results => {
+      /* The edited plugin is first, followed by any other plugins whose
+       messages have been affected by the edits. */
+      results.forEach(result => {
+        const affectedPlugin = plugins.find(item => item.name === result.name);
+        if (affectedPlugin !== undefined) {
+          affectedPlugin.update(result);
+        }
+      });
 
       /* Now perform search again. If there is no current search, this won't
        do anything. */
@@ -852,6 +1149,8 @@ export function onClearMetadata(evt: Event): void {
     throw new Error('Attempted to clear user metadata with no game loaded.');
   }
 
+  showLoadOrderIsSorted(false);
+
   askQuestion(
     '',
     window.loot.l10n.translateFormatted(
@@ -1,7 +1,7 @@
 import { PaperCheckboxElement } from '@polymer/paper-checkbox';
 import { IronListElement } from '@polymer/iron-list';
 import handlePromiseError from './handlePromiseError';
-import { getConflictingPlugins } from './query';
+import { getConflictingPluginNames } from './query';
 import Translator from './translator';
 import { Plugin } from './plugin';
 import { SimpleMessage, FilterStates, MainContent } from './interfaces';
@@ -125,18 +125,19 @@ export default class Filters implements FilterStates {
     conflicts. */
     this.conflictingPluginNames = [targetPluginName];
 
-    return getConflictingPlugins(targetPluginName)
+    return getConflictingPluginNames(targetPluginName)
       .then(response => {
-        const plugins = response.plugins.map(plugin => {
-          if (plugin.conflicts) {
-            this.conflictingPluginNames.push(plugin.metadata.name);
-          }
-          return plugin.metadata;
-        });
-
+        this.conflictingPluginNames.push(
+          ...response.conflictingPlugins.filter(
+            name => name !== targetPluginName
+          )
+        );
+
+        /* Plugin metadata is only included if the plugins had to be loaded to
+        find their conflicts. */
         return {
           generalMessages: response.generalMessages,
-          plugins
+          plugins: response.plugins
         };
       })
       .catch(error => {
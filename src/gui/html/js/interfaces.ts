@@ -165,6 +165,7 @@ export interface GameData {
   groups: GameGroups;
   plugins: DerivedPluginMetadata[];
   bashTags: string[];
+  isFromSnapshot?: boolean;
 }
 
 export interface Masterlist {
@@ -36,10 +36,18 @@ import {
   onCopyContent,
   onCopyLoadOrder,
   onContentRefresh,
+  onRestoreLoadOrder,
+  onShowLoadOrderProfilesDialog,
+  onSelectLoadOrderProfile,
+  onSaveLoadOrderProfile,
+  onDeleteLoadOrderProfile,
+  onCloseLoadOrderProfilesDialog,
+  onUpdateAllMasterlists,
   onOpenReadme,
   onOpenLogLocation,
   onSaveUserGroups,
   onQuit,
+  onWriteError,
   onApplySettings,
   onCloseSettingsDialog,
   onEditorOpen,
@@ -48,7 +56,12 @@ import {
   onClearMetadata,
   onSearchBegin,
   onSearchEnd,
-  onFolderChange
+  onFolderChange,
+  prepareSortInBackground,
+  reconcileGameData,
+  onMasterlistUpdate,
+  onSortPrepared,
+  loadBackgroundMasterlistUpdate
 } from './events';
 import { closeProgress, showProgress } from './dialog';
 import {
@@ -153,11 +166,23 @@ function addEventListeners(): void {
     'click',
     onCopyLoadOrder
   );
+  getElementById('restoreLoadOrderButton').addEventListener(
+    'click',
+    onRestoreLoadOrder
+  );
+  getElementById('loadOrderProfilesButton').addEventListener(
+    'click',
+    onShowLoadOrderProfilesDialog
+  );
   getElementById('copyContentButton').addEventListener('click', onCopyContent);
   getElementById('refreshContentButton').addEventListener(
     'click',
     onContentRefresh
   );
+  getElementById('updateAllMasterlistsButton').addEventListener(
+    'click',
+    onUpdateAllMasterlists
+  );
   getElementById('settingsButton').addEventListener(
     'click',
     onShowSettingsDialog
@@ -210,6 +235,24 @@ function addEventListeners(): void {
     onApplySettings
   );
 
+  /* Set up event handlers for load order profiles dialog. */
+  getElementById('loadOrderProfilesDialog').addEventListener(
+    'iron-overlay-closed',
+    onCloseLoadOrderProfilesDialog
+  );
+  getElementById('loadOrderProfileSelect').addEventListener(
+    'value-changed',
+    onSelectLoadOrderProfile
+  );
+  getElementById('saveLoadOrderProfileButton').addEventListener(
+    'click',
+    onSaveLoadOrderProfile
+  );
+  getElementById('deleteLoadOrderProfileButton').addEventListener(
+    'click',
+    onDeleteLoadOrderProfile
+  );
+
   /* Set up handler for opening and closing editors. */
   document.body.addEventListener('loot-editor-open', onEditorOpen);
   document.body.addEventListener('loot-editor-close', onEditorClose);
@@ -332,7 +375,8 @@ function getErrorCount(): number {
   return getTextAsInt('totalErrorNo');
 }
 
-function autoSort(l10n: Translator): Promise<void> {
+/* Resolves to whether auto-sort is enabled. */
+function autoSort(l10n: Translator): Promise<boolean> {
   return getAutoSort()
     .then(shouldAutoSort => {
       if (shouldAutoSort) {
@@ -343,6 +387,7 @@ function autoSort(l10n: Translator): Promise<void> {
               if (getErrorCount() === 0) {
                 onQuit();
               }
+              return true;
             });
         }
 
@@ -353,9 +398,12 @@ function autoSort(l10n: Translator): Promise<void> {
         );
       }
 
-      return Promise.resolve(undefined);
+      return shouldAutoSort;
     })
-    .catch(handlePromiseError);
+    .catch(error => {
+      handlePromiseError(error);
+      return false;
+    });
 }
 
 export default class Loot {
@@ -379,6 +427,18 @@ export default class Loot {
   // Used by C++ callbacks.
   public onQuit: () => void;
 
+  // Used by C++ callbacks.
+  public onWriteError: (message: string) => void;
+
+  // Used by C++ callbacks.
+  public onMasterlistUpdate: (gameFolder: string) => void;
+
+  // Used by C++ callbacks.
+  public onSortPrepared: (
+    gameFolder: string,
+    loadOrderIsSorted: boolean
+  ) => void;
+
   public constructor() {
     this.l10n = new Translator();
     this.filters = new Filters(this.l10n);
@@ -391,6 +451,9 @@ export default class Loot {
 
     this.showProgress = showProgress;
     this.onQuit = onQuit;
+    this.onWriteError = onWriteError;
+    this.onMasterlistUpdate = onMasterlistUpdate;
+    this.onSortPrepared = onSortPrepared;
   }
 
   private async loadLootData(): Promise<void> {
@@ -405,9 +468,13 @@ export default class Loot {
     this.settings = settings;
   }
 
-  private async loadGameData(): Promise<void> {
+  // Returns true if the game data came from the masterlist snapshot, and so
+  // needs to be reconciled once metadata has loaded.
+  private async loadGameData(): Promise<boolean> {
     const gameData = await getGameData();
     this.game = new Game(gameData, this.l10n);
+
+    return gameData.isFromSnapshot === true;
   }
 
   private async initialiseGeneralUIElements(): Promise<void> {
@@ -447,11 +514,12 @@ export default class Loot {
       }
 
       const initErrors = await getInitErrors();
+      let shouldPrepareSort = false;
 
       if (initErrors.length > 0) {
         handleInitErrors(initErrors);
       } else {
-        await this.loadGameData();
+        const isFromSnapshot = await this.loadGameData();
 
         if (this.game === undefined) {
           throw new Error('Failed to load game');
@@ -461,7 +529,15 @@ export default class Loot {
 
         closeProgress();
 
-        await autoSort(this.l10n);
+        if (isFromSnapshot) {
+          await reconcileGameData(this.game);
+        }
+
+        const isAutoSortEnabled = await autoSort(this.l10n);
+
+        loadBackgroundMasterlistUpdate();
+
+        shouldPrepareSort = !isAutoSortEnabled;
       }
 
       if (this.settings.lastVersion !== this.version.release) {
@@ -471,6 +547,11 @@ export default class Loot {
       if (this.settings.enableLootUpdateCheck) {
         await checkForLootUpdate(this.l10n);
       }
+
+      /* Do this last, as any other query would cancel it. */
+      if (shouldPrepareSort) {
+        prepareSortInBackground();
+      }
     } catch (error) {
       handlePromiseError(error);
     }
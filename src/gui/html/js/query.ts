@@ -9,7 +9,8 @@ import {
   GameGroups,
   RawGroup,
   PluginMetadata,
-  GameContent
+  GameContent,
+  Masterlist
 } from './interfaces';
 
 interface CefQueryParameters {
@@ -40,11 +41,23 @@ export interface GetConflictingPluginsResponse {
   plugins: PluginData[];
 }
 
+export interface GetConflictingPluginNamesResponse {
+  generalMessages: SimpleMessage[];
+  conflictingPlugins: string[];
+  plugins: DerivedPluginMetadata[];
+}
+
 export interface CancelSortResponse {
   plugins: PluginLoadOrderIndex[];
   generalMessages: SimpleMessage[];
 }
 
+export interface LoadOrderDiff {
+  added: string[];
+  removed: string[];
+  moved: string[];
+}
+
 function query(requestName: string, payload?: object): Promise<string> {
   if (!requestName) {
     throw new Error('No request name passed');
@@ -79,6 +92,15 @@ export function getConflictingPlugins(
   );
 }
 
+export function getConflictingPluginNames(
+  targetPluginName: string
+): Promise<GetConflictingPluginNamesResponse> {
+  return query('getConflictingPlugins', {
+    pluginName: targetPluginName,
+    namesOnly: true
+  }).then(JSON.parse);
+}
+
 export async function getGameTypes(): Promise<string[]> {
   const json = await query('getGameTypes');
   return JSON.parse(json).gameTypes;
@@ -103,6 +125,10 @@ export function getGameData(): Promise<GameData> {
   return query('getGameData').then(JSON.parse);
 }
 
+export function getReconciledGameData(): Promise<GameData> {
+  return query('getReconciledGameData').then(JSON.parse);
+}
+
 export async function getAutoSort(): Promise<boolean> {
   const json = await query('getAutoSort');
   return JSON.parse(json).autoSort;
@@ -112,14 +138,32 @@ export function changeGame(gameFolder: string): Promise<GameData> {
   return query('changeGame', { gameFolder }).then(JSON.parse);
 }
 
-export function updateMasterlist(): Promise<GameData> {
-  return query('updateMasterlist').then(JSON.parse);
+export function updateMasterlist(fetch: boolean): Promise<GameData> {
+  return query('updateMasterlist', { fetch }).then(JSON.parse);
+}
+
+export interface MasterlistUpdateSummary {
+  folder: string;
+  wasChanged: boolean;
+  isUsingFallback: boolean;
+  masterlist?: Masterlist;
+  error?: string;
+}
+
+export function updateAllMasterlists(): Promise<MasterlistUpdateSummary[]> {
+  return query('updateAllMasterlists')
+    .then(JSON.parse)
+    .then(response => response.games);
 }
 
 export function sortPlugins(): Promise<MainContent> {
   return query('sortPlugins').then(JSON.parse);
 }
 
+export function prepareSort(): Promise<void> {
+  return query('prepareSort').then(() => {});
+}
+
 export function cancelSort(): Promise<CancelSortResponse> {
   return query('cancelSort').then(JSON.parse);
 }
@@ -144,10 +188,46 @@ export function saveUserGroups(userGroups: RawGroup[]): Promise<GameGroups> {
   return query('saveUserGroups', { userGroups }).then(JSON.parse);
 }
 
-export function editorClosed(
+export async function editorClosed(
   editorState: EditorState
-): Promise<DerivedPluginMetadata> {
-  return query('editorClosed', { editorState }).then(JSON.parse);
+): Promise<DerivedPluginMetadata[]> {
+  const json = await query('editorClosed', { editorState });
+  return JSON.parse(json).plugins;
+}
+
+export async function getLoadOrderProfiles(): Promise<string[]> {
+  const json = await query('getLoadOrderProfiles');
+  return JSON.parse(json).profiles;
+}
+
+export function saveLoadOrderProfile(profileName: string): Promise<void> {
+  return query('saveLoadOrderProfile', { profileName }).then(() => {});
+}
+
+export async function applyLoadOrderProfile(
+  profileName: string
+): Promise<string[]> {
+  const json = await query('applyLoadOrderProfile', { profileName });
+  return JSON.parse(json).loadOrder;
+}
+
+export async function restoreLoadOrder(age = 0): Promise<string[]> {
+  const json = await query('restoreLoadOrder', { age });
+  return JSON.parse(json).loadOrder;
+}
+
+export function deleteLoadOrderProfile(profileName: string): Promise<void> {
+  return query('deleteLoadOrderProfile', { profileName }).then(() => {});
+}
+
+export function diffLoadOrderProfile(
+  profileName: string,
+  baseProfileName?: string
+): Promise<LoadOrderDiff> {
+  return query('diffLoadOrderProfile', {
+    profileName,
+    baseProfileName
+  }).then(JSON.parse);
 }
 
 export function editorOpened(): Promise<void> {
@@ -166,6 +246,18 @@ export function applySort(pluginNames: string[]): Promise<void> {
   return query('applySort', { pluginNames }).then(() => {});
 }
 
+export interface PluginRedate {
+  name: string;
+  currentTime: number;
+  newTime: number;
+}
+
+export function planPluginRedates(): Promise<PluginRedate[]> {
+  return query('redatePlugins', { dryRun: true })
+    .then(JSON.parse)
+    .then(response => response.plugins);
+}
+
 export function redatePlugins(): Promise<void> {
   return query('redatePlugins').then(() => {});
 }
@@ -43,6 +43,9 @@ export default class State {
     /* Disable changing game. */
     enable('gameMenu', false);
     enable('refreshContentButton', false);
+    enable('restoreLoadOrderButton', false);
+    enable('loadOrderProfilesButton', false);
+    enable('updateAllMasterlistsButton', false);
 
     setUIState('sorting');
 
@@ -67,6 +70,9 @@ export default class State {
     /* Enable changing game. */
     enable('gameMenu');
     enable('refreshContentButton');
+    enable('restoreLoadOrderButton');
+    enable('loadOrderProfilesButton');
+    enable('updateAllMasterlistsButton');
 
     setUIState('default');
 
@@ -85,6 +91,9 @@ export default class State {
     enable('wipeUserlistButton', false);
     enable('copyContentButton', false);
     enable('refreshContentButton', false);
+    enable('restoreLoadOrderButton', false);
+    enable('loadOrderProfilesButton', false);
+    enable('updateAllMasterlistsButton', false);
     enable('settingsButton', false);
     enable('gameMenu', false);
     enable('updateMasterlistButton', false);
@@ -107,6 +116,9 @@ export default class State {
     enable('wipeUserlistButton');
     enable('copyContentButton');
     enable('refreshContentButton');
+    enable('restoreLoadOrderButton');
+    enable('loadOrderProfilesButton');
+    enable('updateAllMasterlistsButton');
     enable('settingsButton');
     enable('gameMenu');
     enable('updateMasterlistButton');
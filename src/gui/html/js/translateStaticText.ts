@@ -485,12 +485,21 @@ function translateMainToolbar(l10n: Translator): void {
   getLastChildById('copyLoadOrderButton').textContent = l10n.translate(
     'Copy Load Order'
   );
+  getLastChildById('restoreLoadOrderButton').textContent = l10n.translate(
+    'Restore Previous Load Order'
+  );
+  getLastChildById('loadOrderProfilesButton').textContent = l10n.translate(
+    'Load Order Profiles'
+  );
   getLastChildById('copyContentButton').textContent = l10n.translate(
     'Copy Content'
   );
   getLastChildById('refreshContentButton').textContent = l10n.translate(
     'Refresh Content'
   );
+  getLastChildById('updateAllMasterlistsButton').textContent = l10n.translate(
+    'Update All Masterlists'
+  );
   getLastChildById('helpButton').textContent = l10n.translate(
     'View Documentation'
   );
@@ -728,6 +737,35 @@ function translateSettingsDialog(l10n: Translator): void {
   )[0].textContent = l10n.translate('Cancel');
 }
 
+function translateLoadOrderProfilesDialog(l10n: Translator): void {
+  /* Load order profiles dialog */
+  const dialog = getElementById('loadOrderProfilesDialog');
+  querySelector(dialog, 'h2').textContent = l10n.translate(
+    'Load Order Profiles'
+  );
+
+  getPreviousElementSiblingById(
+    'loadOrderProfileSelect'
+  ).textContent = l10n.translate('Profile');
+  getElementById('deleteLoadOrderProfileButton').textContent = l10n.translate(
+    'Delete Profile'
+  );
+
+  (getElementById(
+    'loadOrderProfileName'
+  ) as PaperInputElement).label = l10n.translate('Profile Name');
+  getElementById('saveLoadOrderProfileButton').textContent = l10n.translate(
+    'Save Current Load Order'
+  );
+
+  dialog.getElementsByClassName('accept')[0].textContent = l10n.translate(
+    'Apply'
+  );
+  dialog.getElementsByClassName('cancel')[0].textContent = l10n.translate(
+    'Cancel'
+  );
+}
+
 function translateFirstRunDialog(l10n: Translator, version: LootVersion): void {
   /* First-run dialog */
   const firstRun = getElementById('firstRun');
@@ -821,6 +859,7 @@ export default function translateStaticText(
 
   translateSummaryCard(l10n);
   translateSettingsDialog(l10n);
+  translateLoadOrderProfilesDialog(l10n);
   translateFirstRunDialog(l10n, version);
   translateAboutDialog(l10n, version);
 }
@@ -25,6 +25,7 @@
 
 #include "gui/cef/loot_app.h"
 #include "gui/state/loot_paths.h"
+#include "gui/state/tracing.h"
 
 #ifdef _WIN32
 #ifndef UNICODE
@@ -118,6 +119,24 @@ int APIENTRY wWinMain(HINSTANCE hInstance,
     hMutex = ::CreateMutex(NULL, FALSE, L"LOOT.Shell.Instance");
   }
 
+  if (!cliOptions.traceFile.empty()) {
+    loot::startTracing(std::filesystem::u8path(cliOptions.traceFile));
+  }
+
+  // Auto-sort and masterlist updates don't display anything, so they don't
+  // need CEF.
+  if (cliOptions.autoSort) {
+    exit_code = app->RunAutoSort();
+    ReleaseMutex(hMutex);
+    return exit_code;
+  }
+
+  if (cliOptions.updateMasterlists) {
+    exit_code = app->RunMasterlistUpdates();
+    ReleaseMutex(hMutex);
+    return exit_code;
+  }
+
   // Back to CEF
   //------------
 
@@ -134,6 +153,10 @@ int APIENTRY wWinMain(HINSTANCE hInstance,
   // Shut down CEF.
   CefShutdown();
 
+  // Settings are saved in the background, so make sure that the last save
+  // has finished before exiting.
+  app->FlushSettings();
+
   // Release the program instance mutex.
   if (hMutex != NULL) {
     ReleaseMutex(hMutex);
@@ -162,6 +185,20 @@ int main(int argc, char *argv[]) {
     return exit_code;
   }
 
+  if (!cliOptions.traceFile.empty()) {
+    loot::startTracing(std::filesystem::u8path(cliOptions.traceFile));
+  }
+
+  // Auto-sort and masterlist updates don't display anything, so they don't
+  // need CEF.
+  if (cliOptions.autoSort) {
+    return app->RunAutoSort();
+  }
+
+  if (cliOptions.updateMasterlists) {
+    return app->RunMasterlistUpdates();
+  }
+
   // Initialise CEF settings.
   CefSettings cef_settings = GetCefSettings(app.get()->getL10nPath());
 
@@ -180,6 +217,10 @@ int main(int argc, char *argv[]) {
   // Shut down CEF.
   CefShutdown();
 
+  // Settings are saved in the background, so make sure that the last save
+  // has finished before exiting.
+  app->FlushSettings();
+
   return 0;
 }
 #endif
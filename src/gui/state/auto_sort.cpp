@@ -0,0 +1,110 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/auto_sort.h"
+
+#include <algorithm>
+
+#include "gui/state/logging.h"
+
+namespace loot {
+bool AutoSort(gui::Game& game, bool updateMasterlist, Timeline& timeline) {
+  auto logger = getLogger();
+
+  if (updateMasterlist) {
+    Timeline::ScopedSpan span(timeline, "Masterlist update");
+
+    // Update the masterlist before the metadata lists are parsed, so that the
+    // parse picks up any changes.
+    game.UpdateMasterlist();
+  }
+
+  {
+    Timeline::ScopedSpan span(timeline, "Plugin and metadata loading");
+
+    // Parsing the metadata lists doesn't depend on the loaded plugins, so do
+    // it while the plugins are loaded.
+    game.LoadMetadataInBackground();
+    game.LoadAllInstalledPlugins(true);
+    game.WaitForMetadata();
+  }
+
+  size_t errorCount = 0;
+  {
+    Timeline::ScopedSpan span(timeline, "Error checking");
+    errorCount = game.CountErrorMessages();
+  }
+
+  if (errorCount > 0) {
+    if (logger) {
+      logger->error(
+          "Auto-sort has been cancelled as there are {} error messages.",
+          errorCount);
+    }
+    return false;
+  }
+
+  std::vector<std::string> sortedPlugins;
+  {
+    Timeline::ScopedSpan span(timeline, "Sorting");
+    sortedPlugins = game.SortPlugins();
+  }
+
+  // The sorted load order will be empty if there was a sorting error.
+  if (sortedPlugins.empty()) {
+    if (logger) {
+      logger->error("Auto-sort failed as the load order could not be sorted.");
+    }
+    return false;
+  }
+
+  {
+    Timeline::ScopedSpan span(timeline, "Load order application");
+
+    // Setting the load order records the current load order, so avoid
+    // filling the journal with duplicates.
+    if (sortedPlugins == game.GetLoadOrder()) {
+      if (logger) {
+        logger->info("The load order is already sorted, leaving it alone.");
+      }
+    } else {
+      game.SetLoadOrder(sortedPlugins);
+    }
+  }
+
+  // Sorting may have added messages, e.g. about missing groups.
+  auto messages = game.GetMessages();
+  auto hasErrors =
+      std::any_of(begin(messages), end(messages), [](const Message& message) {
+        return message.GetType() == MessageType::error;
+      });
+  if (hasErrors && logger) {
+    logger->error(
+        "The sorted load order was applied, but sorting produced errors.");
+  }
+
+  return !hasErrors;
+}
+}
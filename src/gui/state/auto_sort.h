@@ -0,0 +1,42 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_AUTO_SORT
+#define LOOT_GUI_STATE_AUTO_SORT
+
+#include "gui/state/game/game.h"
+#include "gui/state/timeline.h"
+
+namespace loot {
+// Loads the game's plugins and metadata, then sorts its load order and applies
+// the result without involving the UI. If updateMasterlist is true, the
+// masterlist is updated first. Sorting is cancelled if the UI would display
+// any error messages, and the load order is left alone if it's already
+// sorted. Each stage is recorded in the given timeline. Returns true if no
+// errors occurred, and throws if a stage fails.
+bool AutoSort(gui::Game& game, bool updateMasterlist, Timeline& timeline);
+}
+
+#endif
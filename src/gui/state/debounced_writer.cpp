@@ -0,0 +1,117 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/debounced_writer.h"
+
+#include "gui/state/logging.h"
+
+namespace loot {
+DebouncedWriter::DebouncedWriter(std::chrono::milliseconds delay) :
+    delay_(delay), isWriting_(false), isStopping_(false) {}
+
+DebouncedWriter::~DebouncedWriter() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    isStopping_ = true;
+  }
+  condition_.notify_all();
+
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void DebouncedWriter::Schedule(std::function<void()> write) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    pendingWrite_ = std::move(write);
+    deadline_ = std::chrono::steady_clock::now() + delay_;
+
+    // The thread is only started once there's something to write.
+    if (!thread_.joinable()) {
+      thread_ = std::thread(&DebouncedWriter::Run, this);
+    }
+  }
+  condition_.notify_all();
+}
+
+void DebouncedWriter::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  deadline_ = std::chrono::steady_clock::time_point::min();
+  condition_.notify_all();
+
+  condition_.wait(lock, [this]() { return !pendingWrite_ && !isWriting_; });
+
+  if (lastError_) {
+    auto error = lastError_;
+    lastError_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+void DebouncedWriter::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true) {
+    if (!pendingWrite_) {
+      if (isStopping_) {
+        return;
+      }
+      condition_.wait(lock);
+      continue;
+    }
+
+    if (!isStopping_ && std::chrono::steady_clock::now() < deadline_) {
+      condition_.wait_until(lock, deadline_);
+      continue;
+    }
+
+    auto write = std::move(pendingWrite_);
+    pendingWrite_ = nullptr;
+    isWriting_ = true;
+    lock.unlock();
+
+    std::exception_ptr error;
+    try {
+      write();
+    } catch (std::exception& e) {
+      auto logger = getLogger();
+      if (logger) {
+        logger->error("A background write failed. Details: {}", e.what());
+      }
+      error = std::current_exception();
+    }
+
+    lock.lock();
+    if (error) {
+      lastError_ = error;
+    }
+    isWriting_ = false;
+    condition_.notify_all();
+  }
+}
+}
@@ -0,0 +1,74 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_DEBOUNCED_WRITER
+#define LOOT_GUI_STATE_DEBOUNCED_WRITER
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace loot {
+// Runs writes on a background thread. A write is only run once no other write
+// has been scheduled for the writer's delay, so a burst of scheduled writes
+// results in only the last of them being run. If a write throws, the error is
+// kept until the next call to Flush(), which rethrows it.
+class DebouncedWriter {
+public:
+  explicit DebouncedWriter(std::chrono::milliseconds delay);
+  // Runs any pending write before returning.
+  ~DebouncedWriter();
+
+  DebouncedWriter(const DebouncedWriter&) = delete;
+  DebouncedWriter& operator=(const DebouncedWriter&) = delete;
+
+  // Replaces any write that has not yet been run.
+  void Schedule(std::function<void()> write);
+
+  // Runs any pending write without waiting for the delay to pass, and blocks
+  // until it has completed. Throws the error from the most recent write that
+  // failed since the last flush, if there is one.
+  void Flush();
+
+private:
+  void Run();
+
+  const std::chrono::milliseconds delay_;
+  std::function<void()> pendingWrite_;
+  std::chrono::steady_clock::time_point deadline_;
+  bool isWriting_;
+  bool isStopping_;
+  std::exception_ptr lastError_;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::thread thread_;
+};
+}
+
+#endif
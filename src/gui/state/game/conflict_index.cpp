@@ -0,0 +1,77 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/game/conflict_index.h"
+
+#include <stdexcept>
+
+namespace loot {
+namespace gui {
+ConflictIndex::ConflictIndex(std::shared_ptr<const PluginSnapshot> snapshot) :
+    snapshot_(snapshot),
+    size_(snapshot->Size()),
+    doesPairConflict_(size_ * size_, false) {
+  const auto& plugins = snapshot_->GetPlugins();
+  for (size_t i = 0; i < size_; ++i) {
+    for (size_t j = i; j < size_; ++j) {
+      bool conflict = plugins[i]->DoFormIDsOverlap(*plugins[j]);
+      doesPairConflict_[i * size_ + j] = conflict;
+      doesPairConflict_[j * size_ + i] = conflict;
+    }
+  }
+}
+
+std::shared_ptr<const PluginSnapshot> ConflictIndex::GetSnapshot() const {
+  return snapshot_;
+}
+
+bool ConflictIndex::DoPluginsConflict(size_t firstIndex,
+                                      size_t secondIndex) const {
+  CheckIndex(firstIndex);
+  CheckIndex(secondIndex);
+
+  return doesPairConflict_[firstIndex * size_ + secondIndex];
+}
+
+std::vector<size_t> ConflictIndex::GetConflictingPlugins(size_t index) const {
+  CheckIndex(index);
+
+  std::vector<size_t> conflictingPlugins;
+  for (size_t i = 0; i < size_; ++i) {
+    if (doesPairConflict_[index * size_ + i]) {
+      conflictingPlugins.push_back(i);
+    }
+  }
+
+  return conflictingPlugins;
+}
+
+void ConflictIndex::CheckIndex(size_t index) const {
+  if (index >= size_) {
+    throw std::out_of_range("Plugin index is out of range");
+  }
+}
+}
+}
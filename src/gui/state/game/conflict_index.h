@@ -0,0 +1,65 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_GAME_CONFLICT_INDEX
+#define LOOT_GUI_STATE_GAME_CONFLICT_INDEX
+
+#include <memory>
+#include <vector>
+
+#include "gui/state/game/plugin_snapshot.h"
+
+namespace loot {
+namespace gui {
+// Records which of a snapshot's plugins have overlapping FormIDs. libloot only
+// exposes a pairwise overlap check, so every pair is checked once when the
+// index is built, and lookups are then just reads. The plugins must have been
+// fully loaded for their FormIDs to be compared.
+class ConflictIndex {
+public:
+  explicit ConflictIndex(std::shared_ptr<const PluginSnapshot> snapshot);
+
+  std::shared_ptr<const PluginSnapshot> GetSnapshot() const;
+
+  bool DoPluginsConflict(size_t firstIndex, size_t secondIndex) const;
+
+  // A plugin with any records conflicts with itself, so it's included in
+  // its own conflicts.
+  std::vector<size_t> GetConflictingPlugins(size_t index) const;
+
+private:
+  void CheckIndex(size_t index) const;
+
+  const std::shared_ptr<const PluginSnapshot> snapshot_;
+  const size_t size_;
+
+  // Each pair of plugins is stored twice, once for each order, so that a
+  // plugin's conflicts are contiguous.
+  std::vector<bool> doesPairConflict_;
+};
+}
+}
+
+#endif
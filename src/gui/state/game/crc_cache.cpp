@@ -0,0 +1,394 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/game/crc_cache.h"
+
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <system_error>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef UNICODE
+#define UNICODE
+#endif
+#ifndef _UNICODE
+#define _UNICODE
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "gui/state/logging.h"
+#include "loot/exception/file_access_error.h"
+
+namespace fs = std::filesystem;
+
+namespace loot {
+namespace gui {
+namespace {
+// Identifies a cache file, and changes whenever the format does.
+constexpr char CACHE_HEADER[] = "LOOT CRC cache 1";
+
+constexpr size_t CRC_SLICES = 16;
+
+// Table k holds the CRC contribution of a byte followed by k zero bytes, so
+// that the CRC of 16 bytes can be updated with 16 independent lookups instead
+// of 16 dependent ones.
+constexpr std::array<std::array<uint32_t, 256>, CRC_SLICES> CreateCrcTables() {
+  std::array<std::array<uint32_t, 256>, CRC_SLICES> tables{};
+
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+    }
+    tables[0][i] = crc;
+  }
+
+  for (size_t slice = 1; slice < CRC_SLICES; ++slice) {
+    for (size_t i = 0; i < 256; ++i) {
+      auto previous = tables[slice - 1][i];
+      tables[slice][i] = (previous >> 8) ^ tables[0][previous & 0xFF];
+    }
+  }
+
+  return tables;
+}
+
+constexpr auto CRC_TABLES = CreateCrcTables();
+
+uint32_t ReadUInt32(const unsigned char* data) {
+  return static_cast<uint32_t>(data[0]) |
+         (static_cast<uint32_t>(data[1]) << 8) |
+         (static_cast<uint32_t>(data[2]) << 16) |
+         (static_cast<uint32_t>(data[3]) << 24);
+}
+
+// A read-only view of a whole file's contents.
+class MappedFile {
+public:
+  explicit MappedFile(const fs::path& path) : data_(nullptr), size_(0) {
+#ifdef _WIN32
+    file_ = CreateFile(path.wstring().c_str(),
+                       GENERIC_READ,
+                       FILE_SHARE_READ,
+                       NULL,
+                       OPEN_EXISTING,
+                       FILE_FLAG_SEQUENTIAL_SCAN,
+                       NULL);
+    mapping_ = NULL;
+    if (file_ == INVALID_HANDLE_VALUE) {
+      throw FileAccessError("Failed to open " + path.u8string());
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file_, &size)) {
+      CloseHandle(file_);
+      throw FileAccessError("Failed to get the size of " + path.u8string());
+    }
+    size_ = static_cast<size_t>(size.QuadPart);
+
+    // Empty files can't be mapped.
+    if (size_ == 0) {
+      return;
+    }
+
+    mapping_ = CreateFileMapping(file_, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping_ != NULL) {
+      data_ = static_cast<const unsigned char*>(
+          MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (data_ == nullptr) {
+      if (mapping_ != NULL) {
+        CloseHandle(mapping_);
+      }
+      CloseHandle(file_);
+      throw FileAccessError("Failed to map " + path.u8string());
+    }
+#else
+    file_ = open(path.c_str(), O_RDONLY);
+    if (file_ == -1) {
+      throw FileAccessError("Failed to open " + path.u8string());
+    }
+
+    struct stat status;
+    if (fstat(file_, &status) != 0) {
+      close(file_);
+      throw FileAccessError("Failed to get the size of " + path.u8string());
+    }
+    size_ = static_cast<size_t>(status.st_size);
+
+    // Empty files can't be mapped.
+    if (size_ == 0) {
+      return;
+    }
+
+    auto data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file_, 0);
+    if (data == MAP_FAILED) {
+      close(file_);
+      throw FileAccessError("Failed to map " + path.u8string());
+    }
+    madvise(data, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const unsigned char*>(data);
+#endif
+  }
+
+  ~MappedFile() {
+#ifdef _WIN32
+    if (data_ != nullptr) {
+      UnmapViewOfFile(data_);
+    }
+    if (mapping_ != NULL) {
+      CloseHandle(mapping_);
+    }
+    CloseHandle(file_);
+#else
+    if (data_ != nullptr) {
+      munmap(const_cast<unsigned char*>(data_), size_);
+    }
+    close(file_);
+#endif
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const unsigned char* GetData() const { return data_; }
+  size_t GetSize() const { return size_; }
+
+private:
+#ifdef _WIN32
+  HANDLE file_;
+  HANDLE mapping_;
+#else
+  int file_;
+#endif
+  const unsigned char* data_;
+  size_t size_;
+};
+}
+
+uint32_t CalculateCrc32(const unsigned char* data, size_t size, uint32_t crc) {
+  const auto& t = CRC_TABLES;
+  crc = ~crc;
+
+  while (size >= CRC_SLICES) {
+    auto one = ReadUInt32(data) ^ crc;
+    auto two = ReadUInt32(data + 4);
+    auto three = ReadUInt32(data + 8);
+    auto four = ReadUInt32(data + 12);
+
+    crc = t[0][four >> 24] ^ t[1][(four >> 16) & 0xFF] ^
+          t[2][(four >> 8) & 0xFF] ^ t[3][four & 0xFF] ^ t[4][three >> 24] ^
+          t[5][(three >> 16) & 0xFF] ^ t[6][(three >> 8) & 0xFF] ^
+          t[7][three & 0xFF] ^ t[8][two >> 24] ^ t[9][(two >> 16) & 0xFF] ^
+          t[10][(two >> 8) & 0xFF] ^ t[11][two & 0xFF] ^ t[12][one >> 24] ^
+          t[13][(one >> 16) & 0xFF] ^ t[14][(one >> 8) & 0xFF] ^
+          t[15][one & 0xFF];
+
+    data += CRC_SLICES;
+    size -= CRC_SLICES;
+  }
+
+  while (size > 0) {
+    crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xFF];
+    ++data;
+    --size;
+  }
+
+  return ~crc;
+}
+
+uint32_t CalculateCrc32(const fs::path& file) {
+  MappedFile mappedFile(file);
+
+  return CalculateCrc32(mappedFile.GetData(), mappedFile.GetSize(), 0);
+}
+
+CrcCache::CrcCache(fs::path file, std::chrono::milliseconds saveDelay) :
+    file_(file), isLoaded_(false), writer_(saveDelay) {}
+
+std::optional<uint32_t> CrcCache::Find(const fs::path& file) const {
+  auto state = GetFileState(file);
+  if (!state.has_value()) {
+    return std::nullopt;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  Load();
+
+  auto it = entries_.find(file.u8string());
+  if (it == entries_.end() || it->second.size != state.value().size ||
+      it->second.writeTime != state.value().writeTime) {
+    return std::nullopt;
+  }
+
+  return it->second.crc;
+}
+
+uint32_t CrcCache::GetCrc(const fs::path& file) {
+  auto crc = Find(file);
+  if (crc.has_value()) {
+    return crc.value();
+  }
+
+  auto logger = getLogger();
+  if (logger) {
+    logger->trace("Calculating the CRC of {}", file.u8string());
+  }
+
+  // The file is read without holding the lock, so that other files can be
+  // looked up in the meantime.
+  auto calculatedCrc = CalculateCrc32(file);
+  Insert(file, calculatedCrc);
+
+  return calculatedCrc;
+}
+
+void CrcCache::Insert(const fs::path& file, uint32_t crc) {
+  auto state = GetFileState(file);
+  if (!state.has_value()) {
+    return;
+  }
+  state.value().crc = crc;
+
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    Load();
+
+    auto key = file.u8string();
+    auto it = entries_.find(key);
+    if (it != entries_.end() && it->second.size == state.value().size &&
+        it->second.writeTime == state.value().writeTime &&
+        it->second.crc == crc) {
+      return;
+    }
+    entries_[key] = state.value();
+  }
+
+  writer_.Schedule([this]() { Save(); });
+}
+
+void CrcCache::Flush() { writer_.Flush(); }
+
+std::optional<CrcCache::Entry> CrcCache::GetFileState(const fs::path& file) {
+  std::error_code ec;
+  auto size = fs::file_size(file, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  auto writeTime = fs::last_write_time(file, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+
+  return Entry{size, writeTime.time_since_epoch().count(), 0};
+}
+
+void CrcCache::Load() const {
+  if (isLoaded_) {
+    return;
+  }
+  isLoaded_ = true;
+
+  std::ifstream in(file_);
+  if (!in.is_open()) {
+    return;
+  }
+
+  std::string line;
+  if (!std::getline(in, line) || line != CACHE_HEADER) {
+    auto logger = getLogger();
+    if (logger) {
+      logger->warn("Ignoring unrecognised CRC cache at {}", file_.u8string());
+    }
+    return;
+  }
+
+  // Each line holds a CRC, a file size and a modification time, followed by
+  // the file's path, which may contain spaces.
+  while (std::getline(in, line)) {
+    std::istringstream stream(line);
+    Entry entry;
+    std::string path;
+    if (stream >> std::hex >> entry.crc >> std::dec >> entry.size >>
+            entry.writeTime &&
+        stream.get() == ' ' && std::getline(stream, path) && !path.empty()) {
+      entries_[path] = entry;
+    }
+  }
+}
+
+void CrcCache::Save() const {
+  std::vector<std::pair<std::string, Entry>> entries;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    entries.assign(entries_.begin(), entries_.end());
+  }
+
+  // Write to a temporary file first so that an interrupted save can't leave
+  // a truncated cache behind.
+  auto tempFile = file_;
+  tempFile += ".tmp";
+
+  {
+    std::ofstream out(tempFile, std::ios::trunc);
+    if (!out.is_open()) {
+      throw FileAccessError("Failed to open " + tempFile.u8string());
+    }
+
+    out << CACHE_HEADER << '\n';
+    for (const auto& [path, entry] : entries) {
+      // Drop entries for files that no longer exist.
+      std::error_code ec;
+      if (!fs::exists(fs::u8path(path), ec)) {
+        continue;
+      }
+
+      out << std::hex << std::setw(8) << std::setfill('0') << entry.crc
+          << std::dec << ' ' << entry.size << ' ' << entry.writeTime << ' '
+          << path << '\n';
+    }
+  }
+
+  fs::rename(tempFile, file_);
+
+  auto logger = getLogger();
+  if (logger) {
+    logger->debug("Wrote {} CRCs to {}", entries.size(), file_.u8string());
+  }
+}
+}
+}
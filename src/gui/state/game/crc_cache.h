@@ -0,0 +1,97 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_GAME_CRC_CACHE
+#define LOOT_GUI_STATE_GAME_CRC_CACHE
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "gui/state/debounced_writer.h"
+
+namespace loot {
+namespace gui {
+// Calculates the CRC-32 of a file's contents by memory-mapping it.
+uint32_t CalculateCrc32(const std::filesystem::path& file);
+// Continues a CRC-32 calculation over the given bytes. Pass the CRC of the
+// bytes processed so far, or zero to start a new calculation.
+uint32_t CalculateCrc32(const unsigned char* data, size_t size, uint32_t crc);
+
+// A persistent record of file CRCs. A file's entry is only used while the
+// file's size and modification time are unchanged, and missing entries are
+// calculated and added. The cache file is loaded on first use, and is
+// rewritten in the background once additions stop arriving.
+class CrcCache {
+public:
+  explicit CrcCache(
+      std::filesystem::path file,
+      std::chrono::milliseconds saveDelay = std::chrono::seconds(1));
+
+  CrcCache(const CrcCache&) = delete;
+  CrcCache& operator=(const CrcCache&) = delete;
+
+  // Returns std::nullopt if the file has no current entry.
+  std::optional<uint32_t> Find(const std::filesystem::path& file) const;
+  // Calculates and caches the file's CRC if it has no current entry.
+  uint32_t GetCrc(const std::filesystem::path& file);
+  // Records a CRC that was calculated elsewhere for the file's current
+  // contents.
+  void Insert(const std::filesystem::path& file, uint32_t crc);
+
+  // Blocks until any pending write of the cache file has completed, and
+  // throws if a write has failed since the last flush.
+  void Flush();
+
+private:
+  struct Entry {
+    std::uintmax_t size;
+    std::filesystem::file_time_type::rep writeTime;
+    uint32_t crc;
+  };
+
+  static std::optional<Entry> GetFileState(const std::filesystem::path& file);
+
+  void Load() const;
+  void Save() const;
+
+  const std::filesystem::path file_;
+
+  mutable bool isLoaded_;
+  mutable std::unordered_map<std::string, Entry> entries_;
+
+  mutable std::mutex mutex_;
+  // Declared last so that a pending save runs before the other members are
+  // destroyed.
+  DebouncedWriter writer_;
+};
+}
+}
+
+#endif
@@ -26,9 +26,16 @@
 #include "gui/state/game/game.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <cstring>
 #include <fstream>
+#include <future>
+#include <map>
+#include <system_error>
 #include <thread>
+#include <unordered_map>
 
 #ifdef _WIN32
 #ifndef UNICODE
@@ -53,7 +60,9 @@
 #include "gui/state/game/game_detection_error.h"
 #include "gui/state/game/helpers.h"
 #include "gui/state/logging.h"
+#include "gui/state/tracing.h"
 #include "loot/exception/file_access_error.h"
+#include "loot/exception/git_state_error.h"
 #include "loot/exception/undefined_group_error.h"
 
 using std::list;
@@ -66,6 +75,31 @@ using std::filesystem::u8path;
 
 namespace fs = std::filesystem;
 
+namespace {
+// A masterlist repository that may be shared by several games. Only one
+// fetch of a repository runs at a time, and fetchCount is incremented under
+// the mutex once a fetch completes, so that a fetch that was waiting on
+// another can reuse its result.
+struct SharedMasterlistRepository {
+  std::mutex mutex;
+  std::atomic<unsigned long> fetchCount{0};
+};
+
+// User metadata saves that are made within this period of each other are
+// written to the userlist together.
+constexpr std::chrono::seconds USERLIST_WRITE_DELAY(2);
+
+SharedMasterlistRepository& GetSharedMasterlistRepository(
+    const fs::path& masterlistPath) {
+  static std::mutex repositoriesMutex;
+  static std::map<fs::path, SharedMasterlistRepository> repositories;
+
+  lock_guard<mutex> guard(repositoriesMutex);
+
+  return repositories[masterlistPath];
+}
+}
+
 namespace loot {
 namespace gui {
 bool hasPluginFileExtension(const std::string& filename) {
@@ -77,25 +111,67 @@ bool hasPluginFileExtension(const std::string& filename) {
 Game::Game(const GameSettings& gameSettings,
            const std::filesystem::path& lootDataPath) :
     GameSettings(gameSettings),
+    pluginSnapshot_(std::make_shared<PluginSnapshot>()),
     lootDataPath_(lootDataPath),
+    userlistWriter_(std::make_shared<DebouncedWriter>(USERLIST_WRITE_DELAY)),
+    userMetadataMutex_(std::make_shared<std::mutex>()),
+    metadataGeneration_(0),
+    loadOrderSortCount_(0),
     pluginsFullyLoaded_(false),
-    loadOrderSortCount_(0) {}
+    masterlistSnapshotNeedsUpdate_(false) {}
 
 Game::Game(const Game& game) :
     GameSettings(game),
-    lootDataPath_(game.lootDataPath_),
     gameHandle_(game.gameHandle_),
-    pluginsFullyLoaded_(game.pluginsFullyLoaded_),
+    metadataLoad_(game.metadataLoad_),
+    masterlistFetch_(game.masterlistFetch_),
+    crcCalculation_(game.crcCalculation_),
+    pluginSnapshot_(game.GetPluginSnapshot()),
+    conflictIndex_(std::atomic_load(&game.conflictIndex_)),
     messages_(game.messages_),
-    loadOrderSortCount_(0) {}
+    lootDataPath_(game.lootDataPath_),
+    loadedMasterlistWriteTime_(game.loadedMasterlistWriteTime_),
+    lastSort_(game.lastSort_),
+    backgroundSort_(std::atomic_load(&game.backgroundSort_)),
+    loadedPluginFiles_(game.loadedPluginFiles_),
+    interactionGraph_(game.interactionGraph_),
+    loadOrderJournal_(game.loadOrderJournal_),
+    crcCache_(game.crcCache_),
+    userlistWriter_(game.userlistWriter_),
+    userMetadataMutex_(game.userMetadataMutex_),
+    cyclicInteractions_(game.cyclicInteractions_),
+    cyclicInteractionMembers_(game.cyclicInteractionMembers_),
+    metadataGeneration_(game.metadataGeneration_),
+    loadOrderSortCount_(0),
+    pluginsFullyLoaded_(game.pluginsFullyLoaded_),
+    masterlistSnapshotNeedsUpdate_(game.masterlistSnapshotNeedsUpdate_) {}
 
 Game& Game::operator=(const Game& game) {
   if (&game != this) {
     GameSettings::operator=(game);
 
     lootDataPath_ = game.lootDataPath_;
+    loadedMasterlistWriteTime_ = game.loadedMasterlistWriteTime_;
     gameHandle_ = game.gameHandle_;
+    metadataLoad_ = game.metadataLoad_;
+    masterlistFetch_ = game.masterlistFetch_;
+    crcCalculation_ = game.crcCalculation_;
+    std::atomic_store(&pluginSnapshot_, game.GetPluginSnapshot());
+    std::atomic_store(&conflictIndex_, std::atomic_load(&game.conflictIndex_));
+    lastSort_ = game.lastSort_;
+    std::atomic_store(&backgroundSort_,
+                      std::atomic_load(&game.backgroundSort_));
+    loadedPluginFiles_ = game.loadedPluginFiles_;
+    interactionGraph_ = game.interactionGraph_;
+    loadOrderJournal_ = game.loadOrderJournal_;
+    crcCache_ = game.crcCache_;
+    userlistWriter_ = game.userlistWriter_;
+    userMetadataMutex_ = game.userMetadataMutex_;
+    cyclicInteractions_ = game.cyclicInteractions_;
+    cyclicInteractionMembers_ = game.cyclicInteractionMembers_;
+    metadataGeneration_ = game.metadataGeneration_;
     pluginsFullyLoaded_ = game.pluginsFullyLoaded_;
+    masterlistSnapshotNeedsUpdate_ = game.masterlistSnapshotNeedsUpdate_;
     messages_ = game.messages_;
     loadOrderSortCount_ = game.loadOrderSortCount_;
   }
@@ -113,7 +189,20 @@ void Game::Init() {
   messages_.clear();
   loadOrderSortCount_ = 0;
   pluginsFullyLoaded_ = false;
-
+  masterlistSnapshotNeedsUpdate_ = false;
+  loadedMasterlistWriteTime_ = std::nullopt;
+  lastSort_ = std::nullopt;
+  CancelBackgroundSort();
+  std::atomic_store(&backgroundSort_, std::shared_ptr<const BackgroundSort>());
+  loadedPluginFiles_.clear();
+  interactionGraph_.reset();
+  ClearCyclicInteractions();
+  std::atomic_store(&pluginSnapshot_,
+                    std::shared_ptr<const PluginSnapshot>(
+                        std::make_shared<PluginSnapshot>()));
+
+  WaitForMetadata();
+  metadataLoad_ = {};
   gameHandle_ = CreateGameHandle(Type(), GamePath(), GameLocalPath());
   gameHandle_->IdentifyMainMasterFile(Master());
 
@@ -128,28 +217,112 @@ void Game::Init() {
       }
       fs::create_directories(lootGamePath);
     }
+
+    loadOrderJournal_ =
+        std::make_shared<LoadOrderJournal>(lootGamePath / "loadorder.journal");
+    crcCache_ = std::make_shared<CrcCache>(lootGamePath / "crc.cache");
+
+    MigrateMasterlistRepository();
+  }
+}
+
+bool Game::IsInitialised() const { return gameHandle_ != nullptr; }
+
+void Game::Unload() {
+  auto logger = getLogger();
+  if (logger) {
+    logger->debug("Unloading data for game: {}", Name());
   }
+
+  std::atomic_store(&pluginSnapshot_,
+                    std::shared_ptr<const PluginSnapshot>(
+                        std::make_shared<PluginSnapshot>()));
+  std::atomic_store(&conflictIndex_, std::shared_ptr<const ConflictIndex>());
+  WaitForMetadata();
+  metadataLoad_ = {};
+  gameHandle_.reset();
+  loadedMasterlistWriteTime_ = std::nullopt;
+  lastSort_ = std::nullopt;
+  CancelBackgroundSort();
+  std::atomic_store(&backgroundSort_, std::shared_ptr<const BackgroundSort>());
+  loadedPluginFiles_.clear();
+  interactionGraph_.reset();
+  ClearCyclicInteractions();
+  messages_.clear();
+  loadOrderSortCount_ = 0;
+  pluginsFullyLoaded_ = false;
+}
+
+size_t Game::EstimateMemoryUsage() const {
+  // Loading a plugin's header takes very little memory, but fully loading a
+  // plugin also records all its FormIDs, which scales with plugin size.
+  static constexpr size_t PLUGIN_HEADER_SIZE = 4 * 1024;
+  static constexpr size_t FULLY_LOADED_PLUGIN_SIZE = 256 * 1024;
+  // Parsed metadata takes up several times the space of its YAML source.
+  static constexpr size_t METADATA_EXPANSION_FACTOR = 8;
+
+  if (!IsInitialised()) {
+    return 0;
+  }
+
+  size_t estimate = 0;
+  for (const auto& path : {MasterlistPath(), UserlistPath()}) {
+    std::error_code ec;
+    auto fileSize = fs::file_size(path, ec);
+    if (!ec) {
+      estimate += fileSize * METADATA_EXPANSION_FACTOR;
+    }
+  }
+
+  auto pluginSize =
+      pluginsFullyLoaded_ ? FULLY_LOADED_PLUGIN_SIZE : PLUGIN_HEADER_SIZE;
+  estimate += GetPluginSnapshot()->Size() * pluginSize;
+
+  return estimate;
 }
 
 std::shared_ptr<const PluginInterface> Game::GetPlugin(
     const std::string& name) const {
-  return gameHandle_->GetPlugin(name);
+  return GetPluginSnapshot()->GetPlugin(name);
 }
 
 std::vector<std::shared_ptr<const PluginInterface>> Game::GetPlugins() const {
-  return gameHandle_->GetLoadedPlugins();
+  return GetPluginSnapshot()->GetPlugins();
+}
+
+std::shared_ptr<const PluginSnapshot> Game::GetPluginSnapshot() const {
+  return std::atomic_load(&pluginSnapshot_);
+}
+
+std::shared_ptr<const ConflictIndex> Game::GetConflictIndex() const {
+  auto snapshot = GetPluginSnapshot();
+  auto conflictIndex = std::atomic_load(&conflictIndex_);
+
+  // Conflicts only depend on the loaded plugins, so the index can be reused
+  // if a new snapshot has the same plugins, e.g. if only their active states
+  // have changed.
+  if (conflictIndex &&
+      conflictIndex->GetSnapshot()->GetPlugins() == snapshot->GetPlugins()) {
+    return conflictIndex;
+  }
+
+  conflictIndex = std::make_shared<const ConflictIndex>(snapshot);
+  std::atomic_store(&conflictIndex_, conflictIndex);
+
+  return conflictIndex;
 }
 
 std::vector<Message> Game::CheckInstallValidity(
     const std::shared_ptr<const PluginInterface>& plugin,
     const PluginMetadata& metadata) {
+  recordTraceEvent("Checking install validity", plugin->GetName());
+
   auto logger = getLogger();
 
-  if (logger) {
-    logger->trace(
-        "Checking that the current install is valid according to {}'s data.",
-        plugin->GetName());
-  }
+  LOOT_LOG_TRACE(
+      logger,
+      "Checking that the current install is valid according to {}'s data.",
+      plugin->GetName());
   std::vector<Message> messages;
   if (IsPluginActive(plugin->GetName())) {
     auto fileExists = [&](const std::string& file) {
@@ -167,11 +340,10 @@ std::vector<Message> Game::CheckInstallValidity(
     if (!hasFilterTag) {
       for (const auto& master : plugin->GetMasters()) {
         if (!fileExists(master)) {
-          if (logger) {
-            logger->error("\"{}\" requires \"{}\", but it is missing.",
-                          plugin->GetName(),
-                          master);
-          }
+          LOOT_LOG_ERROR(logger,
+                         "\"{}\" requires \"{}\", but it is missing.",
+                         plugin->GetName(),
+                         master);
           messages.push_back(
               PlainTextMessage(MessageType::error,
                                (boost::format(boost::locale::translate(
@@ -180,11 +352,10 @@ std::vector<Message> Game::CheckInstallValidity(
                                 master)
                                    .str()));
         } else if (!IsPluginActive(master)) {
-          if (logger) {
-            logger->error("\"{}\" requires \"{}\", but it is inactive.",
-                          plugin->GetName(),
-                          master);
-          }
+          LOOT_LOG_ERROR(logger,
+                         "\"{}\" requires \"{}\", but it is inactive.",
+                         plugin->GetName(),
+                         master);
           messages.push_back(
               PlainTextMessage(MessageType::error,
                                (boost::format(boost::locale::translate(
@@ -201,11 +372,10 @@ std::vector<Message> Game::CheckInstallValidity(
     for (const auto& req : metadata.GetRequirements()) {
       auto file = std::string(req.GetName());
       if (!fileExists(file)) {
-        if (logger) {
-          logger->error("\"{}\" requires \"{}\", but it is missing.",
-                        plugin->GetName(),
-                        file);
-        }
+        LOOT_LOG_ERROR(logger,
+                       "\"{}\" requires \"{}\", but it is missing.",
+                       plugin->GetName(),
+                       file);
         if (displayNamesWithMessages.count(req.GetDisplayName()) > 0) {
           continue;
         }
@@ -225,12 +395,11 @@ std::vector<Message> Game::CheckInstallValidity(
       auto file = std::string(inc.GetName());
       if (fileExists(file) &&
           (!hasPluginFileExtension(file) || IsPluginActive(file))) {
-        if (logger) {
-          logger->error(
-              "\"{}\" is incompatible with \"{}\", but both files are present.",
-              plugin->GetName(),
-              file);
-        }
+        LOOT_LOG_ERROR(
+            logger,
+            "\"{}\" is incompatible with \"{}\", but both files are present.",
+            plugin->GetName(),
+            file);
         if (displayNamesWithMessages.count(inc.GetDisplayName()) > 0) {
           continue;
         }
@@ -251,25 +420,23 @@ std::vector<Message> Game::CheckInstallValidity(
     for (const auto& masterName : plugin->GetMasters()) {
       auto master = GetPlugin(masterName);
       if (!master) {
-        if (logger) {
-          logger->info(
-              "Tried to get plugin object for master \"{}\" of \"{}\" but it "
-              "was not loaded.",
-              masterName,
-              plugin->GetName());
-        }
+        LOOT_LOG_INFO(
+            logger,
+            "Tried to get plugin object for master \"{}\" of \"{}\" but it "
+            "was not loaded.",
+            masterName,
+            plugin->GetName());
         continue;
       }
 
       if (!master->IsLightMaster() && !master->IsMaster()) {
-        if (logger) {
-          logger->error(
-              "\"{}\" is a light master and requires the non-master plugin "
-              "\"{}\". This can cause issues in-game, and sorting will fail "
-              "while this plugin is installed.",
-              plugin->GetName(),
-              masterName);
-        }
+        LOOT_LOG_ERROR(
+            logger,
+            "\"{}\" is a light master and requires the non-master plugin "
+            "\"{}\". This can cause issues in-game, and sorting will fail "
+            "while this plugin is installed.",
+            plugin->GetName(),
+            masterName);
         messages.push_back(PlainTextMessage(
             MessageType::error,
             (boost::format(boost::locale::translate(
@@ -283,13 +450,12 @@ std::vector<Message> Game::CheckInstallValidity(
   }
 
   if (plugin->IsLightMaster() && !plugin->IsValidAsLightMaster()) {
-    if (logger) {
-      logger->error(
-          "\"{}\" contains records that have FormIDs outside the valid range "
-          "for an ESL plugin. Using this plugin will cause irreversible damage "
-          "to your game saves.",
-          plugin->GetName());
-    }
+    LOOT_LOG_ERROR(
+        logger,
+        "\"{}\" contains records that have FormIDs outside the valid range "
+        "for an ESL plugin. Using this plugin will cause irreversible damage "
+        "to your game saves.",
+        plugin->GetName());
     messages.push_back(PlainTextMessage(
         MessageType::error,
         boost::locale::translate(
@@ -299,14 +465,13 @@ std::vector<Message> Game::CheckInstallValidity(
   }
 
   if (plugin->GetHeaderVersion() < MinimumHeaderVersion()) {
-    if (logger) {
-      logger->warn(
-          "\"{}\" has a header version of {}, which is less than the game's "
-          "minimum supported header version of {}.",
-          plugin->GetName(),
-          plugin->GetHeaderVersion(),
-          MinimumHeaderVersion());
-    }
+    LOOT_LOG_WARN(
+        logger,
+        "\"{}\" has a header version of {}, which is less than the game's "
+        "minimum supported header version of {}.",
+        plugin->GetName(),
+        plugin->GetHeaderVersion(),
+        MinimumHeaderVersion());
     messages.push_back(PlainTextMessage(
         MessageType::warn,
         (boost::format(boost::locale::translate(
@@ -318,7 +483,7 @@ std::vector<Message> Game::CheckInstallValidity(
 
   if (metadata.GetGroup().has_value()) {
     auto groupName = metadata.GetGroup().value();
-    auto groups = gameHandle_->GetDatabase()->GetGroups();
+    auto groups = GetDatabase()->GetGroups();
     auto groupIsUndefined =
         std::none_of(groups.cbegin(), groups.cend(), [&](const Group& group) {
           return group.GetName() == groupName;
@@ -335,6 +500,14 @@ std::vector<Message> Game::CheckInstallValidity(
     }
   }
 
+  auto cycles =
+      cyclicInteractionMembers_.find(NormalizeFilename(plugin->GetName()));
+  if (cycles != cyclicInteractionMembers_.end()) {
+    for (const auto& description : cycles->second) {
+      messages.push_back(Message(MessageType::error, description));
+    }
+  }
+
   // Also generate dirty messages.
   for (const auto& element : metadata.GetDirtyInfo()) {
     messages.push_back(ToMessage(element));
@@ -343,51 +516,130 @@ std::vector<Message> Game::CheckInstallValidity(
   return messages;
 }
 
-void Game::RedatePlugins() {
+std::vector<PluginRedate> Game::PlanPluginRedates() const {
   auto logger = getLogger();
 
   if (Type() != GameType::tes5 && Type() != GameType::tes5se) {
     if (logger) {
       logger->warn("Cannot redate plugins for game {}.", Name());
     }
-    return;
+    return {};
   }
 
   vector<string> loadorder = gameHandle_->GetLoadOrder();
-  if (!loadorder.empty()) {
-    std::filesystem::file_time_type lastTime =
-        std::filesystem::file_time_type::clock::time_point::min();
-    for (const auto& pluginName : loadorder) {
-      fs::path filepath = DataPath() / u8path(pluginName);
-      if (!fs::exists(filepath)) {
-        filepath += ".ghost";
-        if (!fs::exists(filepath)) {
-          continue;
-        }
-      }
+  if (loadorder.empty()) {
+    return {};
+  }
 
-      auto thisTime = fs::last_write_time(filepath);
-      if (thisTime >= lastTime) {
-        lastTime = thisTime;
+  // Get the timestamps of all the files in the data directory in one pass,
+  // rather than checking each plugin's paths separately.
+  struct FileTime {
+    fs::path path;
+    fs::file_time_type time;
+  };
+  std::unordered_map<std::string, FileTime> fileTimes;
+  for (const auto& entry : fs::directory_iterator(DataPath())) {
+    if (!entry.is_regular_file()) {
+      continue;
+    }
 
-        if (logger) {
-          logger->trace("No need to redate \"{}\".",
-                        filepath.filename().u8string());
-        }
-      } else {
-        lastTime += std::chrono::seconds(60);
-        fs::last_write_time(filepath,
-                            lastTime);  // Space timestamps by a minute.
+    auto filename = entry.path().filename().u8string();
+    auto isGhosted = boost::iends_with(filename, ".ghost");
+    if (isGhosted) {
+      filename.resize(filename.size() - std::strlen(".ghost"));
+    }
 
-        if (logger) {
-          logger->info("Redated \"{}\"", filepath.filename().u8string());
-        }
-      }
+    // A plugin that isn't ghosted takes precedence over a ghosted copy.
+    auto key = NormalizeFilename(filename);
+    if (isGhosted && fileTimes.count(key) > 0) {
+      continue;
+    }
+    fileTimes[key] = FileTime{entry.path(), entry.last_write_time()};
+  }
+
+  std::vector<PluginRedate> redates;
+  std::filesystem::file_time_type lastTime =
+      std::filesystem::file_time_type::clock::time_point::min();
+  for (const auto& pluginName : loadorder) {
+    auto fileTime = fileTimes.find(NormalizeFilename(pluginName));
+    if (fileTime == fileTimes.end()) {
+      continue;
     }
+
+    auto thisTime = fileTime->second.time;
+    if (thisTime >= lastTime) {
+      lastTime = thisTime;
+
+      LOOT_LOG_TRACE(logger,
+                     "No need to redate \"{}\".",
+                     fileTime->second.path.filename().u8string());
+    } else {
+      lastTime += std::chrono::seconds(60);  // Space timestamps by a minute.
+      redates.push_back(
+          PluginRedate{pluginName, fileTime->second.path, thisTime, lastTime});
+    }
+  }
+
+  return redates;
+}
+
+void Game::RedatePlugins() {
+  auto redates = PlanPluginRedates();
+  if (redates.empty()) {
+    return;
+  }
+
+  // Each file's timestamp is set independently, so large batches are split
+  // across a few threads.
+  static constexpr size_t MIN_BATCH_SIZE = 64;
+  static constexpr size_t MAX_THREADS = 4;
+  const size_t threadCount =
+      std::clamp<size_t>(std::thread::hardware_concurrency(), 1, MAX_THREADS);
+  const size_t batchSize = std::max(
+      MIN_BATCH_SIZE, (redates.size() + threadCount - 1) / threadCount);
+
+  std::vector<std::error_code> errors(redates.size());
+  auto redateBatch = [&](size_t begin, size_t end) {
+    for (auto i = begin; i < end; ++i) {
+      fs::last_write_time(redates[i].path, redates[i].newTime, errors[i]);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t begin = batchSize; begin < redates.size(); begin += batchSize) {
+    threads.emplace_back(
+        redateBatch, begin, std::min(begin + batchSize, redates.size()));
+  }
+  redateBatch(0, std::min(batchSize, redates.size()));
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto logger = getLogger();
+  size_t failureCount = 0;
+  for (size_t i = 0; i < redates.size(); ++i) {
+    if (errors[i]) {
+      ++failureCount;
+      LOOT_LOG_ERROR(logger,
+                     "Failed to redate \"{}\": {}",
+                     redates[i].path.filename().u8string(),
+                     errors[i].message());
+    } else {
+      LOOT_LOG_INFO(logger,
+                    "Redated \"{}\"",
+                    redates[i].path.filename().u8string());
+    }
+  }
+
+  if (failureCount > 0) {
+    throw FileAccessError("Failed to redate " + std::to_string(failureCount) +
+                          " plugins, see the log for details.");
   }
 }
 
 void Game::LoadAllInstalledPlugins(bool headersOnly) {
+  recordTraceEvent("Loading plugins", headersOnly ? "headers only" : "fully");
+
   try {
     gameHandle_->LoadCurrentLoadOrderState();
   } catch (std::exception& e) {
@@ -403,24 +655,149 @@ void Game::LoadAllInstalledPlugins(bool headersOnly) {
   }
 
   auto installedPluginNames = GetInstalledPluginNames();
-  gameHandle_->LoadPlugins(installedPluginNames, headersOnly);
+  {
+    TraceSpan span("LoadPlugins", headersOnly ? "headers only" : "fully");
+    gameHandle_->LoadPlugins(installedPluginNames, headersOnly);
+  }
+
+  RebuildPluginSnapshot();
 
   // Check if any plugins have been removed.
   std::vector<std::string> loadedPluginNames;
-  for (auto plugin : gameHandle_->GetLoadedPlugins()) {
+  for (const auto& plugin : GetPluginSnapshot()->GetPlugins()) {
     loadedPluginNames.push_back(plugin->GetName());
   }
 
   AppendMessages(
       CheckForRemovedPlugins(installedPluginNames, loadedPluginNames));
 
+  loadedPluginFiles_.clear();
+  for (const auto& pluginName : installedPluginNames) {
+    loadedPluginFiles_.push_back(GetPluginFileState(pluginName));
+  }
+
   pluginsFullyLoaded_ = !headersOnly;
+
+  if (pluginsFullyLoaded_) {
+    // Check for conflicts now, so that filtering by them doesn't need to.
+    TraceSpan span("BuildConflictIndex",
+                   isTracingEnabled() ? FolderName() : std::string());
+    std::atomic_store(
+        &conflictIndex_,
+        std::make_shared<const ConflictIndex>(GetPluginSnapshot()));
+
+    // Record the CRCs that libloot calculated, so that they're available
+    // after later loads that only read plugin headers.
+    if (crcCache_) {
+      for (const auto& plugin : GetPluginSnapshot()->GetPlugins()) {
+        auto crc = plugin->GetCRC();
+        if (crc.has_value()) {
+          crcCache_->Insert(GetPluginPath(plugin->GetName()), crc.value());
+        }
+      }
+    }
+  }
+}
+
+bool Game::RefreshLoadOrderState() {
+  try {
+    gameHandle_->LoadCurrentLoadOrderState();
+  } catch (std::exception& e) {
+    auto logger = getLogger();
+    if (logger) {
+      logger->error("Failed to load current load order. Details: {}", e.what());
+    }
+    // Loading the plugins again will report the error.
+    return true;
+  }
+
+  auto installedPluginNames = GetInstalledPluginNames();
+  if (installedPluginNames.size() != loadedPluginFiles_.size()) {
+    return true;
+  }
+
+  // Active states are not compared, as they're read with the load order.
+  for (size_t i = 0; i < installedPluginNames.size(); ++i) {
+    auto state = GetPluginFileState(installedPluginNames[i]);
+    const auto& loadedState = loadedPluginFiles_[i];
+    if (state.name != loadedState.name || state.size != loadedState.size ||
+        state.writeTime != loadedState.writeTime) {
+      return true;
+    }
+  }
+
+  // Update the snapshot's active states.
+  RebuildPluginSnapshot();
+
+  return false;
 }
 
 bool Game::ArePluginsFullyLoaded() const { return pluginsFullyLoaded_; }
 
+std::optional<uint32_t> Game::FindPluginCrc(
+    const PluginInterface& plugin) const {
+  auto crc = plugin.GetCRC();
+  if (crc.has_value() || !crcCache_) {
+    return crc;
+  }
+
+  return crcCache_->Find(GetPluginPath(plugin.GetName()));
+}
+
+void Game::CachePluginCrcsInBackground() {
+  if (!crcCache_ ||
+      (crcCalculation_.valid() &&
+       crcCalculation_.wait_for(std::chrono::seconds(0)) !=
+           std::future_status::ready)) {
+    return;
+  }
+
+  std::vector<fs::path> pluginPaths;
+  for (const auto& plugin : GetPlugins()) {
+    auto pluginPath = GetPluginPath(plugin->GetName());
+    if (!plugin->GetCRC().has_value() &&
+        !crcCache_->Find(pluginPath).has_value()) {
+      pluginPaths.push_back(pluginPath);
+    }
+  }
+
+  if (pluginPaths.empty()) {
+    return;
+  }
+
+  // Hold the cache weakly, so that the calculation stops once every copy of
+  // the game has been destroyed instead of delaying LOOT's exit.
+  crcCalculation_ =
+      std::async(std::launch::async,
+                 [weakCache = std::weak_ptr<CrcCache>(crcCache_),
+                  pluginPaths]() {
+                   TraceSpan span("CachePluginCrcs");
+                   for (const auto& pluginPath : pluginPaths) {
+                     auto crcCache = weakCache.lock();
+                     if (!crcCache) {
+                       return;
+                     }
+
+                     try {
+                       crcCache->GetCrc(pluginPath);
+                     } catch (std::exception& e) {
+                       auto logger = getLogger();
+                       if (logger) {
+                         logger->error(
+                             "Failed to calculate the CRC of {}. Details: {}",
+                             pluginPath.u8string(),
+                             e.what());
+                       }
+                     }
+                   }
+                 })
+          .share();
+}
+
 fs::path Game::MasterlistPath() const {
-  return lootDataPath_ / u8path(FolderName()) / "masterlist.yaml";
+  return lootDataPath_ / "masterlists" /
+         u8path(GetMasterlistRepositoryFolderName(RepoURL(), RepoBranch())) /
+         "masterlist.yaml";
 }
 
 fs::path Game::UserlistPath() const {
@@ -431,16 +808,109 @@ fs::path Game::PluginsTxtPath() const {
   return lootDataPath_.parent_path() / u8path(FolderName()) / "plugins.txt";
 }
 
+std::filesystem::path Game::LoadOrderProfilesPath() const {
+  return lootDataPath_ / u8path(FolderName()) / "profiles.toml";
+}
+
 std::vector<std::string> Game::GetLoadOrder() const {
   return gameHandle_->GetLoadOrder();
 }
 
 void Game::SetLoadOrder(const std::vector<std::string>& loadOrder) {
-  BackupLoadOrder(GetLoadOrder(), lootDataPath_ / u8path(FolderName()));
+  auto currentLoadOrder = GetLoadOrder();
+  // Recording an unchanged load order would push an older one out of the
+  // journal without giving anything new to restore.
+  if (loadOrderJournal_ && loadOrder != currentLoadOrder) {
+    loadOrderJournal_->Record(currentLoadOrder);
+  }
   gameHandle_->SetLoadOrder(loadOrder);
 }
 
+size_t Game::CountRecordedLoadOrders() const {
+  return loadOrderJournal_ ? loadOrderJournal_->CountLoadOrders() : 0;
+}
+
+std::vector<std::string> Game::GetRecordedLoadOrder(size_t age) const {
+  if (!loadOrderJournal_) {
+    throw std::out_of_range("No load orders have been recorded");
+  }
+
+  return loadOrderJournal_->GetLoadOrder(age);
+}
+
+std::vector<std::string> Game::RestoreLoadOrder(size_t age) {
+  auto logger = getLogger();
+  if (logger) {
+    logger->info("Restoring the load order recorded {} changes ago.", age + 1);
+  }
+
+  auto loadOrder = FitLoadOrder(GetRecordedLoadOrder(age), GetLoadOrder());
+  SetLoadOrder(loadOrder);
+
+  return loadOrder;
+}
+
+std::vector<std::string> Game::GetLoadOrderProfileNames() const {
+  return LoadLoadOrderProfiles().GetNames();
+}
+
+void Game::SaveLoadOrderProfile(const std::string& name) {
+  auto logger = getLogger();
+  if (logger) {
+    logger->info("Saving the current load order as the profile \"{}\".",
+                 name);
+  }
+
+  if (lootDataPath_.empty()) {
+    throw std::runtime_error(
+        "Load order profiles can't be saved without a LOOT data folder");
+  }
+
+  auto profiles = LoadLoadOrderProfiles();
+  profiles.SetLoadOrder(name, GetLoadOrder());
+  profiles.Save(LoadOrderProfilesPath());
+}
+
+std::vector<std::string> Game::ApplyLoadOrderProfile(const std::string& name) {
+  auto logger = getLogger();
+  if (logger) {
+    logger->info("Applying the load order profile \"{}\".", name);
+  }
+
+  auto loadOrder = FitLoadOrder(GetLoadOrderProfile(name), GetLoadOrder());
+  SetLoadOrder(loadOrder);
+
+  return loadOrder;
+}
+
+bool Game::DeleteLoadOrderProfile(const std::string& name) {
+  auto profiles = LoadLoadOrderProfiles();
+  if (!profiles.Remove(name)) {
+    return false;
+  }
+
+  profiles.Save(LoadOrderProfilesPath());
+  return true;
+}
+
+LoadOrderDiff Game::DiffLoadOrderProfile(
+    const std::string& name,
+    const std::optional<std::string>& baseName) const {
+  auto baseLoadOrder = baseName.has_value()
+                           ? GetLoadOrderProfile(baseName.value())
+                           : GetLoadOrder();
+
+  return DiffLoadOrders(baseLoadOrder, GetLoadOrderProfile(name));
+}
+
 bool Game::IsPluginActive(const std::string& pluginName) const {
+  auto snapshot = GetPluginSnapshot();
+  auto index = snapshot->GetIndex(pluginName);
+  if (index.has_value()) {
+    return snapshot->IsActive(index.value());
+  }
+
+  // The plugin isn't loaded, but may still be listed as active.
   return gameHandle_->IsPluginActive(pluginName);
 }
 
@@ -454,16 +924,22 @@ std::optional<short> Game::GetActiveLoadOrderIndex(
   if (!IsPluginActive(plugin->GetName()))
     return std::nullopt;
 
+  auto snapshot = GetPluginSnapshot();
+  auto pluginIndex = snapshot->GetIndex(plugin->GetName());
+  bool isLightMaster = plugin->IsLightMaster();
+
   short numberOfActivePlugins = 0;
   for (const std::string& otherPluginName : loadOrder) {
-    if (CompareFilenames(plugin->GetName(), otherPluginName) == 0) {
+    auto otherIndex = snapshot->GetIndex(otherPluginName);
+    if (pluginIndex.has_value() ? otherIndex == pluginIndex
+                                : CompareFilenames(plugin->GetName(),
+                                                   otherPluginName) == 0) {
       return numberOfActivePlugins;
     }
 
-    auto otherPlugin = GetPlugin(otherPluginName);
-    if (otherPlugin &&
-        plugin->IsLightMaster() == otherPlugin->IsLightMaster() &&
-        IsPluginActive(otherPluginName)) {
+    if (otherIndex.has_value() &&
+        isLightMaster == snapshot->IsLightMaster(otherIndex.value()) &&
+        snapshot->IsActive(otherIndex.value())) {
       ++numberOfActivePlugins;
     }
   }
@@ -472,10 +948,14 @@ std::optional<short> Game::GetActiveLoadOrderIndex(
 }
 
 std::vector<std::string> Game::SortPlugins() {
+  recordTraceEvent("Sorting plugins", FolderName());
+
   auto logger = getLogger();
 
   try {
     gameHandle_->LoadCurrentLoadOrderState();
+    // Plugins' active states may have changed.
+    RebuildPluginSnapshot();
   } catch (std::exception& e) {
     if (logger) {
       logger->error("Failed to load current load order. Details: {}", e.what());
@@ -493,30 +973,28 @@ std::vector<std::string> Game::SortPlugins() {
     // state that has been changed by sorting.
     ClearMessages();
 
-    auto currentLoadOrder = gameHandle_->GetLoadOrder();
+    const auto& result = GetSortResult(gameHandle_->GetLoadOrder());
 
-    sortedPlugins = gameHandle_->SortPlugins(currentLoadOrder);
+    sortedPlugins = result.sortedPlugins;
+    AppendMessages(result.messages);
 
-    AppendMessages(CheckForRemovedPlugins(currentLoadOrder, sortedPlugins));
+    // Sorting succeeded, so there are no cyclic interactions.
+    ClearCyclicInteractions();
 
     IncrementLoadOrderSortCount();
   } catch (CyclicInteractionError& e) {
     if (logger) {
       logger->error("Failed to sort plugins. Details: {}", e.what());
     }
-    AppendMessage(Message(
-        MessageType::error,
-        (boost::format(boost::locale::translate(
-             "Cyclic interaction detected between \"%1%\" and \"%2%\": %3%")) %
-         EscapeMarkdownSpecialChars(e.GetCycle().front().GetName()) %
-         EscapeMarkdownSpecialChars(e.GetCycle().back().GetName()) %
-         DescribeCycle(e.GetCycle()))
-            .str()));
+    logRecentTraceEvents("Sorting failed");
+    AppendMessage(
+        Message(MessageType::error, DescribeCyclicInteraction(e.GetCycle())));
     sortedPlugins.clear();
   } catch (UndefinedGroupError& e) {
     if (logger) {
       logger->error("Failed to sort plugins. Details: {}", e.what());
     }
+    logRecentTraceEvents("Sorting failed");
     AppendMessage(PlainTextMessage(MessageType::error,
                                    (boost::format(boost::locale::translate(
                                         "The group \"%1%\" does not exist.")) %
@@ -527,12 +1005,145 @@ std::vector<std::string> Game::SortPlugins() {
     if (logger) {
       logger->error("Failed to sort plugins. Details: {}", e.what());
     }
+    logRecentTraceEvents("Sorting failed");
     sortedPlugins.clear();
   }
 
   return sortedPlugins;
 }
 
+void Game::SortPluginsInBackground(std::function<void(bool)> onSorted) {
+  CancelBackgroundSort();
+
+  auto logger = getLogger();
+  if (!loadedMasterlistWriteTime_.has_value()) {
+    // The sort's game handle must load the same metadata as this game's.
+    if (logger) {
+      logger->debug("Metadata hasn't been loaded, not sorting in background.");
+    }
+    return;
+  }
+
+  std::vector<std::string> loadOrder;
+  try {
+    gameHandle_->LoadCurrentLoadOrderState();
+    // Plugins' active states may have changed.
+    RebuildPluginSnapshot();
+    loadOrder = gameHandle_->GetLoadOrder();
+
+    // The sort's game handle reads user metadata from the userlist.
+    FlushUserMetadata();
+  } catch (std::exception& e) {
+    // Any error will be reported if the user sorts.
+    if (logger) {
+      logger->debug("Failed to prepare background sort. Details: {}",
+                    e.what());
+    }
+    return;
+  }
+
+  std::filesystem::path userlistPath;
+  if (std::filesystem::exists(UserlistPath())) {
+    userlistPath = UserlistPath();
+  }
+
+  auto isCancelled = std::make_shared<std::atomic<bool>>(false);
+  auto fingerprint = GetSortFingerprint(loadOrder);
+
+  auto sortedPlugins =
+      std::async(
+          std::launch::async,
+          [type = Type(),
+           gamePath = GamePath(),
+           gameLocalPath = GameLocalPath(),
+           masterFile = Master(),
+           folderName = FolderName(),
+           masterlistPath = MasterlistPath(),
+           userlistPath,
+           loadedMasterlistWriteTime = loadedMasterlistWriteTime_.value(),
+           mutex = userMetadataMutex_,
+           loadOrder,
+           isCancelled,
+           onSorted]() -> std::optional<std::vector<std::string>> {
+            auto logger = getLogger();
+            try {
+              auto gameHandle =
+                  CreateGameHandle(type, gamePath, gameLocalPath);
+              gameHandle->IdentifyMainMasterFile(masterFile);
+
+              {
+                // Hold the masterlist and userlist still while they're parsed.
+                auto& repository =
+                    GetSharedMasterlistRepository(masterlistPath);
+                lock_guard<std::mutex> repositoryGuard(repository.mutex);
+                lock_guard<std::mutex> userMetadataGuard(*mutex);
+
+                std::error_code ec;
+                auto masterlistWriteTime =
+                    fs::last_write_time(masterlistPath, ec);
+                if (ec) {
+                  masterlistWriteTime = fs::file_time_type::min();
+                }
+
+                if (*isCancelled ||
+                    masterlistWriteTime != loadedMasterlistWriteTime) {
+                  // The result wouldn't match the game's loaded metadata.
+                  return std::nullopt;
+                }
+
+                TraceSpan span("LoadLists");
+                gameHandle->GetDatabase()->LoadLists(
+                    ec ? std::filesystem::path() : masterlistPath,
+                    userlistPath);
+              }
+
+              if (*isCancelled) {
+                return std::nullopt;
+              }
+              gameHandle->LoadCurrentLoadOrderState();
+
+              if (*isCancelled) {
+                return std::nullopt;
+              }
+              auto sortedPlugins = [&]() {
+                TraceSpan span(
+                    "SortPlugins",
+                    isTracingEnabled() ? folderName : std::string());
+                return gameHandle->SortPlugins(loadOrder);
+              }();
+
+              if (logger) {
+                logger->debug("Background sort finished.");
+              }
+              if (onSorted && !*isCancelled) {
+                onSorted(sortedPlugins == loadOrder);
+              }
+
+              return sortedPlugins;
+            } catch (std::exception& e) {
+              // Any error will be reported if the user sorts.
+              if (logger) {
+                logger->debug("Background sort failed. Details: {}",
+                              e.what());
+              }
+              return std::nullopt;
+            }
+          })
+          .share();
+
+  std::atomic_store(&backgroundSort_,
+                    std::shared_ptr<const BackgroundSort>(
+                        std::make_shared<BackgroundSort>(BackgroundSort{
+                            fingerprint, isCancelled, sortedPlugins})));
+}
+
+void Game::CancelBackgroundSort() {
+  auto backgroundSort = std::atomic_load(&backgroundSort_);
+  if (backgroundSort) {
+    *backgroundSort->isCancelled = true;
+  }
+}
+
 void Game::IncrementLoadOrderSortCount() {
   lock_guard<mutex> guard(mutex_);
 
@@ -546,9 +1157,99 @@ void Game::DecrementLoadOrderSortCount() {
     --loadOrderSortCount_;
 }
 
+size_t Game::CountErrorMessages() {
+  auto logger = getLogger();
+  auto isError = [](const Message& message) {
+    return message.GetType() == MessageType::error;
+  };
+
+  auto messages = GetMessages();
+  size_t errorCount = std::count_if(begin(messages), end(messages), isError);
+
+  for (const auto& plugin : GetPlugins()) {
+    // A condition that can't be evaluated is displayed as an error.
+    PluginMetadata metadata(plugin->GetName());
+    try {
+      auto userMetadata = GetUserMetadata(plugin->GetName(), true);
+      if (userMetadata.has_value()) {
+        metadata.MergeMetadata(userMetadata.value());
+      }
+    } catch (std::exception& e) {
+      if (logger) {
+        logger->error(
+            "\"{}\"'s user metadata contains a condition that could not be "
+            "evaluated. Details: {}",
+            plugin->GetName(),
+            e.what());
+      }
+      ++errorCount;
+    }
+
+    try {
+      auto masterlistMetadata = GetMasterlistMetadata(plugin->GetName(), true);
+      if (masterlistMetadata.has_value()) {
+        metadata.MergeMetadata(masterlistMetadata.value());
+      }
+    } catch (std::exception& e) {
+      if (logger) {
+        logger->error(
+            "\"{}\"'s masterlist metadata contains a condition that could "
+            "not be evaluated. Details: {}",
+            plugin->GetName(),
+            e.what());
+      }
+      ++errorCount;
+    }
+
+    messages = metadata.GetMessages();
+    auto validityMessages = CheckInstallValidity(plugin, metadata);
+    messages.insert(
+        end(messages), begin(validityMessages), end(validityMessages));
+    errorCount += std::count_if(begin(messages), end(messages), isError);
+  }
+
+  return errorCount;
+}
+
 std::vector<Message> Game::GetMessages() const {
-  std::vector<Message> output(
-      gameHandle_->GetDatabase()->GetGeneralMessages(true));
+  std::vector<Message> output(GetDatabase()->GetGeneralMessages(true));
+
+  auto error = metadataLoad_.valid() ? metadataLoad_.get() : std::nullopt;
+  if (error.has_value()) {
+    output.push_back(Message(
+        MessageType::error,
+        (boost::format(boost::locale::translate(
+             "An error occurred while parsing the metadata list(s): "
+             "%1%.\n\nTry updating your masterlist to resolve the error. If "
+             "the error is with your user metadata, this probably happened "
+             "because an update to LOOT changed its metadata syntax support. "
+             "Your user metadata will have to be updated manually.\n\nTo do "
+             "so, use the 'Open Debug Log Location' in LOOT's main menu to "
+             "open its data folder, then open your 'userlist.yaml' file in the "
+             "relevant game folder. You can then edit the metadata it contains "
+             "with reference to the documentation, which is accessible through "
+             "LOOT's main menu.\n\nYou can also seek support on LOOT's forum "
+             "thread, which is linked to on [LOOT's "
+             "website](https://loot.github.io/).")) %
+         EscapeMarkdownSpecialChars(error.value()))
+            .str()));
+  }
+
+  AppendGameMessages(output);
+
+  return output;
+}
+
+std::vector<Message> Game::GetMessages(
+    const MasterlistSnapshot& snapshot) const {
+  auto output = snapshot.GetGeneralMessages();
+
+  AppendGameMessages(output);
+
+  return output;
+}
+
+void Game::AppendGameMessages(std::vector<Message>& output) const {
   output.insert(end(output), begin(messages_), end(messages_));
 
   if (loadOrderSortCount_ == 0)
@@ -559,9 +1260,10 @@ std::vector<Message> Game::GetMessages() const {
 
   size_t activeNormalPluginsCount = 0;
   bool hasActiveEsl = false;
-  for (const auto& plugin : GetPlugins()) {
-    if (IsPluginActive(plugin->GetName())) {
-      if (plugin->IsLightMaster()) {
+  auto snapshot = GetPluginSnapshot();
+  for (size_t i = 0; i < snapshot->Size(); ++i) {
+    if (snapshot->IsActive(i)) {
+      if (snapshot->IsLightMaster(i)) {
         hasActiveEsl = true;
       } else {
         ++activeNormalPluginsCount;
@@ -583,8 +1285,6 @@ std::vector<Message> Game::GetMessages() const {
             "the FE load order index. Deactivate a normal plugin or all your "
             "light masters to avoid potential issues.")));
   }
-
-  return output;
 }
 
 void Game::AppendMessage(const Message& message) {
@@ -600,10 +1300,74 @@ void Game::ClearMessages() {
 }
 
 bool Game::UpdateMasterlist() {
-  bool wasUpdated = gameHandle_->GetDatabase()->UpdateMasterlist(
-      MasterlistPath(), RepoURL(), RepoBranch());
-  if (wasUpdated && !gameHandle_->GetDatabase()->IsLatestMasterlist(
-                        MasterlistPath(), RepoBranch())) {
+  recordTraceEvent("Updating masterlist", FolderName());
+
+  auto& repository = GetSharedMasterlistRepository(MasterlistPath());
+  auto fetchCount = repository.fetchCount.load();
+
+  // Let any fetch that's already running finish, so that it can be reused.
+  if (masterlistFetch_.valid()) {
+    masterlistFetch_.wait();
+  }
+
+  lock_guard<mutex> guard(repository.mutex);
+
+  if (repository.fetchCount != fetchCount) {
+    // Another fetch of the masterlist, possibly for another game that shares
+    // it, completed while this one was waiting, so use its result.
+    auto logger = getLogger();
+    if (logger) {
+      logger->debug(
+          "The masterlist at {} was fetched while waiting to update it, "
+          "skipping fetch.",
+          MasterlistPath().u8string());
+    }
+
+    return LoadMasterlistUpdate();
+  }
+
+  bool wasUpdated = false;
+  {
+    TraceSpan span("UpdateMasterlist",
+                   isTracingEnabled() ? FolderName() : std::string());
+    wasUpdated = GetDatabase()->UpdateMasterlist(
+        MasterlistPath(), RepoURL(), RepoBranch());
+  }
+  ++repository.fetchCount;
+
+  if (!wasUpdated) {
+    // Another game that shares this masterlist may have updated it since
+    // this game last loaded it.
+    return LoadMasterlistUpdate();
+  }
+
+  // libloot has parsed the updated masterlist.
+  loadedMasterlistWriteTime_ = GetMasterlistWriteTime();
+  IncrementMetadataGeneration();
+  interactionGraph_.reset();
+  masterlistSnapshotNeedsUpdate_ = true;
+  AppendMasterlistFallbackMessage();
+
+  return true;
+}
+
+bool Game::LoadMasterlistUpdate() {
+  if (masterlistFetch_.valid()) {
+    masterlistFetch_.wait();
+  }
+
+  if (!HasMasterlistChangedSinceLoad()) {
+    return false;
+  }
+
+  LoadMetadata();
+  AppendMasterlistFallbackMessage();
+
+  return true;
+}
+
+void Game::AppendMasterlistFallbackMessage() {
+  if (!IsLatestMasterlist()) {
     AppendMessage(PlainTextMessage(
         MessageType::error,
         boost::locale::translate(
@@ -611,8 +1375,104 @@ bool Game::UpdateMasterlist() {
             "using the most recent valid revision instead. Syntax errors are "
             "usually minor and fixed within hours.")));
   }
+}
+
+void Game::UpdateMasterlistInBackground(std::function<void()> onUpdated) {
+  if (masterlistFetch_.valid() &&
+      masterlistFetch_.wait_for(std::chrono::seconds(0)) !=
+          std::future_status::ready) {
+    return;
+  }
 
-  return wasUpdated;
+  masterlistFetch_ =
+      std::async(
+          std::launch::async,
+          [type = Type(),
+           gamePath = GamePath(),
+           gameLocalPath = GameLocalPath(),
+           masterlistPath = MasterlistPath(),
+           repoUrl = RepoURL(),
+           repoBranch = RepoBranch(),
+           metadataLoad = metadataLoad_,
+           onUpdated]() {
+            auto& repository = GetSharedMasterlistRepository(masterlistPath);
+            auto fetchCount = repository.fetchCount.load();
+
+            // Don't change the masterlist while it's being parsed.
+            if (metadataLoad.valid()) {
+              metadataLoad.wait();
+            }
+
+            auto logger = getLogger();
+            bool wasUpdated = false;
+            try {
+              lock_guard<mutex> guard(repository.mutex);
+
+              if (repository.fetchCount != fetchCount) {
+                // Another fetch has just completed, and whatever started it
+                // will load its result.
+                return;
+              }
+
+              // Use a separate game handle so that the game's loaded metadata
+              // is left alone until UpdateMasterlist() is called.
+              auto gameHandle = CreateGameHandle(type, gamePath, gameLocalPath);
+              TraceSpan span("UpdateMasterlist",
+                             isTracingEnabled() ? masterlistPath.u8string()
+                                                : std::string());
+              wasUpdated = gameHandle->GetDatabase()->UpdateMasterlist(
+                  masterlistPath, repoUrl, repoBranch);
+              ++repository.fetchCount;
+            } catch (std::exception& e) {
+              // UpdateMasterlist() will try again and report the error.
+              if (logger) {
+                logger->error(
+                    "Failed to update the masterlist in the background. "
+                    "Details: {}",
+                    e.what());
+              }
+            }
+
+            if (logger) {
+              logger->debug(
+                  "Background masterlist update finished, updated: {}",
+                  wasUpdated);
+            }
+            if (wasUpdated && onUpdated) {
+              onUpdated();
+            }
+          })
+          .share();
+}
+
+MasterlistFetch Game::FetchMasterlist() const {
+  auto& repository = GetSharedMasterlistRepository(MasterlistPath());
+  lock_guard<mutex> guard(repository.mutex);
+
+  auto gameHandle = CreateGameHandle(Type(), GamePath(), GameLocalPath());
+  auto database = gameHandle->GetDatabase();
+
+  MasterlistFetch fetch;
+  try {
+    fetch.previousRevisionId =
+        database->GetMasterlistRevision(MasterlistPath(), true).revision_id;
+  } catch (FileAccessError&) {
+    // There's no masterlist yet.
+  } catch (GitStateError&) {
+    // The masterlist isn't in a Git repository yet.
+  }
+
+  {
+    TraceSpan span("UpdateMasterlist",
+                   isTracingEnabled() ? FolderName() : std::string());
+    database->UpdateMasterlist(MasterlistPath(), RepoURL(), RepoBranch());
+  }
+  ++repository.fetchCount;
+
+  fetch.masterlist = database->GetMasterlistRevision(MasterlistPath(), true);
+  fetch.isLatest = database->IsLatestMasterlist(MasterlistPath(), RepoBranch());
+
+  return fetch;
 }
 
 MasterlistInfo Game::GetMasterlistInfo() const {
@@ -620,9 +1480,26 @@ MasterlistInfo Game::GetMasterlistInfo() const {
                                                            true);
 }
 
+bool Game::IsLatestMasterlist() const {
+  return gameHandle_->GetDatabase()->IsLatestMasterlist(MasterlistPath(),
+                                                        RepoBranch());
+}
+
 void Game::LoadMetadata() {
+  LoadMetadataInBackground();
+  WaitForMetadata();
+}
+
+void Game::LoadMetadataInBackground() {
+  recordTraceEvent("Loading metadata", FolderName());
+
   auto logger = getLogger();
 
+  // Make sure that the userlist isn't read while user metadata is waiting to
+  // be written to it, and that loads don't overlap.
+  FlushUserMetadata();
+  WaitForMetadata();
+
   std::filesystem::path masterlistPath;
   std::filesystem::path userlistPath;
   if (std::filesystem::exists(MasterlistPath())) {
@@ -639,89 +1516,299 @@ void Game::LoadMetadata() {
     userlistPath = UserlistPath();
   }
 
+  loadedMasterlistWriteTime_ = GetMasterlistWriteTime();
+  IncrementMetadataGeneration();
+  interactionGraph_.reset();
+  ClearCyclicInteractions();
+  masterlistSnapshotNeedsUpdate_ = true;
+
   if (logger) {
-    logger->debug("Parsing metadata list(s).");
+    logger->debug("Parsing metadata list(s) in the background.");
+  }
+  metadataLoad_ =
+      std::async(std::launch::async,
+                 [gameHandle = gameHandle_,
+                  masterlistPath,
+                  userlistPath,
+                  mutex = userMetadataMutex_]() -> std::optional<std::string> {
+                   try {
+                     std::lock_guard<std::mutex> guard(*mutex);
+                     TraceSpan span("LoadLists");
+                     gameHandle->GetDatabase()->LoadLists(masterlistPath,
+                                                          userlistPath);
+                     return std::nullopt;
+                   } catch (std::exception& e) {
+                     auto logger = getLogger();
+                     if (logger) {
+                       logger->error(
+                           "An error occurred while parsing the metadata "
+                           "list(s): {}",
+                           e.what());
+                     }
+                     return e.what();
+                   }
+                 })
+          .share();
+}
+
+void Game::WaitForMetadata() const {
+  if (metadataLoad_.valid()) {
+    metadataLoad_.wait();
   }
+}
+
+std::optional<MasterlistSnapshot> Game::GetMasterlistSnapshot() const {
+  if (lootDataPath_.empty() || !std::filesystem::exists(MasterlistPath())) {
+    return std::nullopt;
+  }
+
+  auto snapshot = MasterlistSnapshot::Load(MasterlistSnapshotPath());
+  if (!snapshot.has_value() ||
+      snapshot.value().GetMasterlistHash() !=
+          HashMasterlist(MasterlistPath())) {
+    return std::nullopt;
+  }
+
+  return snapshot;
+}
+
+void Game::UpdateMasterlistSnapshot() {
+  if (!masterlistSnapshotNeedsUpdate_ || lootDataPath_.empty() ||
+      !std::filesystem::exists(MasterlistPath())) {
+    return;
+  }
+
+  // Don't hash the masterlist while it's being updated, as the snapshot could
+  // then be keyed to an update that hasn't been loaded yet.
+  auto& repository = GetSharedMasterlistRepository(MasterlistPath());
+  std::unique_lock<mutex> repositoryLock(repository.mutex, std::try_to_lock);
+  if (!repositoryLock.owns_lock() || HasMasterlistChangedSinceLoad()) {
+    return;
+  }
+
+  auto logger = getLogger();
+  if (logger) {
+    logger->debug("Updating the masterlist snapshot for game: {}", Name());
+  }
+
+  auto database = GetDatabase();
+  MasterlistSnapshot snapshot(HashMasterlist(MasterlistPath()));
+  repositoryLock.unlock();
+  snapshot.SetGeneralMessages(database->GetGeneralMessages(true));
+  snapshot.SetGroups(database->GetGroups(false));
+  snapshot.SetKnownBashTags(database->GetKnownBashTags());
+
+  for (const auto& plugin : GetPlugins()) {
+    try {
+      auto metadata =
+          database->GetPluginMetadata(plugin->GetName(), false, true);
+      if (metadata.has_value()) {
+        snapshot.AddPluginMetadata(metadata.value());
+      }
+    } catch (std::exception& e) {
+      // The plugin's metadata will only be shown once libloot has loaded it.
+      if (logger) {
+        logger->warn(
+            "Leaving the metadata for \"{}\" out of the masterlist snapshot: "
+            "{}",
+            plugin->GetName(),
+            e.what());
+      }
+    }
+  }
+
   try {
-    gameHandle_->GetDatabase()->LoadLists(masterlistPath, userlistPath);
+    snapshot.Save(MasterlistSnapshotPath());
+    masterlistSnapshotNeedsUpdate_ = false;
   } catch (std::exception& e) {
     if (logger) {
-      logger->error("An error occurred while parsing the metadata list(s): {}",
+      logger->error("Failed to save the masterlist snapshot. Details: {}",
                     e.what());
     }
-    AppendMessage(Message(
-        MessageType::error,
-        (boost::format(boost::locale::translate(
-             "An error occurred while parsing the metadata list(s): "
-             "%1%.\n\nTry updating your masterlist to resolve the error. If "
-             "the error is with your user metadata, this probably happened "
-             "because an update to LOOT changed its metadata syntax support. "
-             "Your user metadata will have to be updated manually.\n\nTo do "
-             "so, use the 'Open Debug Log Location' in LOOT's main menu to "
-             "open its data folder, then open your 'userlist.yaml' file in the "
-             "relevant game folder. You can then edit the metadata it contains "
-             "with reference to the documentation, which is accessible through "
-             "LOOT's main menu.\n\nYou can also seek support on LOOT's forum "
-             "thread, which is linked to on [LOOT's "
-             "website](https://loot.github.io/).")) %
-         EscapeMarkdownSpecialChars(e.what()))
-            .str()));
   }
 }
 
 std::vector<std::string> Game::GetKnownBashTags() const {
-  return gameHandle_->GetDatabase()->GetKnownBashTags();
+  return GetDatabase()->GetKnownBashTags();
 }
 
 std::vector<Group> Game::GetMasterlistGroups() const {
-  return gameHandle_->GetDatabase()->GetGroups(false);
+  return GetDatabase()->GetGroups(false);
 }
 
 std::vector<Group> Game::GetUserGroups() const {
-  return gameHandle_->GetDatabase()->GetUserGroups();
+  return GetDatabase()->GetUserGroups();
 }
 
 std::optional<PluginMetadata> Game::GetMasterlistMetadata(
     const std::string& pluginName,
     bool evaluateConditions) const {
-  return gameHandle_->GetDatabase()->GetPluginMetadata(
+  TraceSpan span("GetPluginMetadata", pluginName);
+  return GetDatabase()->GetPluginMetadata(
       pluginName, false, evaluateConditions);
 }
 
 std::optional<PluginMetadata> Game::GetUserMetadata(
     const std::string& pluginName,
     bool evaluateConditions) const {
-  return gameHandle_->GetDatabase()->GetPluginUserMetadata(pluginName,
-                                                           evaluateConditions);
+  TraceSpan span("GetPluginUserMetadata", pluginName);
+  return GetDatabase()->GetPluginUserMetadata(pluginName, evaluateConditions);
 }
 
 void Game::SetUserGroups(const std::vector<Group>& groups) {
-  return gameHandle_->GetDatabase()->SetUserGroups(groups);
+  IncrementMetadataGeneration();
+
+  // Get the database before locking, as getting it waits for any metadata
+  // load, which holds the lock.
+  auto database = GetDatabase();
+  std::lock_guard<std::mutex> guard(*userMetadataMutex_);
+  database->SetUserGroups(groups);
 }
 
 void Game::AddUserMetadata(const PluginMetadata& metadata) {
-  gameHandle_->GetDatabase()->SetPluginUserMetadata(metadata);
+  IncrementMetadataGeneration();
+  {
+    auto database = GetDatabase();
+    std::lock_guard<std::mutex> guard(*userMetadataMutex_);
+    database->SetPluginUserMetadata(metadata);
+  }
+  UpdateUserInteractions(metadata.GetName());
 }
 
 void Game::ClearUserMetadata(const std::string& pluginName) {
-  gameHandle_->GetDatabase()->DiscardPluginUserMetadata(pluginName);
+  IncrementMetadataGeneration();
+  {
+    auto database = GetDatabase();
+    std::lock_guard<std::mutex> guard(*userMetadataMutex_);
+    database->DiscardPluginUserMetadata(pluginName);
+  }
+  UpdateUserInteractions(pluginName);
 }
 
 void Game::ClearAllUserMetadata() {
-  gameHandle_->GetDatabase()->DiscardAllUserMetadata();
+  IncrementMetadataGeneration();
+  {
+    auto database = GetDatabase();
+    std::lock_guard<std::mutex> guard(*userMetadataMutex_);
+    database->DiscardAllUserMetadata();
+  }
+
+  if (interactionGraph_) {
+    for (const auto& plugin : interactionGraph_->GetSnapshot()->GetPlugins()) {
+      interactionGraph_->SetMetadata(PluginMetadata(plugin->GetName()), true);
+    }
+  }
+}
+
+std::set<std::string> Game::CheckForCyclicInteractions(
+    const std::string& pluginName) {
+  auto& graph = GetInteractionGraph();
+  auto previousCycles = cyclicInteractions_;
+  auto previousMembers = cyclicInteractionMembers_;
+
+  // Previously found cycles may have been resolved by other edits.
+  for (auto it = cyclicInteractions_.begin();
+       it != cyclicInteractions_.end();) {
+    auto cycle = graph.FindCycle(it->first);
+    if (cycle.has_value()) {
+      it->second = cycle.value();
+      ++it;
+    } else {
+      it = cyclicInteractions_.erase(it);
+    }
+  }
+  IndexCyclicInteractions();
+
+  // Don't record another cycle for a plugin that is already reported as part
+  // of one.
+  auto key = NormalizeFilename(pluginName);
+  if (cyclicInteractionMembers_.count(key) == 0) {
+    auto cycle = graph.FindCycle(pluginName);
+    if (cycle.has_value()) {
+      auto logger = getLogger();
+      if (logger) {
+        logger->error("\"{}\" is part of a cyclic interaction: {}",
+                      pluginName,
+                      DescribeCycle(cycle.value()));
+      }
+      cyclicInteractions_[key] = cycle.value();
+      IndexCyclicInteractions();
+    }
+  }
+
+  // Only plugins that were or are part of a cycle can have had their reported
+  // interactions change.
+  auto getMemberCycles =
+      [](const std::map<std::string, std::set<std::string>>& members,
+         const std::string& pluginName) {
+        auto it = members.find(NormalizeFilename(pluginName));
+        return it == members.end() ? std::set<std::string>() : it->second;
+      };
+
+  std::set<std::string> changedPlugins;
+  auto addChangedPlugins =
+      [&](const std::map<std::string, std::vector<Vertex>>& cycles) {
+        for (const auto& [cycleKey, cycle] : cycles) {
+          for (const auto& vertex : cycle) {
+            if (getMemberCycles(previousMembers, vertex.GetName()) !=
+                getMemberCycles(cyclicInteractionMembers_, vertex.GetName())) {
+              changedPlugins.insert(vertex.GetName());
+            }
+          }
+        }
+      };
+  addChangedPlugins(previousCycles);
+  addChangedPlugins(cyclicInteractions_);
+
+  return changedPlugins;
+}
+
+std::set<std::string> Game::GetDependentPlugins(
+    const std::string& pluginName) {
+  return GetInteractionGraph().GetDependentPlugins(pluginName);
+}
+
+void Game::BuildInteractionGraph() { GetInteractionGraph(); }
+
+void Game::ValidateUserGroups(const std::vector<Group>& groups) const {
+  ValidateGroups(GetMasterlistGroups(), groups);
 }
 
 void Game::SaveUserMetadata() {
-  gameHandle_->GetDatabase()->WriteUserMetadata(UserlistPath(), true);
+  // Don't write the userlist until libloot has finished reading it.
+  WaitForMetadata();
+
+  // The write holds its own references so that it's unaffected by the game
+  // being reinitialised before it runs.
+  userlistWriter_->Schedule([gameHandle = gameHandle_,
+                             userlistPath = UserlistPath(),
+                             mutex = userMetadataMutex_]() {
+    // Write to a temporary file and replace the userlist with it, so that the
+    // userlist is never left partially written.
+    auto tempPath = userlistPath;
+    tempPath += ".tmp";
+    {
+      std::lock_guard<std::mutex> guard(*mutex);
+      gameHandle->GetDatabase()->WriteUserMetadata(tempPath, true);
+    }
+    SyncFile(tempPath);
+    fs::rename(tempPath, userlistPath);
+
+    auto logger = getLogger();
+    if (logger) {
+      logger->debug("Wrote user metadata to {}", userlistPath.u8string());
+    }
+  });
 }
 
+void Game::FlushUserMetadata() { userlistWriter_->Flush(); }
+
 std::vector<std::string> Game::GetInstalledPluginNames() {
   std::vector<std::string> plugins;
 
   auto logger = getLogger();
-  if (logger) {
-    logger->trace("Scanning for plugins in {}", this->DataPath().u8string());
-  }
+  LOOT_LOG_TRACE(
+      logger, "Scanning for plugins in {}", this->DataPath().u8string());
 
   for (fs::directory_iterator it(this->DataPath());
        it != fs::directory_iterator();
@@ -729,10 +1816,9 @@ std::vector<std::string> Game::GetInstalledPluginNames() {
     if (fs::is_regular_file(it->status()) &&
         gameHandle_->IsValidPlugin(it->path().filename().u8string())) {
       string name = it->path().filename().u8string();
+      recordTraceEvent("Found plugin", name);
 
-      if (logger) {
-        logger->info("Found plugin: {}", name);
-      }
+      LOOT_LOG_INFO(logger, "Found plugin: {}", name);
 
       plugins.push_back(name);
     }
@@ -741,10 +1827,295 @@ std::vector<std::string> Game::GetInstalledPluginNames() {
   return plugins;
 }
 
+std::filesystem::path Game::GetPluginPath(const std::string& pluginName) const {
+  auto pluginPath = DataPath() / u8path(pluginName);
+  if (!fs::exists(pluginPath)) {
+    pluginPath += ".ghost";
+  }
+
+  return pluginPath;
+}
+
+std::shared_ptr<DatabaseInterface> Game::GetDatabase() const {
+  WaitForMetadata();
+  return gameHandle_->GetDatabase();
+}
+
+std::filesystem::path Game::MasterlistSnapshotPath() const {
+  return lootDataPath_ / u8path(FolderName()) / "masterlist.snapshot";
+}
+
 void Game::AppendMessages(std::vector<Message> messages) {
   for (auto message : messages) {
     AppendMessage(message);
   }
 }
+
+std::filesystem::file_time_type Game::GetMasterlistWriteTime() const {
+  std::error_code ec;
+  auto writeTime = fs::last_write_time(MasterlistPath(), ec);
+
+  return ec ? fs::file_time_type::min() : writeTime;
+}
+
+bool Game::HasMasterlistChangedSinceLoad() const {
+  return loadedMasterlistWriteTime_.has_value() &&
+         loadedMasterlistWriteTime_.value() != GetMasterlistWriteTime();
+}
+
+void Game::MigrateMasterlistRepository() {
+  // The masterlist used to be stored in each game's LOOT folder.
+  auto oldRepositoryPath = lootDataPath_ / u8path(FolderName());
+  auto oldMasterlistPath = oldRepositoryPath / "masterlist.yaml";
+  auto oldGitPath = oldRepositoryPath / ".git";
+  auto newRepositoryPath = MasterlistPath().parent_path();
+  if (!fs::exists(oldMasterlistPath)) {
+    return;
+  }
+
+  auto logger = getLogger();
+  try {
+    if (fs::exists(MasterlistPath())) {
+      // Another game that uses the same repository has already moved its
+      // copy, so this one is redundant.
+      if (logger) {
+        logger->info("Removing the redundant masterlist repository at {}",
+                     oldRepositoryPath.u8string());
+      }
+    } else {
+      if (logger) {
+        logger->info("Moving the masterlist repository at {} to {}",
+                     oldRepositoryPath.u8string(),
+                     newRepositoryPath.u8string());
+      }
+
+      fs::create_directories(newRepositoryPath);
+      fs::copy_file(oldMasterlistPath, MasterlistPath());
+
+      if (fs::exists(oldGitPath)) {
+        fs::copy(oldGitPath,
+                 newRepositoryPath / ".git",
+                 fs::copy_options::recursive);
+      }
+    }
+
+    fs::remove_all(oldGitPath);
+    fs::remove(oldMasterlistPath);
+  } catch (std::exception& e) {
+    if (logger) {
+      logger->error("Failed to move the masterlist repository: {}", e.what());
+    }
+  }
+}
+
+bool Game::PluginFileState::operator==(const PluginFileState& other) const {
+  return name == other.name && isActive == other.isActive &&
+         size == other.size && writeTime == other.writeTime;
+}
+
+bool Game::SortFingerprint::operator==(const SortFingerprint& other) const {
+  return metadataGeneration == other.metadataGeneration &&
+         loadOrder == other.loadOrder && loadedPlugins == other.loadedPlugins;
+}
+
+const Game::SortResult& Game::GetSortResult(
+    const std::vector<std::string>& loadOrder) {
+  auto logger = getLogger();
+  auto fingerprint = GetSortFingerprint(loadOrder);
+
+  if (lastSort_.has_value() && lastSort_.value().fingerprint == fingerprint) {
+    if (logger) {
+      logger->info(
+          "Nothing that affects sorting has changed since the last sort, "
+          "reusing its result.");
+    }
+    return lastSort_.value();
+  }
+
+  auto backgroundSort = std::atomic_load(&backgroundSort_);
+  std::atomic_store(&backgroundSort_, std::shared_ptr<const BackgroundSort>());
+  if (backgroundSort && backgroundSort->fingerprint == fingerprint) {
+    // A background sort that's still running is doing the same work as this
+    // one would, so wait for it unless it's been cancelled.
+    auto isFinished = backgroundSort->sortedPlugins.wait_for(
+                          std::chrono::seconds(0)) == std::future_status::ready;
+    auto sortedPlugins = isFinished || !*backgroundSort->isCancelled
+                             ? backgroundSort->sortedPlugins.get()
+                             : std::nullopt;
+    if (sortedPlugins.has_value()) {
+      if (logger) {
+        logger->info("Using the result of the background sort.");
+      }
+      lastSort_ =
+          SortResult{fingerprint,
+                     sortedPlugins.value(),
+                     CheckForRemovedPlugins(loadOrder, sortedPlugins.value())};
+      return lastSort_.value();
+    }
+  }
+
+  WaitForMetadata();
+  auto sortedPlugins = [&]() {
+    TraceSpan span("SortPlugins",
+                   isTracingEnabled() ? FolderName() : std::string());
+    return gameHandle_->SortPlugins(loadOrder);
+  }();
+
+  // Sorting loads the plugins fully, replacing those in the snapshot.
+  RebuildPluginSnapshot();
+
+  // The fingerprint must be taken again now that the sort has reloaded the
+  // plugins.
+  lastSort_ = SortResult{GetSortFingerprint(loadOrder),
+                         sortedPlugins,
+                         CheckForRemovedPlugins(loadOrder, sortedPlugins)};
+
+  return lastSort_.value();
+}
+
+Game::SortFingerprint Game::GetSortFingerprint(
+    const std::vector<std::string>& loadOrder) const {
+  SortFingerprint fingerprint;
+  fingerprint.loadedPlugins = GetPluginSnapshot()->GetPlugins();
+  fingerprint.metadataGeneration = metadataGeneration_;
+
+  // A plugin's size and modification time are used in place of its CRC, as
+  // they change whenever its content does and are much cheaper to get.
+  for (const auto& pluginName : loadOrder) {
+    fingerprint.loadOrder.push_back(GetPluginFileState(pluginName));
+  }
+
+  return fingerprint;
+}
+
+Game::PluginFileState Game::GetPluginFileState(
+    const std::string& pluginName) const {
+  PluginFileState state{pluginName,
+                        gameHandle_->IsPluginActive(pluginName),
+                        0,
+                        fs::file_time_type::min()};
+
+  auto pluginPath = GetPluginPath(pluginName);
+
+  std::error_code ec;
+  auto size = fs::file_size(pluginPath, ec);
+  if (!ec) {
+    state.size = size;
+  }
+  auto writeTime = fs::last_write_time(pluginPath, ec);
+  if (!ec) {
+    state.writeTime = writeTime;
+  }
+
+  return state;
+}
+
+InteractionGraph& Game::GetInteractionGraph() {
+  auto snapshot = GetPluginSnapshot();
+  if (interactionGraph_ && interactionGraph_->GetSnapshot()->GetPlugins() ==
+                               snapshot->GetPlugins()) {
+    return *interactionGraph_;
+  }
+
+  auto logger = getLogger();
+  if (logger) {
+    logger->trace("Building the interaction graph for {} plugins.",
+                  snapshot->Size());
+  }
+
+  interactionGraph_ = std::make_shared<InteractionGraph>(snapshot);
+  for (const auto& plugin : snapshot->GetPlugins()) {
+    try {
+      auto masterlistMetadata = GetMasterlistMetadata(plugin->GetName(), true);
+      if (masterlistMetadata.has_value()) {
+        interactionGraph_->SetMetadata(masterlistMetadata.value(), false);
+      }
+
+      auto userMetadata = GetUserMetadata(plugin->GetName(), true);
+      if (userMetadata.has_value()) {
+        interactionGraph_->SetMetadata(userMetadata.value(), true);
+      }
+    } catch (std::exception& e) {
+      if (logger) {
+        logger->error(
+            "Failed to add the metadata for \"{}\" to the interaction graph: "
+            "{}",
+            plugin->GetName(),
+            e.what());
+      }
+    }
+  }
+
+  return *interactionGraph_;
+}
+
+void Game::UpdateUserInteractions(const std::string& pluginName) {
+  if (!interactionGraph_) {
+    // The graph will get the latest metadata when it is built.
+    return;
+  }
+
+  auto userMetadata = GetUserMetadata(pluginName, true);
+  interactionGraph_->SetMetadata(
+      userMetadata.value_or(PluginMetadata(pluginName)), true);
+}
+
+void Game::IndexCyclicInteractions() {
+  cyclicInteractionMembers_.clear();
+  for (const auto& [pluginName, cycle] : cyclicInteractions_) {
+    auto description = DescribeCyclicInteraction(cycle);
+    for (const auto& vertex : cycle) {
+      cyclicInteractionMembers_[NormalizeFilename(vertex.GetName())].insert(
+          description);
+    }
+  }
+}
+
+void Game::ClearCyclicInteractions() {
+  cyclicInteractions_.clear();
+  cyclicInteractionMembers_.clear();
+}
+
+LoadOrderProfiles Game::LoadLoadOrderProfiles() const {
+  LoadOrderProfiles profiles;
+  if (!lootDataPath_.empty()) {
+    profiles.Load(LoadOrderProfilesPath());
+  }
+
+  return profiles;
+}
+
+std::vector<std::string> Game::GetLoadOrderProfile(
+    const std::string& name) const {
+  auto loadOrder = LoadLoadOrderProfiles().GetLoadOrder(name);
+  if (!loadOrder.has_value()) {
+    throw std::invalid_argument("There is no load order profile named \"" +
+                                name + "\".");
+  }
+
+  return loadOrder.value();
+}
+
+void Game::IncrementMetadataGeneration() {
+  lock_guard<mutex> guard(mutex_);
+
+  ++metadataGeneration_;
+}
+
+void Game::RebuildPluginSnapshot() {
+  auto snapshot = std::make_shared<const PluginSnapshot>(
+      gameHandle_->GetLoadedPlugins(), [&](const std::string& pluginName) {
+        return gameHandle_->IsPluginActive(pluginName);
+      });
+
+  std::atomic_store(&pluginSnapshot_, snapshot);
+
+  auto logger = getLogger();
+  if (logger) {
+    logger->trace("Built plugin snapshot version {} with {} plugins.",
+                  snapshot->GetVersion(),
+                  snapshot->Size());
+  }
+}
 }
 }
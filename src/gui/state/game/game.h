@@ -26,17 +26,53 @@
 #ifndef LOOT_GUI_STATE_GAME_GAME
 #define LOOT_GUI_STATE_GAME_GAME
 
+#include <atomic>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <future>
+#include <map>
 #include <mutex>
 #include <optional>
+#include <set>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
+#include "gui/state/debounced_writer.h"
+#include "gui/state/game/conflict_index.h"
+#include "gui/state/game/crc_cache.h"
 #include "gui/state/game/game_settings.h"
+#include "gui/state/game/interaction_graph.h"
+#include "gui/state/game/load_order_journal.h"
+#include "gui/state/game/load_order_profiles.h"
+#include "gui/state/game/masterlist_snapshot.h"
+#include "gui/state/game/plugin_snapshot.h"
 #include "loot/api.h"
 
 namespace loot {
 namespace gui {
+struct PluginRedate {
+  std::string pluginName;
+  std::filesystem::path path;
+  std::filesystem::file_time_type currentTime;
+  std::filesystem::file_time_type newTime;
+};
+
+struct MasterlistFetch {
+  // Empty if there was no masterlist before the fetch.
+  std::optional<std::string> previousRevisionId;
+  MasterlistInfo masterlist;
+  // False if the latest revision has a syntax error, so the most recent valid
+  // revision is being used instead.
+  bool isLatest;
+};
+
+// libloot synchronises access to a game handle and its database internally,
+// so a game's handle may be used by several threads at once, e.g. to parse
+// the metadata lists or write the userlist while plugins load. The one rule
+// that Game adds is that functions that read or change metadata wait for any
+// background parse to finish, so that they never see partially loaded lists.
 class Game : public GameSettings {
 public:
   Game(const GameSettings& gameSettings,
@@ -48,45 +84,143 @@ public:
   using GameSettings::Type;
 
   void Init();
+  bool IsInitialised() const;
+
+  // Releases the game handle and everything loaded through it. The game must
+  // be initialised again before it can be used.
+  void Unload();
+
+  // A rough estimate of the memory in bytes held by the game's loaded plugins
+  // and metadata.
+  size_t EstimateMemoryUsage() const;
 
   std::shared_ptr<const PluginInterface> GetPlugin(
       const std::string& name) const;
   std::vector<std::shared_ptr<const PluginInterface>> GetPlugins() const;
+  std::shared_ptr<const PluginSnapshot> GetPluginSnapshot() const;
+  // The index is only meaningful if plugins have been fully loaded. It's built
+  // when they are, or when it's first needed after they've been reloaded.
+  std::shared_ptr<const ConflictIndex> GetConflictIndex() const;
   std::vector<Message> CheckInstallValidity(
       const std::shared_ptr<const PluginInterface>& plugin,
       const PluginMetadata& metadata);
 
+  // Plans the timestamp changes that RedatePlugins() would make, without
+  // changing anything.
+  std::vector<PluginRedate> PlanPluginRedates() const;
   void RedatePlugins();  // Change timestamps to match load order (Skyrim only).
 
   void LoadAllInstalledPlugins(
       bool headersOnly);  // Loads all installed plugins.
   bool ArePluginsFullyLoaded()
       const;  // Checks if the game's plugins have already been loaded.
+  // Reloads the load order and active plugins, which may have been changed by
+  // another program since they were last loaded. Returns true if plugins have
+  // been installed, removed or changed since they were loaded, in which case
+  // they need to be loaded again.
+  bool RefreshLoadOrderState();
+  // Gets the CRC that libloot calculated when loading the plugin, or else a
+  // cached CRC. The plugin file isn't read, so returns std::nullopt if the CRC
+  // hasn't been calculated yet.
+  std::optional<uint32_t> FindPluginCrc(const PluginInterface& plugin) const;
+  // Starts calculating and caching the CRCs of loaded plugins that have none
+  // on another thread, so that they can be found by later loads. Does nothing
+  // if a calculation is already running.
+  void CachePluginCrcsInBackground();
 
   std::filesystem::path MasterlistPath() const;
   std::filesystem::path UserlistPath() const;
   std::filesystem::path PluginsTxtPath() const;
 
+  std::filesystem::path LoadOrderProfilesPath() const;
+
   std::vector<std::string> GetLoadOrder() const;
+  // Records the current load order in the game's load order journal before
+  // setting the new one, unless they're the same.
   void SetLoadOrder(const std::vector<std::string>& loadOrder);
 
+  size_t CountRecordedLoadOrders() const;
+  // An age of zero gets the load order that was most recently replaced.
+  std::vector<std::string> GetRecordedLoadOrder(size_t age) const;
+  std::vector<std::string> RestoreLoadOrder(size_t age);
+
+  std::vector<std::string> GetLoadOrderProfileNames() const;
+  // Saves the current load order as the named profile, replacing any profile
+  // with the same name.
+  void SaveLoadOrderProfile(const std::string& name);
+  // Sets the load order to the named profile's, fitted to the installed
+  // plugins, and returns the new load order.
+  std::vector<std::string> ApplyLoadOrderProfile(const std::string& name);
+  bool DeleteLoadOrderProfile(const std::string& name);
+  // Compares the named profile against another profile, or against the
+  // current load order if no other profile is given.
+  LoadOrderDiff DiffLoadOrderProfile(
+      const std::string& name,
+      const std::optional<std::string>& baseName) const;
+
   bool IsPluginActive(const std::string& pluginName) const;
   std::optional<short> GetActiveLoadOrderIndex(
       const std::shared_ptr<const PluginInterface>& plugin,
       const std::vector<std::string>& loadOrder) const;
 
   std::vector<std::string> SortPlugins();
+  // Starts sorting the current load order on another thread with a separate
+  // game handle and returns immediately. This isn't counted as a sort and
+  // doesn't record any messages, but a later call to SortPlugins() will use
+  // its result if nothing that affects sorting has changed in the meantime.
+  // If the sort succeeds without being cancelled, onSorted is called on that
+  // thread with whether the load order is already sorted.
+  void SortPluginsInBackground(std::function<void(bool)> onSorted);
+  // Stops any background sort from starting its next step. libloot can't be
+  // interrupted, so a step that's already running will finish. This can be
+  // called from any thread.
+  void CancelBackgroundSort();
   void IncrementLoadOrderSortCount();
   void DecrementLoadOrderSortCount();
 
   std::vector<Message> GetMessages() const;
+  // Gets messages using the snapshot's general messages instead of those
+  // loaded by libloot, so that it doesn't wait for metadata to load.
+  std::vector<Message> GetMessages(const MasterlistSnapshot& snapshot) const;
   void AppendMessage(const Message& message);
   void ClearMessages();
+  // Counts the error messages that the UI would display for the game and its
+  // loaded plugins, without building any plugin's UI metadata.
+  size_t CountErrorMessages();
 
+  // Fetches and loads the masterlist. If another fetch of the same
+  // masterlist is already running, its result is used instead of fetching
+  // again. Returns true if the loaded masterlist changed.
   bool UpdateMasterlist();
+  // Loads the masterlist without fetching it, if it has changed since it was
+  // last loaded, e.g. because it was fetched in the background or for another
+  // game. Returns true if the masterlist was loaded.
+  bool LoadMasterlistUpdate();
+  // Fetches the masterlist on another thread without changing the loaded
+  // metadata, once any metadata load has finished. If the masterlist was
+  // updated, onUpdated is called on that thread, and LoadMasterlistUpdate()
+  // will then load the update.
+  void UpdateMasterlistInBackground(std::function<void()> onUpdated);
+  // Fetches the masterlist using a separate game handle, so the game doesn't
+  // need to be initialised and its loaded metadata is left unchanged.
+  // LoadMasterlistUpdate() will load any update.
+  MasterlistFetch FetchMasterlist() const;
   MasterlistInfo GetMasterlistInfo() const;
+  // Checks if the latest revision of the masterlist is being used, i.e. that
+  // it doesn't have a syntax error.
+  bool IsLatestMasterlist() const;
 
   void LoadMetadata();
+  // Starts loading metadata on another thread and returns immediately. Any
+  // function that reads or changes metadata waits for the load to finish.
+  void LoadMetadataInBackground();
+  // Blocks until any metadata load running in the background has finished.
+  void WaitForMetadata() const;
+  // Returns std::nullopt if there is no snapshot of the current masterlist.
+  std::optional<MasterlistSnapshot> GetMasterlistSnapshot() const;
+  // Rewrites the masterlist snapshot if metadata has been loaded since it was
+  // last written. Plugins must have been loaded first.
+  void UpdateMasterlistSnapshot();
   std::vector<std::string> GetKnownBashTags() const;
 
   std::vector<Group> GetMasterlistGroups() const;
@@ -103,17 +237,120 @@ public:
   void AddUserMetadata(const PluginMetadata& metadata);
   void ClearUserMetadata(const std::string& pluginName);
   void ClearAllUserMetadata();
+  // The userlist is written in the background, and a burst of saves only
+  // results in one write.
   void SaveUserMetadata();
+  // Blocks until any pending userlist write has completed, and throws if a
+  // write has failed since the last flush.
+  void FlushUserMetadata();
+
+  // Checks if the given plugin is part of a cyclic interaction between
+  // masters, master flags, requirements and load after metadata without
+  // sorting: cycles that involve groups are only found by sorting. A cycle
+  // that is found is reported by CheckInstallValidity() for each plugin in it
+  // until it is resolved. Returns the names of the plugins whose reported
+  // cyclic interactions have changed.
+  std::set<std::string> CheckForCyclicInteractions(
+      const std::string& pluginName);
+  // Returns the names of the plugins whose requirements, load after or
+  // incompatibility metadata lists the given plugin.
+  std::set<std::string> GetDependentPlugins(const std::string& pluginName);
+  // Builds the graph of interactions between plugins if it's out of date, so
+  // that the checks above don't need to.
+  void BuildInteractionGraph();
+  // Throws if the given user groups are invalid when combined with the
+  // masterlist's groups.
+  void ValidateUserGroups(const std::vector<Group>& groups) const;
 
 private:
+  // The state of a plugin file that could affect how it sorts.
+  struct PluginFileState {
+    std::string name;
+    bool isActive;
+    std::uintmax_t size;
+    std::filesystem::file_time_type writeTime;
+
+    bool operator==(const PluginFileState& other) const;
+  };
+
+  // Everything that a sorted load order depends on. If two sorts have equal
+  // fingerprints, they will give the same result.
+  struct SortFingerprint {
+    std::vector<PluginFileState> loadOrder;
+    std::vector<std::shared_ptr<const PluginInterface>> loadedPlugins;
+    unsigned long metadataGeneration;
+
+    bool operator==(const SortFingerprint& other) const;
+  };
+
+  struct SortResult {
+    SortFingerprint fingerprint;
+    std::vector<std::string> sortedPlugins;
+    std::vector<Message> messages;
+  };
+
+  // A sort running on another thread, with the fingerprint of what it was
+  // started with.
+  struct BackgroundSort {
+    SortFingerprint fingerprint;
+    std::shared_ptr<std::atomic<bool>> isCancelled;
+    std::shared_future<std::optional<std::vector<std::string>>> sortedPlugins;
+  };
+
   std::vector<std::string> GetInstalledPluginNames();
+  PluginFileState GetPluginFileState(const std::string& pluginName) const;
+  std::filesystem::path GetPluginPath(const std::string& pluginName) const;
+  std::shared_ptr<DatabaseInterface> GetDatabase() const;
+  std::filesystem::path MasterlistSnapshotPath() const;
+  void AppendGameMessages(std::vector<Message>& output) const;
   void AppendMessages(std::vector<Message> messages);
+  void RebuildPluginSnapshot();
+  std::filesystem::file_time_type GetMasterlistWriteTime() const;
+  bool HasMasterlistChangedSinceLoad() const;
+  void AppendMasterlistFallbackMessage();
+  void MigrateMasterlistRepository();
+  const SortResult& GetSortResult(const std::vector<std::string>& loadOrder);
+  SortFingerprint GetSortFingerprint(
+      const std::vector<std::string>& loadOrder) const;
+  void IncrementMetadataGeneration();
+  LoadOrderProfiles LoadLoadOrderProfiles() const;
+  std::vector<std::string> GetLoadOrderProfile(const std::string& name) const;
+  InteractionGraph& GetInteractionGraph();
+  void UpdateUserInteractions(const std::string& pluginName);
+  void IndexCyclicInteractions();
+  void ClearCyclicInteractions();
 
   std::shared_ptr<GameInterface> gameHandle_;
+  // Holds the error message if loading metadata failed.
+  std::shared_future<std::optional<std::string>> metadataLoad_;
+  std::shared_future<void> masterlistFetch_;
+  // Declared before crcCache_ so that the cache is released first, which
+  // stops a calculation that's still running.
+  std::shared_future<void> crcCalculation_;
+  std::shared_ptr<const PluginSnapshot> pluginSnapshot_;
+  mutable std::shared_ptr<const ConflictIndex> conflictIndex_;
   std::vector<Message> messages_;
   std::filesystem::path lootDataPath_;
+  std::optional<std::filesystem::file_time_type> loadedMasterlistWriteTime_;
+  std::optional<SortResult> lastSort_;
+  // Accessed atomically so that the sort can be cancelled from any thread.
+  std::shared_ptr<const BackgroundSort> backgroundSort_;
+  // The installed plugin files as they were when plugins were last loaded.
+  std::vector<PluginFileState> loadedPluginFiles_;
+  std::shared_ptr<InteractionGraph> interactionGraph_;
+  std::shared_ptr<LoadOrderJournal> loadOrderJournal_;
+  std::shared_ptr<CrcCache> crcCache_;
+  std::shared_ptr<DebouncedWriter> userlistWriter_;
+  // Held while user metadata is changed or written.
+  std::shared_ptr<std::mutex> userMetadataMutex_;
+  std::map<std::string, std::vector<Vertex>> cyclicInteractions_;
+  // Maps each plugin in a recorded cyclic interaction to the descriptions of
+  // the interactions that it is part of.
+  std::map<std::string, std::set<std::string>> cyclicInteractionMembers_;
+  unsigned long metadataGeneration_;
   unsigned short loadOrderSortCount_;
   bool pluginsFullyLoaded_;
+  bool masterlistSnapshotNeedsUpdate_;
 
   mutable std::mutex mutex_;
 };
@@ -26,11 +26,20 @@
 #ifndef LOOT_GUI_STATE_GAME_GAMES_MANAGER
 #define LOOT_GUI_STATE_GAME_GAMES_MANAGER
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
 #include <filesystem>
+#include <functional>
+#include <future>
+#include <list>
 #include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <boost/locale.hpp>
@@ -43,7 +52,47 @@
 namespace loot {
 class GamesManager {
 public:
-  GamesManager() : currentGame_(installedGames_.end()) {}
+  struct MasterlistUpdateSummary {
+    std::string folderName;
+    MasterlistInfo masterlist;
+    bool wasChanged;
+    // The latest masterlist revision has a syntax error, so the most recent
+    // valid revision is being used instead.
+    bool isUsingFallback;
+    std::optional<std::string> error;
+  };
+
+  typedef std::function<std::optional<std::filesystem::path>(
+      const GameSettings&)>
+      GamePathFinder;
+
+  // Games are looked for on detached threads that may outlive this object, so
+  // the given function must not refer to it.
+  explicit GamesManager(GamePathFinder findGamePath =
+                            [](const GameSettings& gameSettings) {
+                              return gameSettings.FindGamePath();
+                            }) :
+      findGamePath_(findGamePath),
+      currentGame_(installedGames_.end()),
+      warmGamesMemoryBudget_(DEFAULT_WARM_GAMES_MEMORY_BUDGET),
+      gameDetectionTimeout_(DEFAULT_GAME_DETECTION_TIMEOUT) {}
+
+  // A game that takes longer than the timeout to detect is treated as not
+  // installed.
+  void SetGameDetectionTimeout(std::chrono::milliseconds timeout) {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+
+    gameDetectionTimeout_ = timeout;
+  }
+
+  // Recently-used games are kept initialised so that switching back to them
+  // doesn't need their data to be loaded again, up to the given budget.
+  void SetWarmGamesMemoryBudget(size_t bytes) {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+
+    warmGamesMemoryBudget_ = bytes;
+    EvictWarmGames();
+  }
 
   // Installed games have their game paths set in the returned settings.
   std::vector<GameSettings> LoadInstalledGames(
@@ -58,32 +107,35 @@ public:
       currentGameFolder = currentGame_->FolderName();
     }
 
-    bool currentGameUpdated = false;
+    // Initialised games are kept as long as the settings they were
+    // initialised with haven't changed.
+    std::list<std::string> warmGames;
     std::vector<gui::Game> installedGames;
-    for (auto& gameSettings : gamesSettings) {
-      auto gamePath = FindGamePath(gameSettings);
+    auto gamePaths = FindGamePaths(gamesSettings);
+    for (size_t i = 0; i < gamesSettings.size(); ++i) {
+      auto& gameSettings = gamesSettings[i];
+      const auto& gamePath = gamePaths[i];
       if (!gamePath.has_value()) {
         continue;
       }
       gameSettings.SetGamePath(gamePath.value());
 
-      if (currentGameFolder.has_value() &&
-          currentGameFolder.value() == gameSettings.FolderName() &&
-          !GameNeedsRecreating(GetCurrentGame(), gameSettings)) {
+      auto existingGame = FindWarmGame(gameSettings.FolderName());
+      if (existingGame != installedGames_.end() &&
+          !GameNeedsRecreating(*existingGame, gameSettings)) {
         if (logger) {
           logger->trace("Updating game entry for: {}",
                         gameSettings.FolderName());
         }
 
-        GetCurrentGame()
-            .SetName(gameSettings.Name())
+        existingGame->SetName(gameSettings.Name())
             .SetMinimumHeaderVersion(gameSettings.MinimumHeaderVersion())
             .SetRegistryKey(gameSettings.RegistryKey())
             .SetRepoURL(gameSettings.RepoURL())
             .SetRepoBranch(gameSettings.RepoBranch());
 
-        installedGames.push_back(GetCurrentGame());
-        currentGameUpdated = true;
+        installedGames.push_back(*existingGame);
+        warmGames.push_back(gameSettings.FolderName());
       } else {
         if (logger) {
           logger->trace("Adding new installed game entry for: {}",
@@ -95,6 +147,18 @@ public:
     }
     installedGames_ = installedGames;
 
+    // Keep the warm games in their existing order of use.
+    warmGames_.remove_if([&](const std::string& folderName) {
+      return std::find(warmGames.begin(), warmGames.end(), folderName) ==
+             warmGames.end();
+    });
+
+    bool currentGameUpdated =
+        currentGameFolder.has_value() &&
+        std::find(warmGames_.begin(),
+                  warmGames_.end(),
+                  currentGameFolder.value()) != warmGames_.end();
+
     if (currentGameUpdated) {
       SetCurrentGameWithoutInit(currentGameFolder.value());
     } else if (currentGameFolder.has_value()) {
@@ -127,8 +191,25 @@ public:
   }
 
   void SetCurrentGame(const std::string& newGameFolder) {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+
     SetCurrentGameWithoutInit(newGameFolder);
-    InitialiseGameData(GetCurrentGame());
+
+    auto it = std::find(warmGames_.begin(), warmGames_.end(), newGameFolder);
+    if (it != warmGames_.end()) {
+      auto logger = getLogger();
+      if (logger) {
+        logger->debug("Reusing the already-initialised game data for: {}",
+                      newGameFolder);
+      }
+
+      warmGames_.splice(warmGames_.begin(), warmGames_, it);
+    } else {
+      InitialiseGameData(GetCurrentGame());
+      warmGames_.push_front(newGameFolder);
+    }
+
+    EvictWarmGames();
   }
 
   std::vector<std::string> GetInstalledGameFolderNames() const {
@@ -142,6 +223,110 @@ public:
     return installedGames;
   }
 
+  // Blocks until every game's pending background writes have completed. If
+  // any of the games' writes failed, the first failure is rethrown once all
+  // games have been flushed.
+  void FlushPendingWrites() {
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+
+    std::exception_ptr error;
+    for (auto& game : installedGames_) {
+      try {
+        game.FlushUserMetadata();
+      } catch (...) {
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  // Updates the masterlists of all installed games, using up to the given
+  // number of threads. Games don't need to be initialised, and their loaded
+  // metadata is left unchanged: calling a game's LoadMasterlistUpdate()
+  // afterwards will load any update.
+  std::vector<MasterlistUpdateSummary> UpdateAllMasterlists(
+      size_t maxThreads = DEFAULT_MASTERLIST_UPDATE_THREADS) {
+    std::vector<gui::Game> games;
+    {
+      std::lock_guard<std::recursive_mutex> guard(mutex_);
+
+      games = installedGames_;
+    }
+
+    // Games can share a masterlist, so fetch each masterlist once and give
+    // its result to every game that uses it.
+    std::vector<std::filesystem::path> masterlistPaths;
+    // The index of the first game that uses each masterlist.
+    std::vector<size_t> fetchingGames;
+    // The index of the masterlist that each game uses.
+    std::vector<size_t> masterlistIndices;
+    for (size_t i = 0; i < games.size(); ++i) {
+      auto it = std::find(masterlistPaths.begin(),
+                          masterlistPaths.end(),
+                          games[i].MasterlistPath());
+      masterlistIndices.push_back(it - masterlistPaths.begin());
+      if (it == masterlistPaths.end()) {
+        masterlistPaths.push_back(games[i].MasterlistPath());
+        fetchingGames.push_back(i);
+      }
+    }
+
+    std::vector<std::optional<MasterlistFetch>> fetches(masterlistPaths.size());
+    std::vector<std::optional<std::string>> errors(masterlistPaths.size());
+    RunOnThreads(masterlistPaths.size(), maxThreads, [&](size_t i) {
+      try {
+        fetches[i] = games[fetchingGames[i]].FetchMasterlist();
+      } catch (std::exception& e) {
+        errors[i] = e.what();
+      }
+    });
+
+    std::vector<MasterlistUpdateSummary> summaries(games.size());
+    for (size_t i = 0; i < games.size(); ++i) {
+      const auto& fetch = fetches[masterlistIndices[i]];
+
+      summaries[i].folderName = games[i].FolderName();
+      summaries[i].wasChanged = false;
+      summaries[i].isUsingFallback = false;
+      summaries[i].error = errors[masterlistIndices[i]];
+
+      if (fetch.has_value()) {
+        summaries[i].masterlist = fetch.value().masterlist;
+        summaries[i].wasChanged = fetch.value().previousRevisionId !=
+                                  fetch.value().masterlist.revision_id;
+        summaries[i].isUsingFallback = !fetch.value().isLatest;
+      }
+    }
+
+    auto logger = getLogger();
+    for (const auto& summary : summaries) {
+      if (!logger) {
+        break;
+      }
+
+      if (summary.error.has_value()) {
+        logger->error("Failed to update the masterlist for {}: {}",
+                      summary.folderName,
+                      summary.error.value());
+      } else {
+        logger->info(
+            "Masterlist for {} is at revision {}, changed: {}, using "
+            "fallback: {}",
+            summary.folderName,
+            summary.masterlist.revision_id,
+            summary.wasChanged,
+            summary.isUsingFallback);
+      }
+    }
+
+    return summaries;
+  }
+
   std::optional<std::string> GetFirstInstalledGameFolderName() const {
     if (!installedGames_.empty()) {
       return installedGames_.front().FolderName();
@@ -151,10 +336,50 @@ public:
   }
 
 private:
-  virtual std::optional<std::filesystem::path> FindGamePath(
-      const GameSettings& gameSettings) const = 0;
+  typedef std::pair<std::optional<std::filesystem::path>,
+                    std::chrono::milliseconds>
+      GameProbeResult;
+
+  // Shared between a probe's thread and whatever is waiting for it, so that
+  // the thread can be abandoned.
+  struct GameProbe {
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool isFinished = false;
+    std::optional<GameProbeResult> result;
+    std::exception_ptr error;
+  };
+
   virtual void InitialiseGameData(gui::Game& game) = 0;
 
+  virtual size_t EstimateMemoryUsage(const gui::Game& game) const {
+    return game.EstimateMemoryUsage();
+  }
+
+  virtual void UnloadGameData(gui::Game& game) { game.Unload(); }
+
+  // Calls the given function for each index up to count, spread over up to
+  // maxThreads threads.
+  template<typename Function>
+  static void RunOnThreads(size_t count, size_t maxThreads, Function function) {
+    std::atomic<size_t> nextIndex(0);
+    auto worker = [&]() {
+      for (auto i = nextIndex++; i < count; i = nextIndex++) {
+        function(i);
+      }
+    };
+
+    std::vector<std::future<void>> workers;
+    auto threadCount = std::min(std::max(maxThreads, size_t(1)), count);
+    for (size_t i = 0; i < threadCount; ++i) {
+      workers.push_back(std::async(std::launch::async, worker));
+    }
+
+    for (auto& thread : workers) {
+      thread.get();
+    }
+  }
+
   static bool GameNeedsRecreating(const gui::Game& game,
                                   const GameSettings& newSettings) {
     return game.GamePath() != newSettings.GamePath() ||
@@ -189,9 +414,160 @@ private:
     }
   }
 
+  // Look for all the given games at once, so that a game on a slow drive
+  // doesn't hold up detection of the others. Each probe runs on a detached
+  // thread that owns its state, so a probe that times out is abandoned and
+  // nothing waits for it to finish, even when LOOT exits.
+  std::vector<std::optional<std::filesystem::path>> FindGamePaths(
+      const std::vector<GameSettings>& gamesSettings) {
+    using std::chrono::duration_cast;
+    using std::chrono::milliseconds;
+    using std::chrono::steady_clock;
+
+    auto logger = getLogger();
+
+    std::vector<std::shared_ptr<GameProbe>> probes;
+    for (const auto& gameSettings : gamesSettings) {
+      auto probe = std::make_shared<GameProbe>();
+      std::thread([probe, findGamePath = findGamePath_, gameSettings]() {
+        auto start = steady_clock::now();
+        std::optional<GameProbeResult> result;
+        std::exception_ptr error;
+        try {
+          auto gamePath = findGamePath(gameSettings);
+          result = std::make_pair(
+              gamePath,
+              duration_cast<milliseconds>(steady_clock::now() - start));
+        } catch (...) {
+          error = std::current_exception();
+        }
+
+        {
+          std::lock_guard<std::mutex> guard(probe->mutex);
+          probe->result = result;
+          probe->error = error;
+          probe->isFinished = true;
+        }
+        probe->condition.notify_all();
+      }).detach();
+      probes.push_back(probe);
+    }
+
+    auto deadline = steady_clock::now() + gameDetectionTimeout_;
+
+    std::vector<std::optional<std::filesystem::path>> gamePaths;
+    for (size_t i = 0; i < probes.size(); ++i) {
+      const auto& folderName = gamesSettings[i].FolderName();
+      auto& probe = *probes[i];
+
+      std::unique_lock<std::mutex> lock(probe.mutex);
+      if (!probe.condition.wait_until(
+              lock, deadline, [&probe]() { return probe.isFinished; })) {
+        if (logger) {
+          logger->warn(
+              "Timed out after {} ms while checking if the game with folder "
+              "\"{}\" is installed, so it will be treated as not installed.",
+              gameDetectionTimeout_.count(),
+              folderName);
+        }
+        gamePaths.push_back(std::nullopt);
+        continue;
+      }
+
+      try {
+        if (probe.error) {
+          std::rethrow_exception(probe.error);
+        }
+
+        auto [gamePath, duration] = probe.result.value();
+        if (logger) {
+          logger->debug("Checked if the game with folder \"{}\" is installed "
+                        "in {} ms.",
+                        folderName,
+                        duration.count());
+        }
+        gamePaths.push_back(gamePath);
+      } catch (std::exception& e) {
+        if (logger) {
+          logger->error(
+              "Error while checking if the game with folder \"{}\" is "
+              "installed: {}",
+              folderName,
+              e.what());
+        }
+        gamePaths.push_back(std::nullopt);
+      }
+    }
+
+    return gamePaths;
+  }
+
+  std::vector<gui::Game>::iterator FindWarmGame(const std::string& folderName) {
+    if (std::find(warmGames_.begin(), warmGames_.end(), folderName) ==
+        warmGames_.end()) {
+      return installedGames_.end();
+    }
+
+    return find_if(installedGames_.begin(),
+                   installedGames_.end(),
+                   [&](const gui::Game& game) {
+                     return folderName == game.FolderName();
+                   });
+  }
+
+  // Unload the least recently used games until the warm games fit in the
+  // memory budget. The current game is never unloaded.
+  void EvictWarmGames() {
+    auto logger = getLogger();
+
+    size_t totalUsage = 0;
+    for (const auto& folderName : warmGames_) {
+      auto game = FindWarmGame(folderName);
+      if (game != installedGames_.end()) {
+        totalUsage += EstimateMemoryUsage(*game);
+      }
+    }
+
+    while (totalUsage > warmGamesMemoryBudget_ && warmGames_.size() > 1) {
+      auto folderName = warmGames_.back();
+      auto game = FindWarmGame(folderName);
+      if (game == currentGame_) {
+        break;
+      }
+
+      warmGames_.pop_back();
+
+      if (game == installedGames_.end()) {
+        continue;
+      }
+
+      auto usage = EstimateMemoryUsage(*game);
+      if (logger) {
+        logger->debug(
+            "Unloading game data for {} to free an estimated {} bytes.",
+            folderName,
+            usage);
+      }
+
+      UnloadGameData(*game);
+      totalUsage -= std::min(usage, totalUsage);
+    }
+  }
+
+  static constexpr size_t DEFAULT_WARM_GAMES_MEMORY_BUDGET = 512 * 1024 * 1024;
+  static constexpr std::chrono::milliseconds DEFAULT_GAME_DETECTION_TIMEOUT =
+      std::chrono::seconds(5);
+  static constexpr size_t DEFAULT_MASTERLIST_UPDATE_THREADS = 4;
+
+  const GamePathFinder findGamePath_;
   std::vector<gui::Game> installedGames_;
   std::vector<gui::Game>::iterator currentGame_;
 
+  // Folder names of initialised games, most recently used first.
+  std::list<std::string> warmGames_;
+  size_t warmGamesMemoryBudget_;
+  std::chrono::milliseconds gameDetectionTimeout_;
+
   // Mutex used to protect access to member variables.
   mutable std::recursive_mutex mutex_;
 };
@@ -25,8 +25,10 @@
 
 #include "gui/state/game/helpers.h"
 
-#include <fstream>
+#include <cctype>
+#include <iomanip>
 #include <regex>
+#include <sstream>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
@@ -44,32 +46,6 @@ bool ExecutableExists(const GameType& gameType,
   return true;  // Don't bother checking for the other games.
 }
 
-void BackupLoadOrder(const std::vector<std::string>& loadOrder,
-                     const std::filesystem::path& backupDirectory) {
-  const int maxBackupIndex = 2;
-  boost::format filenameFormat = boost::format("loadorder.bak.%1%");
-
-  std::filesystem::path backupFilePath =
-      backupDirectory / (filenameFormat % 2).str();
-  if (std::filesystem::exists(backupFilePath)) {
-    std::filesystem::remove(backupFilePath);
-  }
-
-  for (int i = maxBackupIndex - 1; i > -1; --i) {
-    const std::filesystem::path backupFilePath =
-        backupDirectory / (filenameFormat % i).str();
-    if (std::filesystem::exists(backupFilePath)) {
-      std::filesystem::rename(
-          backupFilePath, backupDirectory / (filenameFormat % (i + 1)).str());
-    }
-  }
-
-  std::ofstream out(backupDirectory / (filenameFormat % 0).str());
-  for (const auto& plugin : loadOrder) {
-    out << plugin << std::endl;
-  }
-}
-
 Message PlainTextMessage(MessageType type, std::string text) {
   return Message(type, EscapeMarkdownSpecialChars(text));
 }
@@ -199,6 +175,19 @@ std::string DescribeCycle(const std::vector<Vertex>& cycle) {
   return text;
 }
 
+std::string DescribeCyclicInteraction(const std::vector<Vertex>& cycle) {
+  if (cycle.empty()) {
+    return "";
+  }
+
+  return (boost::format(boost::locale::translate(
+              "Cyclic interaction detected between \"%1%\" and \"%2%\": %3%")) %
+          EscapeMarkdownSpecialChars(cycle.front().GetName()) %
+          EscapeMarkdownSpecialChars(cycle.back().GetName()) %
+          DescribeCycle(cycle))
+      .str();
+}
+
 std::vector<Message> CheckForRemovedPlugins(
     const std::vector<std::string> pluginsBefore,
     const std::vector<std::string> pluginsAfter) {
@@ -259,4 +248,54 @@ std::tuple<std::string, std::string, std::string> SplitRegistryPath(
 
   return std::make_tuple(rootKey, subKey, value);
 }
+
+std::string GetMasterlistRepositoryFolderName(const std::string& repoURL,
+                                              const std::string& repoBranch) {
+  // Use the repository's name to keep the folder recognisable, and a hash of
+  // the full URL and branch to distinguish forks and branches. The hash must
+  // be stable across runs, so use 32-bit FNV-1a instead of std::hash.
+  uint32_t hash = 2166136261;
+  for (const char c : repoURL + '\n' + repoBranch) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 16777619;
+  }
+
+  auto name = repoURL;
+  while (!name.empty() && (name.back() == '/' || name.back() == '\\')) {
+    name.pop_back();
+  }
+
+  auto lastSeparatorPos = name.find_last_of("/\\:");
+  if (lastSeparatorPos != std::string::npos) {
+    name = name.substr(lastSeparatorPos + 1);
+  }
+
+  if (boost::iends_with(name, ".git")) {
+    name = name.substr(0, name.length() - 4);
+  }
+
+  for (auto& c : name) {
+    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '.') {
+      c = '_';
+    }
+  }
+
+  std::ostringstream stream;
+  stream << name << "-" << std::hex << std::setw(8) << std::setfill('0')
+         << hash;
+
+  return stream.str();
+}
+
+bool HasSameMetadata(const PluginMetadata& lhs, const PluginMetadata& rhs) {
+  return lhs.GetGroup() == rhs.GetGroup() &&
+         lhs.GetLoadAfterFiles() == rhs.GetLoadAfterFiles() &&
+         lhs.GetRequirements() == rhs.GetRequirements() &&
+         lhs.GetIncompatibilities() == rhs.GetIncompatibilities() &&
+         lhs.GetMessages() == rhs.GetMessages() &&
+         lhs.GetTags() == rhs.GetTags() &&
+         lhs.GetDirtyInfo() == rhs.GetDirtyInfo() &&
+         lhs.GetCleanInfo() == rhs.GetCleanInfo() &&
+         lhs.GetLocations() == rhs.GetLocations();
+}
 }
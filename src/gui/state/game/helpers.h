@@ -33,15 +33,13 @@
 #include <loot/enum/game_type.h>
 #include <loot/metadata/message.h>
 #include <loot/metadata/plugin_cleaning_data.h>
+#include <loot/metadata/plugin_metadata.h>
 #include <loot/vertex.h>
 
 namespace loot {
 bool ExecutableExists(const GameType& gameType,
                       const std::filesystem::path& gamePath);
 
-void BackupLoadOrder(const std::vector<std::string>& loadOrder,
-                     const std::filesystem::path& backupDirectory);
-
 // Escape any Markdown special characters in the input text.
 std::string EscapeMarkdownSpecialChars(std::string text);
 
@@ -52,12 +50,24 @@ Message ToMessage(const PluginCleaningData& cleaningData);
 
 std::string DescribeCycle(const std::vector<Vertex>& cycle);
 
+// Describe a cyclic interaction in the same way as when sorting fails.
+std::string DescribeCyclicInteraction(const std::vector<Vertex>& cycle);
+
 std::vector<Message> CheckForRemovedPlugins(
     const std::vector<std::string> pluginsBefore,
     const std::vector<std::string> pluginsAfter);
 
 std::tuple<std::string, std::string, std::string> SplitRegistryPath(
   const std::string& registryPath);
+
+// Get the name of the folder that holds the local clone of the given
+// masterlist repository branch. Games that use the same repository and branch
+// get the same folder name, so share a clone.
+std::string GetMasterlistRepositoryFolderName(const std::string& repoURL,
+                                              const std::string& repoBranch);
+
+// Checks if two sets of plugin metadata are the same, ignoring their names.
+bool HasSameMetadata(const PluginMetadata& lhs, const PluginMetadata& rhs);
 }
 
 #endif
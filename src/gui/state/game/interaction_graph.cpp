@@ -0,0 +1,336 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/game/interaction_graph.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <queue>
+#include <set>
+
+#include "loot/exception/cyclic_interaction_error.h"
+#include "loot/exception/undefined_group_error.h"
+
+namespace loot {
+namespace gui {
+InteractionGraph::InteractionGraph(
+    std::shared_ptr<const PluginSnapshot> snapshot) :
+    snapshot_(snapshot),
+    outgoingEdges_(snapshot->Size()),
+    incomingEdges_(snapshot->Size()),
+    incompatibilities_(snapshot->Size()),
+    incompatibleWith_(snapshot->Size()) {
+  const auto& plugins = snapshot_->GetPlugins();
+  for (size_t i = 0; i < plugins.size(); ++i) {
+    for (const auto& master : plugins[i]->GetMasters()) {
+      auto masterIndex = snapshot_->GetIndex(master);
+      if (masterIndex.has_value()) {
+        AddEdge(masterIndex.value(), i, EdgeType::master);
+      }
+    }
+  }
+}
+
+std::shared_ptr<const PluginSnapshot> InteractionGraph::GetSnapshot() const {
+  return snapshot_;
+}
+
+void InteractionGraph::SetMetadata(const PluginMetadata& metadata,
+                                   bool isUserMetadata) {
+  auto index = snapshot_->GetIndex(metadata.GetName());
+  if (!index.has_value()) {
+    return;
+  }
+
+  auto requirementType = isUserMetadata ? EdgeType::userRequirement
+                                        : EdgeType::masterlistRequirement;
+  auto loadAfterType =
+      isUserMetadata ? EdgeType::userLoadAfter : EdgeType::masterlistLoadAfter;
+
+  RemoveEdges(index.value(), requirementType, loadAfterType);
+
+  auto addEdges = [&](const std::vector<File>& files, EdgeType type) {
+    for (const auto& file : files) {
+      auto fileIndex = snapshot_->GetIndex(std::string(file.GetName()));
+      if (fileIndex.has_value() && fileIndex.value() != index.value()) {
+        AddEdge(fileIndex.value(), index.value(), type);
+      }
+    }
+  };
+
+  addEdges(metadata.GetRequirements(), requirementType);
+  addEdges(metadata.GetLoadAfterFiles(), loadAfterType);
+
+  SetIncompatibilities(
+      index.value(), metadata.GetIncompatibilities(), isUserMetadata);
+}
+
+std::optional<std::vector<Vertex>> InteractionGraph::FindCycle(
+    const std::string& pluginName) const {
+  auto index = snapshot_->GetIndex(pluginName);
+  if (!index.has_value()) {
+    return std::nullopt;
+  }
+
+  const auto start = index.value();
+  const auto startIsMaster = snapshot_->IsMaster(start);
+
+  // A cycle exists if a plugin that must load before the start plugin can be
+  // reached from it.
+  std::vector<std::optional<EdgeType>> edgesToStart(snapshot_->Size());
+  for (const auto& edge : incomingEdges_[start]) {
+    if (!edgesToStart[edge.plugin].has_value()) {
+      edgesToStart[edge.plugin] = edge.type;
+    }
+  }
+
+  // Breadth-first search so that the shortest cycle is found.
+  std::vector<bool> isVisited(snapshot_->Size(), false);
+  std::vector<std::optional<Edge>> parents(snapshot_->Size());
+  std::queue<size_t> queue;
+  bool areNonMastersVisited = false;
+
+  isVisited[start] = true;
+  queue.push(start);
+
+  while (!queue.empty()) {
+    auto current = queue.front();
+    queue.pop();
+
+    if (current != start) {
+      auto edgeToStart = edgesToStart[current];
+      if (!edgeToStart.has_value() && !startIsMaster &&
+          snapshot_->IsMaster(current)) {
+        edgeToStart = EdgeType::masterFlag;
+      }
+
+      if (edgeToStart.has_value()) {
+        std::vector<Vertex> cycle;
+        cycle.push_back(Vertex(
+            snapshot_->GetPlugins()[current]->GetName(), edgeToStart.value()));
+        for (auto parent = parents[current]; parent.has_value();
+             parent = parents[parent.value().plugin]) {
+          cycle.push_back(
+              Vertex(snapshot_->GetPlugins()[parent.value().plugin]->GetName(),
+                     parent.value().type));
+        }
+        std::reverse(cycle.begin(), cycle.end());
+
+        return cycle;
+      }
+    }
+
+    auto visit = [&](size_t next, EdgeType type) {
+      if (!isVisited[next]) {
+        isVisited[next] = true;
+        parents[next] = Edge{current, type};
+        queue.push(next);
+      }
+    };
+
+    for (const auto& edge : outgoingEdges_[current]) {
+      visit(edge.plugin, edge.type);
+    }
+
+    // Masters load before all non-masters. Those edges are implicit, and only
+    // need to be followed from the first master reached.
+    if (snapshot_->IsMaster(current) && !areNonMastersVisited) {
+      areNonMastersVisited = true;
+      for (size_t i = 0; i < snapshot_->Size(); ++i) {
+        if (!snapshot_->IsMaster(i)) {
+          visit(i, EdgeType::masterFlag);
+        }
+      }
+    }
+  }
+
+  return std::nullopt;
+}
+
+std::set<std::string> InteractionGraph::GetDependentPlugins(
+    const std::string& pluginName) const {
+  auto index = snapshot_->GetIndex(pluginName);
+  if (!index.has_value()) {
+    return {};
+  }
+
+  const auto& plugins = snapshot_->GetPlugins();
+  std::set<std::string> dependentPlugins;
+  for (const auto& edge : outgoingEdges_[index.value()]) {
+    if (edge.type != EdgeType::master) {
+      dependentPlugins.insert(plugins[edge.plugin]->GetName());
+    }
+  }
+
+  for (const auto& incompatibility : incompatibleWith_[index.value()]) {
+    dependentPlugins.insert(plugins[incompatibility.plugin]->GetName());
+  }
+
+  return dependentPlugins;
+}
+
+void InteractionGraph::AddEdge(size_t fromPlugin,
+                               size_t toPlugin,
+                               EdgeType type) {
+  outgoingEdges_[fromPlugin].push_back(Edge{toPlugin, type});
+  incomingEdges_[toPlugin].push_back(Edge{fromPlugin, type});
+}
+
+void InteractionGraph::RemoveEdges(size_t toPlugin,
+                                   EdgeType firstType,
+                                   EdgeType secondType) {
+  auto hasType = [&](const Edge& edge) {
+    return edge.type == firstType || edge.type == secondType;
+  };
+
+  auto& incomingEdges = incomingEdges_[toPlugin];
+  for (const auto& incomingEdge : incomingEdges) {
+    if (!hasType(incomingEdge)) {
+      continue;
+    }
+
+    auto& outgoingEdges = outgoingEdges_[incomingEdge.plugin];
+    outgoingEdges.erase(
+        std::remove_if(outgoingEdges.begin(),
+                       outgoingEdges.end(),
+                       [&](const Edge& edge) {
+                         return edge.plugin == toPlugin && hasType(edge);
+                       }),
+        outgoingEdges.end());
+  }
+
+  incomingEdges.erase(
+      std::remove_if(incomingEdges.begin(), incomingEdges.end(), hasType),
+      incomingEdges.end());
+}
+
+void InteractionGraph::SetIncompatibilities(size_t plugin,
+                                            const std::vector<File>& files,
+                                            bool isUserMetadata) {
+  auto& incompatibilities = incompatibilities_[plugin];
+  for (const auto& incompatibility : incompatibilities) {
+    if (incompatibility.isUserMetadata != isUserMetadata) {
+      continue;
+    }
+
+    auto& incompatibleWith = incompatibleWith_[incompatibility.plugin];
+    incompatibleWith.erase(
+        std::remove_if(incompatibleWith.begin(),
+                       incompatibleWith.end(),
+                       [&](const Incompatibility& other) {
+                         return other.plugin == plugin &&
+                                other.isUserMetadata == isUserMetadata;
+                       }),
+        incompatibleWith.end());
+  }
+
+  incompatibilities.erase(
+      std::remove_if(incompatibilities.begin(),
+                     incompatibilities.end(),
+                     [&](const Incompatibility& incompatibility) {
+                       return incompatibility.isUserMetadata == isUserMetadata;
+                     }),
+      incompatibilities.end());
+
+  for (const auto& file : files) {
+    auto fileIndex = snapshot_->GetIndex(std::string(file.GetName()));
+    if (fileIndex.has_value() && fileIndex.value() != plugin) {
+      incompatibilities.push_back(
+          Incompatibility{fileIndex.value(), isUserMetadata});
+      incompatibleWith_[fileIndex.value()].push_back(
+          Incompatibility{plugin, isUserMetadata});
+    }
+  }
+}
+
+void ValidateGroups(const std::vector<Group>& masterlistGroups,
+                    const std::vector<Group>& userGroups) {
+  // Map each group to the groups that must load after it. Groups that are
+  // only referenced by others also get added, so defined groups are recorded
+  // separately.
+  std::map<std::string, std::vector<std::pair<std::string, EdgeType>>>
+      groupsAfter;
+  std::set<std::string> definedGroups;
+
+  auto addGroups = [&](const std::vector<Group>& groups, EdgeType type) {
+    for (const auto& group : groups) {
+      definedGroups.insert(group.GetName());
+      groupsAfter[group.GetName()];
+      for (const auto& afterGroup : group.GetAfterGroups()) {
+        groupsAfter[afterGroup].push_back(
+            std::make_pair(group.GetName(), type));
+      }
+    }
+  };
+
+  // The default group always exists.
+  addGroups({Group()}, EdgeType::masterlistLoadAfter);
+  addGroups(masterlistGroups, EdgeType::masterlistLoadAfter);
+  addGroups(userGroups, EdgeType::userLoadAfter);
+
+  for (const auto& entry : groupsAfter) {
+    if (definedGroups.count(entry.first) == 0) {
+      throw UndefinedGroupError(entry.first);
+    }
+  }
+
+  enum struct VisitState { unvisited, inProgress, finished };
+  std::map<std::string, VisitState> states;
+  std::vector<Vertex> path;
+
+  std::function<void(const std::string&)> visit =
+      [&](const std::string& groupName) {
+        states[groupName] = VisitState::inProgress;
+
+        for (const auto& [afterGroup, type] : groupsAfter[groupName]) {
+          path.push_back(Vertex(groupName, type));
+
+          auto state = states[afterGroup];
+          if (state == VisitState::inProgress) {
+            auto cycleStart = std::find_if(
+                path.begin(), path.end(), [&](const Vertex& vertex) {
+                  return vertex.GetName() == afterGroup;
+                });
+            throw CyclicInteractionError(
+                std::vector<Vertex>(cycleStart, path.end()));
+          } else if (state == VisitState::unvisited) {
+            visit(afterGroup);
+          }
+
+          path.pop_back();
+        }
+
+        states[groupName] = VisitState::finished;
+      };
+
+  for (const auto& entry : groupsAfter) {
+    if (states[entry.first] == VisitState::unvisited) {
+      visit(entry.first);
+    }
+  }
+}
+}
+}
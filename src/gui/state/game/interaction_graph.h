@@ -0,0 +1,110 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_GAME_INTERACTION_GRAPH
+#define LOOT_GUI_STATE_GAME_INTERACTION_GRAPH
+
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <loot/metadata/group.h>
+#include <loot/metadata/plugin_metadata.h>
+#include <loot/vertex.h>
+
+#include "gui/state/game/plugin_snapshot.h"
+
+namespace loot {
+namespace gui {
+// The interactions between a snapshot's plugins that sorting must not break:
+// the master flag, masters, requirements and load after metadata. Sorting
+// fails if these form a cycle, so edits to metadata can be checked against
+// the graph to find cycles without sorting. Only the plugin whose edges were
+// changed needs to be checked, as any new cycle must pass through it.
+//
+// Group membership is not part of the graph: sorting ignores group edges that
+// contradict other interactions, and which ones it ignores depends on every
+// plugin's groups, so cycles that involve groups are only found by sorting.
+class InteractionGraph {
+public:
+  explicit InteractionGraph(std::shared_ptr<const PluginSnapshot> snapshot);
+
+  std::shared_ptr<const PluginSnapshot> GetSnapshot() const;
+
+  // Replaces the edges that the given metadata's plugin gets from the
+  // masterlist or userlist. Metadata for plugins that are not in the snapshot
+  // is ignored.
+  void SetMetadata(const PluginMetadata& metadata, bool isUserMetadata);
+
+  // Returns the vertices of a cycle that the given plugin is part of, in the
+  // same form as a CyclicInteractionError thrown by sorting.
+  std::optional<std::vector<Vertex>> FindCycle(
+      const std::string& pluginName) const;
+
+  // Returns the names of the plugins whose requirements, load after or
+  // incompatibility metadata lists the given plugin.
+  std::set<std::string> GetDependentPlugins(
+      const std::string& pluginName) const;
+
+private:
+  struct Edge {
+    size_t plugin;
+    EdgeType type;
+  };
+
+  struct Incompatibility {
+    size_t plugin;
+    bool isUserMetadata;
+  };
+
+  void AddEdge(size_t fromPlugin, size_t toPlugin, EdgeType type);
+  void RemoveEdges(size_t toPlugin, EdgeType firstType, EdgeType secondType);
+  void SetIncompatibilities(size_t plugin,
+                            const std::vector<File>& files,
+                            bool isUserMetadata);
+
+  const std::shared_ptr<const PluginSnapshot> snapshot_;
+
+  // For each plugin, the plugins that must load after it.
+  std::vector<std::vector<Edge>> outgoingEdges_;
+  // For each plugin, the plugins that must load before it.
+  std::vector<std::vector<Edge>> incomingEdges_;
+  // Incompatibilities don't affect sorting, but are recorded in both
+  // directions so that the plugins that list a plugin can be found.
+  std::vector<std::vector<Incompatibility>> incompatibilities_;
+  std::vector<std::vector<Incompatibility>> incompatibleWith_;
+};
+
+// Throws an UndefinedGroupError if a group loads after a group that does not
+// exist, or a CyclicInteractionError if the groups' load after metadata forms
+// a cycle by itself. Cycles that also pass through plugins are not detected.
+void ValidateGroups(const std::vector<Group>& masterlistGroups,
+                    const std::vector<Group>& userGroups);
+}
+}
+
+#endif
@@ -0,0 +1,346 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/game/load_order_journal.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "gui/helpers.h"
+#include "gui/state/logging.h"
+#include "loot/exception/file_access_error.h"
+
+namespace loot {
+namespace gui {
+LoadOrderJournal::LoadOrderJournal(std::filesystem::path file,
+                                   size_t maxLoadOrders,
+                                   size_t checkpointInterval) :
+    file_(file),
+    maxLoadOrders_(std::max(maxLoadOrders, size_t(1))),
+    checkpointInterval_(std::max(checkpointInterval, size_t(1))),
+    isLoaded_(false),
+    entriesSinceCheckpoint_(0) {}
+
+void LoadOrderJournal::Record(const std::vector<std::string>& loadOrder) {
+  std::lock_guard<std::mutex> guard(mutex_);
+
+  Load();
+
+  auto entry = CreateEntry(lastLoadOrder_,
+                           loadOrder,
+                           entries_.empty() ||
+                               entriesSinceCheckpoint_ >= checkpointInterval_);
+  auto serialisedEntry = Serialise(entry);
+
+  std::ofstream out(file_, std::ios::binary | std::ios::app);
+  out.write(serialisedEntry.data(), serialisedEntry.size());
+  out.close();
+  if (out.fail()) {
+    throw FileAccessError("Failed to record the load order in " +
+                          file_.u8string());
+  }
+  // The record must be on disk before the load order it records is replaced.
+  SyncFile(file_);
+
+  entriesSinceCheckpoint_ =
+      entry.isCheckpoint ? 0 : entriesSinceCheckpoint_ + 1;
+  entries_.push_back(std::move(entry));
+  lastLoadOrder_ = loadOrder;
+
+  if (entries_.size() >= maxLoadOrders_ + checkpointInterval_) {
+    Compact();
+  }
+}
+
+size_t LoadOrderJournal::CountLoadOrders() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+
+  Load();
+
+  return entries_.size();
+}
+
+std::vector<std::string> LoadOrderJournal::GetLoadOrder(size_t age) const {
+  std::lock_guard<std::mutex> guard(mutex_);
+
+  Load();
+
+  if (age >= entries_.size()) {
+    throw std::out_of_range("Only " + std::to_string(entries_.size()) +
+                            " load orders have been recorded");
+  }
+
+  return GetLoadOrderUnlocked(entries_.size() - 1 - age);
+}
+
+void LoadOrderJournal::Load() const {
+  if (isLoaded_) {
+    return;
+  }
+  isLoaded_ = true;
+
+  if (!std::filesystem::exists(file_)) {
+    return;
+  }
+
+  std::ifstream in(file_, std::ios::binary);
+  if (!in.is_open()) {
+    throw FileAccessError("Failed to open the load order journal at " +
+                          file_.u8string());
+  }
+
+  // A record may have been cut short by a crash while it was being written,
+  // so only complete lines are read and parsing stops at the first bad one.
+  uintmax_t length = 0;
+  bool isAtEnd = false;
+  auto readLine = [&](std::string& line) {
+    if (!std::getline(in, line) || in.eof()) {
+      isAtEnd = true;
+      return false;
+    }
+    length += line.size() + 1;
+    return true;
+  };
+
+  uintmax_t validLength = 0;
+  std::string line;
+  while (readLine(line)) {
+    std::istringstream header(line);
+    char type = 0;
+    Entry entry;
+    header >> type >> entry.size;
+    size_t count = entry.size;
+    if (type == 'D') {
+      header >> count;
+    }
+
+    entry.isCheckpoint = type == 'C';
+    if (header.fail() || (type != 'C' && type != 'D') ||
+        (entries_.empty() && !entry.isCheckpoint) || count > entry.size) {
+      break;
+    }
+
+    bool isValid = true;
+    for (size_t i = 0; i < count && isValid; ++i) {
+      isValid = readLine(line);
+      if (!isValid) {
+        break;
+      }
+
+      if (entry.isCheckpoint) {
+        entry.changes.emplace_back(i, line);
+        continue;
+      }
+
+      auto separator = line.find('\t');
+      size_t position = 0;
+      try {
+        position = std::stoul(line.substr(0, separator));
+      } catch (...) {
+        isValid = false;
+      }
+      isValid = isValid && separator != std::string::npos &&
+                position < entry.size;
+      if (isValid) {
+        entry.changes.emplace_back(position, line.substr(separator + 1));
+      }
+    }
+
+    if (!isValid) {
+      break;
+    }
+
+    Apply(entry, lastLoadOrder_);
+    entriesSinceCheckpoint_ =
+        entry.isCheckpoint ? 0 : entriesSinceCheckpoint_ + 1;
+    entries_.push_back(std::move(entry));
+    validLength = length;
+  }
+  if (!isAtEnd) {
+    // Check if anything follows the bad record.
+    std::string rest;
+    isAtEnd = !std::getline(in, rest) || in.eof();
+  }
+  in.close();
+
+  if (validLength == std::filesystem::file_size(file_)) {
+    return;
+  }
+
+  auto logger = getLogger();
+  if (!isAtEnd) {
+    // Only the last record can have been cut short by a crash, so an earlier
+    // bad record means the journal has been corrupted. Move it out of the way
+    // instead of losing the records that follow the bad one.
+    auto backupFile = file_;
+    backupFile += ".bak";
+    std::filesystem::rename(file_, backupFile);
+
+    entries_.clear();
+    lastLoadOrder_.clear();
+    entriesSinceCheckpoint_ = 0;
+
+    if (logger) {
+      logger->error(
+          "The load order journal at {} is corrupt, moved it to {} and "
+          "started a new journal.",
+          file_.u8string(),
+          backupFile.u8string());
+    }
+    return;
+  }
+
+  if (logger) {
+    logger->warn(
+        "The load order journal at {} ends with an incomplete record, "
+        "discarding it.",
+        file_.u8string());
+  }
+  std::filesystem::resize_file(file_, validLength);
+}
+
+LoadOrderJournal::Entry LoadOrderJournal::CreateEntry(
+    const std::vector<std::string>& previousLoadOrder,
+    const std::vector<std::string>& loadOrder,
+    bool isCheckpoint) const {
+  Entry entry;
+  entry.size = loadOrder.size();
+  entry.isCheckpoint = isCheckpoint;
+
+  if (!isCheckpoint) {
+    for (size_t i = 0; i < loadOrder.size(); ++i) {
+      if (i >= previousLoadOrder.size() ||
+          loadOrder[i] != previousLoadOrder[i]) {
+        entry.changes.emplace_back(i, loadOrder[i]);
+      }
+    }
+
+    // A delta that changes most of the load order is no smaller than a
+    // checkpoint, so write a checkpoint instead.
+    entry.isCheckpoint = entry.changes.size() * 2 > loadOrder.size();
+  }
+
+  if (entry.isCheckpoint) {
+    entry.changes.clear();
+    for (size_t i = 0; i < loadOrder.size(); ++i) {
+      entry.changes.emplace_back(i, loadOrder[i]);
+    }
+  }
+
+  return entry;
+}
+
+std::vector<std::string> LoadOrderJournal::GetLoadOrderUnlocked(
+    size_t index) const {
+  // The first entry is always a checkpoint.
+  auto checkpoint = index;
+  while (!entries_[checkpoint].isCheckpoint) {
+    --checkpoint;
+  }
+
+  std::vector<std::string> loadOrder;
+  for (auto i = checkpoint; i <= index; ++i) {
+    Apply(entries_[i], loadOrder);
+  }
+
+  return loadOrder;
+}
+
+void LoadOrderJournal::Compact() {
+  auto firstIndex = entries_.size() - maxLoadOrders_;
+  auto loadOrder = GetLoadOrderUnlocked(firstIndex);
+
+  std::vector<Entry> entries;
+  std::vector<std::string> previousLoadOrder;
+  size_t entriesSinceCheckpoint = 0;
+  std::string contents;
+  for (auto i = firstIndex; i < entries_.size(); ++i) {
+    if (i > firstIndex) {
+      Apply(entries_[i], loadOrder);
+    }
+
+    auto entry = CreateEntry(previousLoadOrder,
+                             loadOrder,
+                             entries.empty() ||
+                                 entriesSinceCheckpoint >= checkpointInterval_);
+    entriesSinceCheckpoint =
+        entry.isCheckpoint ? 0 : entriesSinceCheckpoint + 1;
+    contents += Serialise(entry);
+    entries.push_back(std::move(entry));
+    previousLoadOrder = loadOrder;
+  }
+
+  // Write to a temporary file first so that the journal is replaced
+  // atomically.
+  auto tempFile = file_;
+  tempFile += ".tmp";
+  std::ofstream out(tempFile, std::ios::binary | std::ios::trunc);
+  out.write(contents.data(), contents.size());
+  out.close();
+  if (out.fail()) {
+    throw FileAccessError("Failed to compact the load order journal at " +
+                          file_.u8string());
+  }
+  SyncFile(tempFile);
+  std::filesystem::rename(tempFile, file_);
+
+  entries_ = std::move(entries);
+  entriesSinceCheckpoint_ = entriesSinceCheckpoint;
+}
+
+std::string LoadOrderJournal::Serialise(const Entry& entry) {
+  std::string serialisedEntry;
+  if (entry.isCheckpoint) {
+    serialisedEntry = "C " + std::to_string(entry.size) + "\n";
+    for (const auto& change : entry.changes) {
+      serialisedEntry += change.second + "\n";
+    }
+  } else {
+    serialisedEntry = "D " + std::to_string(entry.size) + " " +
+                      std::to_string(entry.changes.size()) + "\n";
+    for (const auto& change : entry.changes) {
+      serialisedEntry +=
+          std::to_string(change.first) + "\t" + change.second + "\n";
+    }
+  }
+
+  return serialisedEntry;
+}
+
+void LoadOrderJournal::Apply(const Entry& entry,
+                             std::vector<std::string>& loadOrder) {
+  if (entry.isCheckpoint) {
+    loadOrder.clear();
+  }
+
+  loadOrder.resize(entry.size);
+  for (const auto& change : entry.changes) {
+    loadOrder[change.first] = change.second;
+  }
+}
+}
+}
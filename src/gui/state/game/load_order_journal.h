@@ -0,0 +1,87 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_GAME_LOAD_ORDER_JOURNAL
+#define LOOT_GUI_STATE_GAME_LOAD_ORDER_JOURNAL
+
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace loot {
+namespace gui {
+// An append-only record of past load orders. Each load order is stored as the
+// positions that differ from the load order recorded before it, with a full
+// checkpoint written periodically and whenever that would be smaller. Every
+// record is a single write to the end of the file, which is synced before
+// Record() returns. Once the journal holds enough more than the retained
+// number of load orders, it is rewritten to drop the oldest. If a record other
+// than the last is bad, the file is moved aside and a new journal is started.
+class LoadOrderJournal {
+public:
+  explicit LoadOrderJournal(std::filesystem::path file,
+                            size_t maxLoadOrders = 50,
+                            size_t checkpointInterval = 10);
+
+  void Record(const std::vector<std::string>& loadOrder);
+
+  size_t CountLoadOrders() const;
+  // An age of zero gets the most recently recorded load order.
+  std::vector<std::string> GetLoadOrder(size_t age) const;
+
+private:
+  struct Entry {
+    bool isCheckpoint;
+    size_t size;
+    std::vector<std::pair<size_t, std::string>> changes;
+  };
+
+  void Load() const;
+  Entry CreateEntry(const std::vector<std::string>& previousLoadOrder,
+                    const std::vector<std::string>& loadOrder,
+                    bool isCheckpoint) const;
+  std::vector<std::string> GetLoadOrderUnlocked(size_t index) const;
+  void Compact();
+
+  static std::string Serialise(const Entry& entry);
+  static void Apply(const Entry& entry, std::vector<std::string>& loadOrder);
+
+  const std::filesystem::path file_;
+  const size_t maxLoadOrders_;
+  const size_t checkpointInterval_;
+
+  mutable bool isLoaded_;
+  mutable std::vector<Entry> entries_;
+  mutable std::vector<std::string> lastLoadOrder_;
+  mutable size_t entriesSinceCheckpoint_;
+
+  mutable std::mutex mutex_;
+};
+}
+}
+
+#endif
@@ -0,0 +1,307 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/game/load_order_profiles.h"
+
+#include <algorithm>
+#include <fstream>
+#include <unordered_set>
+
+#include <cpptoml.h>
+
+#include "gui/helpers.h"
+
+namespace loot {
+namespace gui {
+void LoadOrderProfiles::Load(const std::filesystem::path& file) {
+  plugins_.clear();
+  pluginIndices_.clear();
+  profiles_.clear();
+
+  if (!std::filesystem::exists(file)) {
+    return;
+  }
+
+  // Don't use cpptoml::parse_file() as it just uses a std stream,
+  // which don't support UTF-8 paths on Windows.
+  std::ifstream in(file);
+  if (!in.is_open())
+    throw cpptoml::parse_exception(file.u8string() +
+                                   " could not be opened for parsing");
+
+  auto root = cpptoml::parser(in).parse();
+
+  // Map the file's indices to this object's, in case the file holds filenames
+  // that are case-insensitively equal.
+  std::vector<size_t> pluginIndices;
+  auto plugins = root->get_array_of<std::string>("plugins");
+  if (plugins) {
+    for (const auto& plugin : *plugins) {
+      pluginIndices.push_back(AddPlugin(plugin));
+    }
+  }
+
+  auto profiles = root->get_table_array("profiles");
+  if (!profiles) {
+    return;
+  }
+
+  for (const auto& profile : *profiles) {
+    auto name = profile->get_as<std::string>("name");
+    auto loadOrder = profile->get_array_of<int64_t>("loadOrder");
+    if (!name || !loadOrder) {
+      continue;
+    }
+
+    std::vector<size_t> indices;
+    indices.reserve(loadOrder->size());
+    for (auto index : *loadOrder) {
+      if (index < 0 || static_cast<size_t>(index) >= pluginIndices.size()) {
+        throw std::runtime_error("The load order profile \"" + *name +
+                                 "\" contains an invalid plugin index.");
+      }
+      indices.push_back(pluginIndices[index]);
+    }
+    profiles_[*name] = indices;
+  }
+}
+
+void LoadOrderProfiles::Save(const std::filesystem::path& file) const {
+  // Only write the plugins that are still in a profile, reindexing them.
+  std::vector<std::string> plugins;
+  std::vector<std::optional<size_t>> savedIndices(plugins_.size());
+
+  auto profiles = cpptoml::make_table_array();
+  for (const auto& [name, indices] : profiles_) {
+    auto loadOrder = cpptoml::make_array();
+    for (auto index : indices) {
+      if (!savedIndices[index].has_value()) {
+        savedIndices[index] = plugins.size();
+        plugins.push_back(plugins_[index]);
+      }
+      loadOrder->push_back(static_cast<int64_t>(savedIndices[index].value()));
+    }
+
+    auto profile = cpptoml::make_table();
+    profile->insert("name", name);
+    profile->insert("loadOrder", loadOrder);
+    profiles->push_back(profile);
+  }
+
+  auto pluginsArray = cpptoml::make_array();
+  for (const auto& plugin : plugins) {
+    pluginsArray->push_back(plugin);
+  }
+
+  auto root = cpptoml::make_table();
+  root->insert("plugins", pluginsArray);
+  if (!profiles_.empty()) {
+    root->insert("profiles", profiles);
+  }
+
+  // Write to a temporary file and replace the profiles file with it, so that
+  // the profiles file is never left partially written.
+  auto tempFile = file;
+  tempFile += ".tmp";
+  {
+    std::ofstream out(tempFile);
+    out << *root;
+    if (!out) {
+      throw std::runtime_error("Failed to write " + tempFile.u8string());
+    }
+  }
+  SyncFile(tempFile);
+  std::filesystem::rename(tempFile, file);
+}
+
+std::vector<std::string> LoadOrderProfiles::GetNames() const {
+  std::vector<std::string> names;
+  names.reserve(profiles_.size());
+  for (const auto& profile : profiles_) {
+    names.push_back(profile.first);
+  }
+
+  return names;
+}
+
+std::optional<std::vector<std::string>> LoadOrderProfiles::GetLoadOrder(
+    const std::string& name) const {
+  auto profile = profiles_.find(name);
+  if (profile == profiles_.end()) {
+    return std::nullopt;
+  }
+
+  std::vector<std::string> loadOrder;
+  loadOrder.reserve(profile->second.size());
+  for (auto index : profile->second) {
+    loadOrder.push_back(plugins_[index]);
+  }
+
+  return loadOrder;
+}
+
+void LoadOrderProfiles::SetLoadOrder(
+    const std::string& name,
+    const std::vector<std::string>& loadOrder) {
+  std::vector<size_t> indices;
+  indices.reserve(loadOrder.size());
+  for (const auto& plugin : loadOrder) {
+    indices.push_back(AddPlugin(plugin));
+  }
+
+  profiles_[name] = indices;
+}
+
+bool LoadOrderProfiles::Remove(const std::string& name) {
+  return profiles_.erase(name) > 0;
+}
+
+size_t LoadOrderProfiles::AddPlugin(const std::string& pluginName) {
+  auto result =
+      pluginIndices_.emplace(NormalizeFilename(pluginName), plugins_.size());
+  if (result.second) {
+    plugins_.push_back(pluginName);
+  }
+
+  return result.first->second;
+}
+
+LoadOrderDiff DiffLoadOrders(const std::vector<std::string>& from,
+                             const std::vector<std::string>& to) {
+  LoadOrderDiff diff;
+
+  std::unordered_map<std::string, size_t> toPositions;
+  for (size_t i = 0; i < to.size(); ++i) {
+    toPositions.emplace(NormalizeFilename(to[i]), i);
+  }
+
+  std::unordered_set<std::string> fromPlugins;
+  std::vector<size_t> commonPositions;
+  for (const auto& plugin : from) {
+    auto key = NormalizeFilename(plugin);
+    fromPlugins.insert(key);
+
+    auto position = toPositions.find(key);
+    if (position == toPositions.end()) {
+      diff.removed.push_back(plugin);
+    } else {
+      commonPositions.push_back(position->second);
+    }
+  }
+
+  for (const auto& plugin : to) {
+    if (fromPlugins.count(NormalizeFilename(plugin)) == 0) {
+      diff.added.push_back(plugin);
+    }
+  }
+
+  // The plugins that don't need to move are the longest subsequence of the
+  // common plugins that has the same relative order in both load orders.
+  std::vector<size_t> tails;
+  std::vector<std::optional<size_t>> predecessors(commonPositions.size());
+  for (size_t i = 0; i < commonPositions.size(); ++i) {
+    auto tail = std::lower_bound(tails.begin(),
+                                 tails.end(),
+                                 commonPositions[i],
+                                 [&](size_t tailIndex, size_t position) {
+                                   return commonPositions[tailIndex] < position;
+                                 });
+    if (tail != tails.begin()) {
+      predecessors[i] = *(tail - 1);
+    }
+
+    if (tail == tails.end()) {
+      tails.push_back(i);
+    } else {
+      *tail = i;
+    }
+  }
+
+  std::vector<bool> isUnmoved(commonPositions.size(), false);
+  std::optional<size_t> current =
+      tails.empty() ? std::nullopt : std::optional<size_t>(tails.back());
+  while (current.has_value()) {
+    isUnmoved[current.value()] = true;
+    current = predecessors[current.value()];
+  }
+
+  for (size_t i = 0; i < commonPositions.size(); ++i) {
+    if (!isUnmoved[i]) {
+      diff.moved.push_back(to[commonPositions[i]]);
+    }
+  }
+
+  return diff;
+}
+
+std::vector<std::string> FitLoadOrder(
+    const std::vector<std::string>& profileLoadOrder,
+    const std::vector<std::string>& currentLoadOrder) {
+  std::unordered_map<std::string, std::string> installedPlugins;
+  for (const auto& plugin : currentLoadOrder) {
+    installedPlugins.emplace(NormalizeFilename(plugin), plugin);
+  }
+
+  std::unordered_set<std::string> profiledPlugins;
+  std::vector<std::string> profiledLoadOrder;
+  for (const auto& plugin : profileLoadOrder) {
+    auto key = NormalizeFilename(plugin);
+    auto installedPlugin = installedPlugins.find(key);
+    if (installedPlugin != installedPlugins.end() &&
+        profiledPlugins.insert(key).second) {
+      profiledLoadOrder.push_back(installedPlugin->second);
+    }
+  }
+
+  // Group each unprofiled plugin with the profiled plugin it follows.
+  std::vector<std::string> fittedLoadOrder;
+  std::unordered_map<std::string, std::vector<std::string>> followers;
+  std::optional<std::string> previousProfiledPlugin;
+  for (const auto& plugin : currentLoadOrder) {
+    auto key = NormalizeFilename(plugin);
+    if (profiledPlugins.count(key) > 0) {
+      previousProfiledPlugin = key;
+    } else if (previousProfiledPlugin.has_value()) {
+      followers[previousProfiledPlugin.value()].push_back(plugin);
+    } else {
+      fittedLoadOrder.push_back(plugin);
+    }
+  }
+
+  for (const auto& plugin : profiledLoadOrder) {
+    fittedLoadOrder.push_back(plugin);
+
+    auto pluginFollowers = followers.find(NormalizeFilename(plugin));
+    if (pluginFollowers != followers.end()) {
+      fittedLoadOrder.insert(fittedLoadOrder.end(),
+                             pluginFollowers->second.begin(),
+                             pluginFollowers->second.end());
+    }
+  }
+
+  return fittedLoadOrder;
+}
+}
+}
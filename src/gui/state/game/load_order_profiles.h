@@ -0,0 +1,83 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_GAME_LOAD_ORDER_PROFILES
+#define LOOT_GUI_STATE_GAME_LOAD_ORDER_PROFILES
+
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace loot {
+namespace gui {
+// Named load orders that can be applied without sorting. Each plugin filename
+// that appears in any profile is stored once, in a dictionary that
+// case-insensitively equal filenames share, and each profile is stored as an
+// array of indices into that dictionary.
+class LoadOrderProfiles {
+public:
+  // Replaces any profiles held with those in the given file, if it exists.
+  void Load(const std::filesystem::path& file);
+  void Save(const std::filesystem::path& file) const;
+
+  std::vector<std::string> GetNames() const;
+  std::optional<std::vector<std::string>> GetLoadOrder(
+      const std::string& name) const;
+
+  void SetLoadOrder(const std::string& name,
+                    const std::vector<std::string>& loadOrder);
+  bool Remove(const std::string& name);
+
+private:
+  size_t AddPlugin(const std::string& pluginName);
+
+  std::vector<std::string> plugins_;
+  std::unordered_map<std::string, size_t> pluginIndices_;
+  std::map<std::string, std::vector<size_t>> profiles_;
+};
+
+struct LoadOrderDiff {
+  std::vector<std::string> added;
+  std::vector<std::string> removed;
+  // The fewest plugins that must move to turn one order into the other.
+  std::vector<std::string> moved;
+};
+
+LoadOrderDiff DiffLoadOrders(const std::vector<std::string>& from,
+                             const std::vector<std::string>& to);
+
+// Fits a profile's load order to the installed plugins. Profiled plugins that
+// aren't installed are dropped, and installed plugins that aren't profiled
+// keep their position after the profiled plugin that they currently follow.
+std::vector<std::string> FitLoadOrder(
+    const std::vector<std::string>& profileLoadOrder,
+    const std::vector<std::string>& currentLoadOrder);
+}
+}
+
+#endif
@@ -0,0 +1,390 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/game/masterlist_snapshot.h"
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include "gui/helpers.h"
+#include "gui/state/logging.h"
+#include "loot/exception/file_access_error.h"
+
+namespace loot {
+namespace gui {
+namespace {
+// Identifies a snapshot file, and changes whenever the format does.
+constexpr char SNAPSHOT_MAGIC[] = "LOOTMLS1";
+
+class SnapshotWriter {
+public:
+  explicit SnapshotWriter(std::ostream& out) : out_(out) {}
+
+  void WriteUInt32(uint32_t value) {
+    char bytes[4];
+    for (size_t i = 0; i < 4; ++i) {
+      bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+    out_.write(bytes, sizeof(bytes));
+  }
+
+  void WriteBool(bool value) { out_.put(value ? 1 : 0); }
+
+  void WriteString(const std::string& value) {
+    WriteUInt32(static_cast<uint32_t>(value.size()));
+    out_.write(value.data(), value.size());
+  }
+
+  void WriteMessage(const Message& message) {
+    WriteUInt32(static_cast<uint32_t>(message.GetType()));
+
+    auto contents = message.GetContent();
+    WriteUInt32(static_cast<uint32_t>(contents.size()));
+    for (const auto& content : contents) {
+      WriteString(content.GetText());
+      WriteString(content.GetLanguage());
+    }
+  }
+
+  void WriteCleaningData(const PluginCleaningData& data) {
+    WriteUInt32(data.GetCRC());
+    WriteString(data.GetCleaningUtility());
+    WriteUInt32(data.GetITMCount());
+    WriteUInt32(data.GetDeletedReferenceCount());
+    WriteUInt32(data.GetDeletedNavmeshCount());
+  }
+
+private:
+  std::ostream& out_;
+};
+
+class SnapshotReader {
+public:
+  explicit SnapshotReader(std::istream& in) : in_(in) {}
+
+  uint32_t ReadUInt32() {
+    unsigned char bytes[4];
+    Read(reinterpret_cast<char*>(bytes), sizeof(bytes));
+
+    uint32_t value = 0;
+    for (size_t i = 0; i < 4; ++i) {
+      value |= static_cast<uint32_t>(bytes[i]) << (8 * i);
+    }
+    return value;
+  }
+
+  bool ReadBool() {
+    char value;
+    Read(&value, 1);
+    return value != 0;
+  }
+
+  std::string ReadString() {
+    std::string value(ReadUInt32(), '\0');
+    Read(value.data(), value.size());
+    return value;
+  }
+
+  Message ReadMessage() {
+    auto type = ReadUInt32();
+    if (type > static_cast<uint32_t>(MessageType::error)) {
+      throw std::runtime_error("invalid message type");
+    }
+
+    std::vector<MessageContent> contents(ReadUInt32());
+    for (auto& content : contents) {
+      auto text = ReadString();
+      content = MessageContent(text, ReadString());
+    }
+
+    return Message(static_cast<MessageType>(type), contents);
+  }
+
+  PluginCleaningData ReadCleaningData() {
+    auto crc = ReadUInt32();
+    auto utility = ReadString();
+    auto itmCount = ReadUInt32();
+    auto deletedReferenceCount = ReadUInt32();
+    auto deletedNavmeshCount = ReadUInt32();
+
+    return PluginCleaningData(crc,
+                              utility,
+                              {},
+                              itmCount,
+                              deletedReferenceCount,
+                              deletedNavmeshCount);
+  }
+
+private:
+  void Read(char* buffer, size_t count) {
+    if (!in_.read(buffer, count)) {
+      throw std::runtime_error("unexpected end of file");
+    }
+  }
+
+  std::istream& in_;
+};
+}
+
+MasterlistSnapshot::MasterlistSnapshot(const std::string& masterlistHash) :
+    masterlistHash_(masterlistHash) {}
+
+std::optional<MasterlistSnapshot> MasterlistSnapshot::Load(
+    const std::filesystem::path& file) {
+  std::ifstream in(file, std::ios::binary);
+  if (!in.is_open()) {
+    return std::nullopt;
+  }
+
+  try {
+    SnapshotReader reader(in);
+
+    std::string magic(sizeof(SNAPSHOT_MAGIC) - 1, '\0');
+    if (!in.read(magic.data(), magic.size()) || magic != SNAPSHOT_MAGIC) {
+      throw std::runtime_error("unrecognised format");
+    }
+
+    MasterlistSnapshot snapshot(reader.ReadString());
+
+    snapshot.generalMessages_.resize(reader.ReadUInt32());
+    for (auto& message : snapshot.generalMessages_) {
+      message = reader.ReadMessage();
+    }
+
+    snapshot.groups_.resize(reader.ReadUInt32());
+    for (auto& group : snapshot.groups_) {
+      auto name = reader.ReadString();
+      std::vector<std::string> afterGroups(reader.ReadUInt32());
+      for (auto& afterGroup : afterGroups) {
+        afterGroup = reader.ReadString();
+      }
+      group = Group(name, afterGroups);
+    }
+
+    snapshot.knownBashTags_.resize(reader.ReadUInt32());
+    for (auto& bashTag : snapshot.knownBashTags_) {
+      bashTag = reader.ReadString();
+    }
+
+    auto pluginCount = reader.ReadUInt32();
+    for (uint32_t i = 0; i < pluginCount; ++i) {
+      PluginMetadata metadata(reader.ReadString());
+
+      if (reader.ReadBool()) {
+        metadata.SetGroup(reader.ReadString());
+      }
+
+      std::vector<Tag> tags(reader.ReadUInt32());
+      for (auto& tag : tags) {
+        auto name = reader.ReadString();
+        tag = Tag(name, reader.ReadBool());
+      }
+      metadata.SetTags(tags);
+
+      std::vector<Message> messages(reader.ReadUInt32());
+      for (auto& message : messages) {
+        message = reader.ReadMessage();
+      }
+      metadata.SetMessages(messages);
+
+      std::vector<PluginCleaningData> dirtyInfo(reader.ReadUInt32());
+      for (auto& data : dirtyInfo) {
+        data = reader.ReadCleaningData();
+      }
+      metadata.SetDirtyInfo(dirtyInfo);
+
+      std::vector<PluginCleaningData> cleanInfo(reader.ReadUInt32());
+      for (auto& data : cleanInfo) {
+        data = reader.ReadCleaningData();
+      }
+      metadata.SetCleanInfo(cleanInfo);
+
+      snapshot.AddPluginMetadata(metadata);
+    }
+
+    return snapshot;
+  } catch (std::exception& e) {
+    auto logger = getLogger();
+    if (logger) {
+      logger->warn(
+          "Ignoring the masterlist snapshot at {} as it is invalid: {}",
+          file.u8string(),
+          e.what());
+    }
+    return std::nullopt;
+  }
+}
+
+void MasterlistSnapshot::Save(const std::filesystem::path& file) const {
+  // Write to a temporary file first so that an interrupted save can't leave
+  // a truncated snapshot behind.
+  auto tempFile = file;
+  tempFile += ".tmp";
+
+  {
+    std::ofstream out(tempFile, std::ios::binary | std::ios::trunc);
+    SnapshotWriter writer(out);
+
+    out.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC) - 1);
+    writer.WriteString(masterlistHash_);
+
+    writer.WriteUInt32(static_cast<uint32_t>(generalMessages_.size()));
+    for (const auto& message : generalMessages_) {
+      writer.WriteMessage(message);
+    }
+
+    writer.WriteUInt32(static_cast<uint32_t>(groups_.size()));
+    for (const auto& group : groups_) {
+      writer.WriteString(group.GetName());
+
+      auto afterGroups = group.GetAfterGroups();
+      writer.WriteUInt32(static_cast<uint32_t>(afterGroups.size()));
+      for (const auto& afterGroup : afterGroups) {
+        writer.WriteString(afterGroup);
+      }
+    }
+
+    writer.WriteUInt32(static_cast<uint32_t>(knownBashTags_.size()));
+    for (const auto& bashTag : knownBashTags_) {
+      writer.WriteString(bashTag);
+    }
+
+    writer.WriteUInt32(static_cast<uint32_t>(plugins_.size()));
+    for (const auto& [key, metadata] : plugins_) {
+      writer.WriteString(metadata.GetName());
+
+      auto group = metadata.GetGroup();
+      writer.WriteBool(group.has_value());
+      if (group.has_value()) {
+        writer.WriteString(group.value());
+      }
+
+      auto tags = metadata.GetTags();
+      writer.WriteUInt32(static_cast<uint32_t>(tags.size()));
+      for (const auto& tag : tags) {
+        writer.WriteString(tag.GetName());
+        writer.WriteBool(tag.IsAddition());
+      }
+
+      auto messages = metadata.GetMessages();
+      writer.WriteUInt32(static_cast<uint32_t>(messages.size()));
+      for (const auto& message : messages) {
+        writer.WriteMessage(message);
+      }
+
+      auto dirtyInfo = metadata.GetDirtyInfo();
+      writer.WriteUInt32(static_cast<uint32_t>(dirtyInfo.size()));
+      for (const auto& data : dirtyInfo) {
+        writer.WriteCleaningData(data);
+      }
+
+      auto cleanInfo = metadata.GetCleanInfo();
+      writer.WriteUInt32(static_cast<uint32_t>(cleanInfo.size()));
+      for (const auto& data : cleanInfo) {
+        writer.WriteCleaningData(data);
+      }
+    }
+
+    if (!out.good()) {
+      throw FileAccessError("Failed to write masterlist snapshot to " +
+                            tempFile.u8string());
+    }
+  }
+
+  std::filesystem::rename(tempFile, file);
+}
+
+const std::string& MasterlistSnapshot::GetMasterlistHash() const {
+  return masterlistHash_;
+}
+
+const std::vector<Message>& MasterlistSnapshot::GetGeneralMessages() const {
+  return generalMessages_;
+}
+
+const std::vector<Group>& MasterlistSnapshot::GetGroups() const {
+  return groups_;
+}
+
+const std::vector<std::string>& MasterlistSnapshot::GetKnownBashTags() const {
+  return knownBashTags_;
+}
+
+std::optional<PluginMetadata> MasterlistSnapshot::GetPluginMetadata(
+    const std::string& pluginName) const {
+  auto it = plugins_.find(NormalizeFilename(pluginName));
+  if (it == plugins_.end()) {
+    return std::nullopt;
+  }
+
+  return it->second;
+}
+
+void MasterlistSnapshot::SetGeneralMessages(
+    const std::vector<Message>& messages) {
+  generalMessages_ = messages;
+}
+
+void MasterlistSnapshot::SetGroups(const std::vector<Group>& groups) {
+  groups_ = groups;
+}
+
+void MasterlistSnapshot::SetKnownBashTags(
+    const std::vector<std::string>& bashTags) {
+  knownBashTags_ = bashTags;
+}
+
+void MasterlistSnapshot::AddPluginMetadata(const PluginMetadata& metadata) {
+  plugins_.insert_or_assign(NormalizeFilename(metadata.GetName()), metadata);
+}
+
+std::string HashMasterlist(const std::filesystem::path& masterlistPath) {
+  std::ifstream in(masterlistPath, std::ios::binary);
+  if (!in.is_open()) {
+    throw FileAccessError("Failed to open masterlist at " +
+                          masterlistPath.u8string());
+  }
+
+  // The hash must be stable across runs, so use 64-bit FNV-1a instead of
+  // std::hash.
+  uint64_t hash = 14695981039346656037ULL;
+  char buffer[64 * 1024];
+  while (in.read(buffer, sizeof(buffer)) || in.gcount() > 0) {
+    for (std::streamsize i = 0; i < in.gcount(); ++i) {
+      hash ^= static_cast<unsigned char>(buffer[i]);
+      hash *= 1099511628211ULL;
+    }
+  }
+
+  std::ostringstream stream;
+  stream << std::hex << std::setw(16) << std::setfill('0') << hash;
+
+  return stream.str();
+}
+}
+}
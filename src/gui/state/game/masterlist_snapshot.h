@@ -0,0 +1,81 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_GAME_MASTERLIST_SNAPSHOT
+#define LOOT_GUI_STATE_GAME_MASTERLIST_SNAPSHOT
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <loot/metadata/group.h>
+#include <loot/metadata/message.h>
+#include <loot/metadata/plugin_metadata.h>
+
+namespace loot {
+namespace gui {
+// The masterlist metadata that the UI displays, stored in a compact binary
+// file so that it can be displayed while libloot parses the masterlist. Plugin
+// metadata is stored with its conditions already evaluated, and only its
+// group, Bash Tag suggestions, messages and cleaning data are kept. The
+// snapshot records a hash of the masterlist that it was taken from, so that
+// an outdated snapshot can be ignored.
+class MasterlistSnapshot {
+public:
+  explicit MasterlistSnapshot(const std::string& masterlistHash);
+
+  // Returns std::nullopt if the file doesn't exist or isn't a valid snapshot.
+  static std::optional<MasterlistSnapshot> Load(
+      const std::filesystem::path& file);
+  void Save(const std::filesystem::path& file) const;
+
+  const std::string& GetMasterlistHash() const;
+  const std::vector<Message>& GetGeneralMessages() const;
+  const std::vector<Group>& GetGroups() const;
+  const std::vector<std::string>& GetKnownBashTags() const;
+  std::optional<PluginMetadata> GetPluginMetadata(
+      const std::string& pluginName) const;
+
+  void SetGeneralMessages(const std::vector<Message>& messages);
+  void SetGroups(const std::vector<Group>& groups);
+  void SetKnownBashTags(const std::vector<std::string>& bashTags);
+  void AddPluginMetadata(const PluginMetadata& metadata);
+
+private:
+  std::string masterlistHash_;
+  std::vector<Message> generalMessages_;
+  std::vector<Group> groups_;
+  std::vector<std::string> knownBashTags_;
+  std::unordered_map<std::string, PluginMetadata> plugins_;
+};
+
+// Hashes the contents of a masterlist file, to identify it in a snapshot.
+std::string HashMasterlist(const std::filesystem::path& masterlistPath);
+}
+}
+
+#endif
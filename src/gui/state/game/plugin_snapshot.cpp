@@ -0,0 +1,117 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/game/plugin_snapshot.h"
+
+#include <atomic>
+
+#include "gui/helpers.h"
+
+namespace loot {
+namespace gui {
+uint64_t GetNextSnapshotVersion() {
+  static std::atomic<uint64_t> nextVersion(0);
+
+  return nextVersion++;
+}
+
+PluginSnapshot::PluginSnapshot() : version_(GetNextSnapshotVersion()) {}
+
+PluginSnapshot::PluginSnapshot(
+    const std::vector<std::shared_ptr<const PluginInterface>>& plugins,
+    const std::function<bool(const std::string&)>& isPluginActive) :
+    version_(GetNextSnapshotVersion()),
+    plugins_(plugins) {
+  indexes_.reserve(plugins_.size());
+  isActive_.reserve(plugins_.size());
+  isMaster_.reserve(plugins_.size());
+  isLightMaster_.reserve(plugins_.size());
+  isEmpty_.reserve(plugins_.size());
+  loadsArchive_.reserve(plugins_.size());
+
+  for (size_t i = 0; i < plugins_.size(); ++i) {
+    const auto& plugin = plugins_[i];
+    const auto name = plugin->GetName();
+
+    indexes_.emplace(NormalizeFilename(name), i);
+
+    isActive_.push_back(isPluginActive(name));
+    isMaster_.push_back(plugin->IsMaster());
+    isLightMaster_.push_back(plugin->IsLightMaster());
+    isEmpty_.push_back(plugin->IsEmpty());
+    loadsArchive_.push_back(plugin->LoadsArchive());
+  }
+}
+
+uint64_t PluginSnapshot::GetVersion() const { return version_; }
+
+bool PluginSnapshot::IsEmpty() const { return plugins_.empty(); }
+
+size_t PluginSnapshot::Size() const { return plugins_.size(); }
+
+const std::vector<std::shared_ptr<const PluginInterface>>&
+PluginSnapshot::GetPlugins() const {
+  return plugins_;
+}
+
+std::optional<size_t> PluginSnapshot::GetIndex(
+    const std::string& pluginName) const {
+  auto it = indexes_.find(NormalizeFilename(pluginName));
+  if (it == indexes_.end()) {
+    return std::nullopt;
+  }
+
+  return it->second;
+}
+
+std::shared_ptr<const PluginInterface> PluginSnapshot::GetPlugin(
+    const std::string& pluginName) const {
+  auto index = GetIndex(pluginName);
+  if (!index.has_value()) {
+    return nullptr;
+  }
+
+  return plugins_.at(index.value());
+}
+
+bool PluginSnapshot::IsActive(size_t index) const {
+  return isActive_.at(index);
+}
+
+bool PluginSnapshot::IsMaster(size_t index) const {
+  return isMaster_.at(index);
+}
+
+bool PluginSnapshot::IsLightMaster(size_t index) const {
+  return isLightMaster_.at(index);
+}
+
+bool PluginSnapshot::IsEmpty(size_t index) const { return isEmpty_.at(index); }
+
+bool PluginSnapshot::LoadsArchive(size_t index) const {
+  return loadsArchive_.at(index);
+}
+}
+}
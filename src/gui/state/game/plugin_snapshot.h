@@ -0,0 +1,83 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_GAME_PLUGIN_SNAPSHOT
+#define LOOT_GUI_STATE_GAME_PLUGIN_SNAPSHOT
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "loot/plugin_interface.h"
+
+namespace loot {
+namespace gui {
+// An immutable view of a game's loaded plugins and their commonly-read flags.
+// A new snapshot is built each time plugins are loaded, and each snapshot has
+// a version number that is greater than that of any snapshot built before it.
+class PluginSnapshot {
+public:
+  PluginSnapshot();
+  PluginSnapshot(
+      const std::vector<std::shared_ptr<const PluginInterface>>& plugins,
+      const std::function<bool(const std::string&)>& isPluginActive);
+
+  uint64_t GetVersion() const;
+
+  bool IsEmpty() const;
+  size_t Size() const;
+
+  const std::vector<std::shared_ptr<const PluginInterface>>& GetPlugins() const;
+
+  // Plugin names are compared case-insensitively.
+  std::optional<size_t> GetIndex(const std::string& pluginName) const;
+  std::shared_ptr<const PluginInterface> GetPlugin(
+      const std::string& pluginName) const;
+
+  bool IsActive(size_t index) const;
+  bool IsMaster(size_t index) const;
+  bool IsLightMaster(size_t index) const;
+  bool IsEmpty(size_t index) const;
+  bool LoadsArchive(size_t index) const;
+
+private:
+  uint64_t version_;
+  std::vector<std::shared_ptr<const PluginInterface>> plugins_;
+  std::unordered_map<std::string, size_t> indexes_;
+
+  std::vector<bool> isActive_;
+  std::vector<bool> isMaster_;
+  std::vector<bool> isLightMaster_;
+  std::vector<bool> isEmpty_;
+  std::vector<bool> loadsArchive_;
+};
+}
+}
+
+#endif
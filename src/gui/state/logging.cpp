@@ -25,13 +25,44 @@
 
 #include "gui/state/logging.h"
 
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+
+#include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_sinks.h>
 
+#include "gui/state/trace_buffer.h"
+
 namespace loot {
 static const char* LOGGER_NAME = "loot_logger";
+// The number of messages that can be waiting to be written before logging
+// blocks until there's space.
+static constexpr size_t LOG_QUEUE_SIZE = 8192;
+static constexpr std::chrono::seconds LOG_FLUSH_INTERVAL(2);
+
+// Loggers are looked up in spdlog's registry under a lock, which is slow
+// enough to matter in loops, so each thread keeps a copy of the logger. The
+// generation is incremented whenever the logger is replaced, so that the
+// copies are refreshed.
+static std::mutex loggerMutex;
+static std::atomic<unsigned int> loggerGeneration(0);
+
+static void invalidateCachedLoggers() {
+  loggerGeneration.fetch_add(1, std::memory_order_release);
+}
 
 std::shared_ptr<spdlog::logger> getLogger() {
+  thread_local std::shared_ptr<spdlog::logger> cachedLogger;
+  thread_local unsigned int cachedGeneration = 0;
+
+  auto generation = loggerGeneration.load(std::memory_order_acquire);
+  if (cachedLogger && cachedGeneration == generation) {
+    return cachedLogger;
+  }
+
+  std::lock_guard<std::mutex> guard(loggerMutex);
   auto logger = spdlog::get(LOGGER_NAME);
 
   if (!logger) {
@@ -43,25 +74,47 @@ std::shared_ptr<spdlog::logger> getLogger() {
     }
   }
 
+  cachedLogger = logger;
+  cachedGeneration = loggerGeneration.load(std::memory_order_acquire);
+
   return logger;
 }
 
 void setLogPath(const std::filesystem::path& outputFile) {
   spdlog::set_pattern("[%T.%f] [%l]: %v");
 
+  // Messages are written to the file on a background thread, so that logging
+  // doesn't block on file I/O. The thread pool is shared by every logger
+  // created here, as a logger stops writing once its thread pool is gone.
+  if (!spdlog::thread_pool()) {
+    spdlog::init_thread_pool(LOG_QUEUE_SIZE, 1);
+    spdlog::flush_every(LOG_FLUSH_INTERVAL);
+    std::atexit(shutdownLogging);
+  }
+
+  std::lock_guard<std::mutex> guard(loggerMutex);
+  invalidateCachedLoggers();
   spdlog::drop(LOGGER_NAME);
 #if defined(_WIN32) && defined(SPDLOG_WCHAR_FILENAMES)
-  auto logger = spdlog::basic_logger_mt(LOGGER_NAME,
-                                        outputFile.wstring());
+  auto logger = spdlog::basic_logger_mt<spdlog::async_factory>(
+      LOGGER_NAME, outputFile.wstring());
 #else
-  auto logger = spdlog::basic_logger_mt(LOGGER_NAME,
-                                        outputFile.u8string());
+  auto logger = spdlog::basic_logger_mt<spdlog::async_factory>(
+      LOGGER_NAME, outputFile.u8string());
 #endif
 
   if (!logger) {
     throw std::runtime_error("Error: Could not initialise logging.");
   }
-  logger->flush_on(spdlog::level::trace);
+  // Flushing is also done periodically, but make sure that problems are
+  // written out straight away in case LOOT is about to crash.
+  logger->flush_on(spdlog::level::warn);
+}
+
+void shutdownLogging() {
+  std::lock_guard<std::mutex> guard(loggerMutex);
+  invalidateCachedLoggers();
+  spdlog::shutdown();
 }
 
 void enableDebugLogging(bool enable) {
@@ -74,4 +127,27 @@ void enableDebugLogging(bool enable) {
     }
   }
 }
+
+static TraceBuffer& getTraceBuffer() {
+  static TraceBuffer traceBuffer;
+  return traceBuffer;
+}
+
+void recordTraceEvent(const char* message, std::string_view detail) {
+  getTraceBuffer().Record(message, detail);
+}
+
+void logRecentTraceEvents(const std::string& reason) {
+  auto logger = getLogger();
+  if (!logger) {
+    return;
+  }
+
+  std::string events;
+  for (const auto& line : getTraceBuffer().Format()) {
+    events += "\n  " + line;
+  }
+
+  logger->error("{}. Recent trace events:{}", reason, events);
+}
 }
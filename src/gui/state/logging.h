@@ -29,15 +29,55 @@
 #define SPDLOG_WCHAR_FILENAMES
 
 #include <filesystem>
+#include <string>
+#include <string_view>
 
 #include <spdlog/spdlog.h>
 
+// Logs a message if the logger exists and its level lets the message through.
+// Unlike calling the logger directly, the message's arguments are only
+// evaluated if it will be logged, so this can be used in hot loops.
+#define LOOT_LOG(logger, level, ...)                      \
+  do {                                                    \
+    const auto& lootLogger = (logger);                    \
+    if (lootLogger && lootLogger->should_log(level)) {    \
+      lootLogger->log(level, __VA_ARGS__);                \
+    }                                                     \
+  } while (false)
+
+#define LOOT_LOG_TRACE(logger, ...) \
+  LOOT_LOG(logger, spdlog::level::trace, __VA_ARGS__)
+#define LOOT_LOG_DEBUG(logger, ...) \
+  LOOT_LOG(logger, spdlog::level::debug, __VA_ARGS__)
+#define LOOT_LOG_INFO(logger, ...) \
+  LOOT_LOG(logger, spdlog::level::info, __VA_ARGS__)
+#define LOOT_LOG_WARN(logger, ...) \
+  LOOT_LOG(logger, spdlog::level::warn, __VA_ARGS__)
+#define LOOT_LOG_ERROR(logger, ...) \
+  LOOT_LOG(logger, spdlog::level::err, __VA_ARGS__)
+
 namespace loot {
+// The logger is cached, so this doesn't look it up in spdlog's registry
+// unless logging has yet to be set up or has been shut down.
 std::shared_ptr<spdlog::logger> getLogger();
 
+// Messages are written to the given file asynchronously. Warnings and errors
+// are flushed immediately, and everything else is flushed periodically and on
+// exit.
 void setLogPath(const std::filesystem::path& outputFile);
 
+// Writes out any queued messages and stops logging. This is done on exit.
+void shutdownLogging();
+
 void enableDebugLogging(bool enable);
+
+// Records an event in a buffer of recent events that is kept whatever the log
+// level. The message must outlive the program, e.g. be a string literal.
+void recordTraceEvent(const char* message, std::string_view detail = {});
+
+// Writes the recently recorded trace events to the log as an error, so that
+// they're logged even when debug logging is disabled.
+void logRecentTraceEvents(const std::string& reason);
 }
 
 #endif
@@ -30,6 +30,7 @@
 
 #include <cpptoml.h>
 
+#include "gui/helpers.h"
 #include "gui/state/logging.h"
 #include "gui/state/loot_paths.h"
 #include "gui/version.h"
@@ -40,6 +41,19 @@ using std::string;
 using std::filesystem::u8path;
 
 namespace loot {
+static constexpr std::chrono::milliseconds SETTINGS_WRITE_DELAY(500);
+
+// Returns true if the value was changed.
+template<typename T>
+bool setIfChanged(T& current, const T& value) {
+  if (current == value) {
+    return false;
+  }
+
+  current = value;
+  return true;
+}
+
 GameSettings convert(const std::shared_ptr<cpptoml::table>& table,
                      const std::filesystem::path& lootDataPath) {
   GameSettings game;
@@ -204,10 +218,13 @@ LootSettings::LootSettings() :
     enableDebugLogging_(false),
     updateMasterlist_(true),
     enableLootUpdateCheck_(true),
+    gameCacheMemoryBudget_(512),
     game_("auto"),
     language_("en"),
     theme_("default"),
-    lastGame_("auto") {}
+    lastGame_("auto"),
+    isDirty_(false),
+    writer_(SETTINGS_WRITE_DELAY) {}
 
 void LootSettings::load(const std::filesystem::path& file,
                         const std::filesystem::path& lootDataPath) {
@@ -228,6 +245,9 @@ void LootSettings::load(const std::filesystem::path& file,
       settings->get_as<bool>("updateMasterlist").value_or(updateMasterlist_);
   enableLootUpdateCheck_ = settings->get_as<bool>("enableLootUpdateCheck")
                                .value_or(enableLootUpdateCheck_);
+  gameCacheMemoryBudget_ =
+      settings->get_as<unsigned int>("gameCacheMemoryBudget")
+          .value_or(gameCacheMemoryBudget_);
   game_ = settings->get_as<std::string>("game").value_or(game_);
   language_ = settings->get_as<std::string>("language").value_or(language_);
   theme_ = settings->get_as<std::string>("theme").value_or(theme_);
@@ -284,16 +304,24 @@ void LootSettings::load(const std::filesystem::path& file,
       languages_.push_back(convert(language));
     }
   }
+
+  isDirty_ = false;
 }
 
 void LootSettings::save(const std::filesystem::path& file) {
   lock_guard<recursive_mutex> guard(mutex_);
 
+  if (!isDirty_ && std::filesystem::exists(file)) {
+    return;
+  }
+
   auto root = cpptoml::make_table();
 
   root->insert("enableDebugLogging", enableDebugLogging_);
   root->insert("updateMasterlist", updateMasterlist_);
   root->insert("enableLootUpdateCheck", enableLootUpdateCheck_);
+  root->insert("gameCacheMemoryBudget",
+               static_cast<int64_t>(gameCacheMemoryBudget_));
   root->insert("game", game_);
   root->insert("language", language_);
   root->insert("theme", theme_);
@@ -355,10 +383,36 @@ void LootSettings::save(const std::filesystem::path& file) {
     root->insert("languages", languageTables);
   }
 
-  std::ofstream out(file);
-  out << *root;
+  // Write to a temporary file and replace the settings file with it, so that
+  // the settings file is never left partially written.
+  auto tempFile = file;
+  tempFile += ".tmp";
+  {
+    std::ofstream out(tempFile);
+    out << *root;
+    if (!out) {
+      throw std::runtime_error("Failed to write " + tempFile.u8string());
+    }
+  }
+  SyncFile(tempFile);
+  std::filesystem::rename(tempFile, file);
+
+  isDirty_ = false;
+
+  auto logger = getLogger();
+  if (logger) {
+    logger->debug("Saved settings to {}", file.u8string());
+  }
+}
+
+void LootSettings::enableAutoSave(const std::filesystem::path& file) {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  autoSaveFile_ = file;
 }
 
+void LootSettings::flushAutoSave() { writer_.Flush(); }
+
 bool LootSettings::shouldAutoSort() const {
   lock_guard<recursive_mutex> guard(mutex_);
 
@@ -383,6 +437,12 @@ bool LootSettings::isLootUpdateCheckEnabled() const {
   return enableLootUpdateCheck_;
 }
 
+unsigned int LootSettings::getGameCacheMemoryBudget() const {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  return gameCacheMemoryBudget_;
+}
+
 std::string LootSettings::getGame() const {
   lock_guard<recursive_mutex> guard(mutex_);
 
@@ -441,19 +501,25 @@ const std::vector<LootSettings::Language>& LootSettings::getLanguages() const {
 void LootSettings::setDefaultGame(const std::string& game) {
   lock_guard<recursive_mutex> guard(mutex_);
 
-  game_ = game;
+  if (setIfChanged(game_, game)) {
+    onChange();
+  }
 }
 
 void LootSettings::setLanguage(const std::string& language) {
   lock_guard<recursive_mutex> guard(mutex_);
 
-  language_ = language;
+  if (setIfChanged(language_, language)) {
+    onChange();
+  }
 }
 
 void LootSettings::setTheme(const std::string& theme) {
   lock_guard<recursive_mutex> guard(mutex_);
 
-  theme_ = theme;
+  if (setIfChanged(theme_, theme)) {
+    onChange();
+  }
 }
 
 void LootSettings::setAutoSort(bool autoSort) {
@@ -465,51 +531,88 @@ void LootSettings::setAutoSort(bool autoSort) {
 void LootSettings::enableDebugLogging(bool enable) {
   lock_guard<recursive_mutex> guard(mutex_);
 
-  enableDebugLogging_ = enable;
+  if (setIfChanged(enableDebugLogging_, enable)) {
+    onChange();
+  }
   loot::enableDebugLogging(enable);
 }
 
 void LootSettings::updateMasterlist(bool update) {
   lock_guard<recursive_mutex> guard(mutex_);
 
-  updateMasterlist_ = update;
+  if (setIfChanged(updateMasterlist_, update)) {
+    onChange();
+  }
 }
 
 void LootSettings::enableLootUpdateCheck(bool enable) {
   lock_guard<recursive_mutex> guard(mutex_);
 
-  enableLootUpdateCheck_ = enable;
+  if (setIfChanged(enableLootUpdateCheck_, enable)) {
+    onChange();
+  }
+}
+
+void LootSettings::setGameCacheMemoryBudget(unsigned int megabytes) {
+  lock_guard<recursive_mutex> guard(mutex_);
+
+  if (setIfChanged(gameCacheMemoryBudget_, megabytes)) {
+    onChange();
+  }
 }
 
 void LootSettings::storeLastGame(const std::string& lastGame) {
   lock_guard<recursive_mutex> guard(mutex_);
 
-  this->lastGame_ = lastGame;
+  if (setIfChanged(lastGame_, lastGame)) {
+    onChange();
+  }
 }
 
 void LootSettings::storeWindowPosition(const WindowPosition& position) {
   lock_guard<recursive_mutex> guard(mutex_);
 
+  if (windowPosition_.has_value() &&
+      windowPosition_.value().top == position.top &&
+      windowPosition_.value().bottom == position.bottom &&
+      windowPosition_.value().left == position.left &&
+      windowPosition_.value().right == position.right &&
+      windowPosition_.value().maximised == position.maximised) {
+    return;
+  }
+
   windowPosition_ = position;
+  onChange();
 }
 
 void LootSettings::storeGameSettings(
     const std::vector<GameSettings>& gameSettings) {
   lock_guard<recursive_mutex> guard(mutex_);
 
+  // GameSettings equality only compares names and folders, so always treat
+  // the settings as changed.
   this->gameSettings_ = gameSettings;
+  onChange();
 }
 
 void LootSettings::storeFilterState(const std::string& filterId, bool enabled) {
   lock_guard<recursive_mutex> guard(mutex_);
 
+  auto it = filters_.find(filterId);
+  if (it != filters_.end() && it->second == enabled) {
+    return;
+  }
+
   filters_[filterId] = enabled;
+  onChange();
 }
 
 void LootSettings::updateLastVersion() {
   lock_guard<recursive_mutex> guard(mutex_);
 
-  lastVersion_ = gui::Version::string();
+  if (setIfChanged(lastVersion_, gui::Version::string())) {
+    onChange();
+  }
 }
 
 void LootSettings::appendBaseGames() {
@@ -558,4 +661,12 @@ void LootSettings::appendBaseGames() {
            GameSettings(GameType::fo4vr)) == end(gameSettings_))
     gameSettings_.push_back(GameSettings(GameType::fo4vr));
 }
+
+void LootSettings::onChange() {
+  isDirty_ = true;
+
+  if (autoSaveFile_.has_value()) {
+    writer_.Schedule([this, file = autoSaveFile_.value()]() { save(file); });
+  }
+}
 }
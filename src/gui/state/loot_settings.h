@@ -33,6 +33,7 @@
 #include <string>
 #include <vector>
 
+#include "gui/state/debounced_writer.h"
 #include "gui/state/game/game_settings.h"
 
 namespace loot {
@@ -58,7 +59,16 @@ public:
 
   void load(const std::filesystem::path& file,
             const std::filesystem::path& lootDataPath);
+  // Replaces the file atomically. Nothing is written if no settings have
+  // changed since they were last loaded or saved, unless the file doesn't
+  // exist.
   void save(const std::filesystem::path& file);
+  // Once enabled, changes are saved to the given file in the background
+  // shortly after they're made, and a burst of changes is saved in one write.
+  void enableAutoSave(const std::filesystem::path& file);
+  // Blocks until any pending auto-save has completed, and throws if an
+  // auto-save has failed since the last flush.
+  void flushAutoSave();
 
   bool shouldAutoSort() const;
   bool isDebugLoggingEnabled() const;
@@ -69,6 +79,7 @@ public:
   std::string getLastVersion() const;
   std::string getLanguage() const;
   std::string getTheme() const;
+  unsigned int getGameCacheMemoryBudget() const;
   std::optional<WindowPosition> getWindowPosition() const;
   const std::vector<GameSettings>& getGameSettings() const;
   const std::map<std::string, bool>& getFilters() const;
@@ -81,6 +92,7 @@ public:
   void enableDebugLogging(bool enable);
   void updateMasterlist(bool update);
   void enableLootUpdateCheck(bool enable);
+  void setGameCacheMemoryBudget(unsigned int megabytes);
 
   void storeLastGame(const std::string& lastGame);
   void storeWindowPosition(const WindowPosition& position);
@@ -93,6 +105,8 @@ private:
   bool enableDebugLogging_;
   bool updateMasterlist_;
   bool enableLootUpdateCheck_;
+  // In MiB.
+  unsigned int gameCacheMemoryBudget_;
   std::string game_;
   std::string lastGame_;
   std::string lastVersion_;
@@ -102,10 +116,17 @@ private:
   std::vector<GameSettings> gameSettings_;
   std::map<std::string, bool> filters_;
   std::vector<Language> languages_;
+  bool isDirty_;
+  std::optional<std::filesystem::path> autoSaveFile_;
 
   mutable std::recursive_mutex mutex_;
+  // Declared last so that a pending save runs before the other members are
+  // destroyed.
+  DebouncedWriter writer_;
 
   void appendBaseGames();
+  // Must be called with the mutex locked.
+  void onChange();
 };
 }
 
@@ -65,6 +65,8 @@ namespace fs = std::filesystem;
 
 namespace loot {
 void apiLogCallback(LogLevel level, const char* message) {
+  recordTraceEvent("libloot", message);
+
   auto logger = getLogger();
   if (!logger) {
     return;
@@ -95,6 +97,16 @@ void apiLogCallback(LogLevel level, const char* message) {
   }
 }
 
+locale generateLocale(const std::filesystem::path& l10nPath,
+                      const std::string& language) {
+  // Boost.Locale initialisation: Specify location of language dictionaries.
+  boost::locale::generator gen;
+  gen.add_messages_path(l10nPath.u8string());
+  gen.add_messages_domain("loot");
+
+  return gen(language + ".UTF-8");
+}
+
 LootState::LootState(const std::filesystem::path& lootAppPath,
                      const std::filesystem::path& lootDataPath) :
     LootPaths(lootAppPath, lootDataPath) {}
@@ -109,13 +121,11 @@ void LootState::init(const std::string& cmdLineGame, bool autoSort) {
 
   // Do some preliminary locale / UTF-8 support setup here, in case the settings
   // file reading requires it.
-  // Boost.Locale initialisation: Specify location of language dictionaries.
-  boost::locale::generator gen;
-  gen.add_messages_path(LootPaths::getL10nPath().u8string());
-  gen.add_messages_domain("loot");
-
   // Boost.Locale initialisation: Generate and imbue locales.
-  locale::global(gen("en.UTF-8"));
+  {
+    Timeline::ScopedSpan span(startupTimeline_, "Default locale generation");
+    locale::global(generateLocale(LootPaths::getL10nPath(), "en"));
+  }
 
   // Check if the LOOT local app data folder exists, and create it if not.
   if (!fs::exists(LootPaths::getLootDataPath())) {
@@ -130,6 +140,7 @@ void LootState::init(const std::string& cmdLineGame, bool autoSort) {
     }
   }
   if (fs::exists(LootPaths::getSettingsPath())) {
+    Timeline::ScopedSpan span(startupTimeline_, "Settings parsing");
     try {
       LootSettings::load(LootPaths::getSettingsPath(), LootPaths::getLootDataPath());
     } catch (exception& e) {
@@ -140,10 +151,17 @@ void LootState::init(const std::string& cmdLineGame, bool autoSort) {
   }
 
   // Set up logging.
-  fs::remove(LootPaths::getLogPath());
-  setLogPath(LootPaths::getLogPath());
-  SetLoggingCallback(apiLogCallback);
-  enableDebugLogging(isDebugLoggingEnabled());
+  {
+    Timeline::ScopedSpan span(startupTimeline_, "Logging setup");
+    fs::remove(LootPaths::getLogPath());
+    setLogPath(LootPaths::getLogPath());
+    SetLoggingCallback(apiLogCallback);
+    enableDebugLogging(isDebugLoggingEnabled());
+  }
+
+  // Save settings changes as they're made from now on, so that they aren't
+  // lost if LOOT doesn't exit cleanly.
+  enableAutoSave(LootPaths::getSettingsPath());
 
   // Log some useful info.
   auto logger = getLogger();
@@ -163,18 +181,81 @@ void LootState::init(const std::string& cmdLineGame, bool autoSort) {
   }
 #endif
 
+  // The rest of initialisation is independent of the UI, so run it in the
+  // background while the UI starts up.
+  gamesInitialisation_ =
+      std::async(std::launch::async, [this, cmdLineGame]() {
+        return InitialiseGames(cmdLineGame);
+      });
+}
+
+void LootState::waitForInit() {
+  if (!gamesInitialisation_.valid()) {
+    return;
+  }
+
+  auto newLocale = gamesInitialisation_.get();
+
   // Now that settings have been loaded, set the locale again to handle
-  // translations.
-  if (getLanguage() != MessageContent::defaultLanguage) {
+  // translations. This isn't done by InitialiseGames(), as the global locale
+  // must not be changed while the UI thread may be using it.
+  if (newLocale.has_value()) {
+    auto logger = getLogger();
     if (logger) {
       logger->debug("Initialising language settings.");
       logger->debug("Selected language: {}", getLanguage());
     }
 
-    // Boost.Locale initialisation: Generate and imbue locales.
-    locale::global(gen(getLanguage() + ".UTF-8"));
+    // Boost.Locale initialisation: Imbue the generated locale.
+    locale::global(newLocale.value());
   }
 
+  startupTimeline_.Log("Startup timeline");
+}
+
+Timeline& LootState::getStartupTimeline() { return startupTimeline_; }
+
+const std::vector<std::string>& LootState::getInitErrors() const {
+  return initErrors_;
+}
+
+void LootState::storeLastGameAndVersion() {
+  try {
+    storeLastGame(GetCurrentGame().FolderName());
+  } catch (std::runtime_error& e) {
+    auto logger = getLogger();
+    if (logger) {
+      logger->error("Couldn't set last game: {}", e.what());
+    }
+  }
+  updateLastVersion();
+}
+
+void LootState::save(const std::filesystem::path& file) {
+  storeLastGameAndVersion();
+  LootSettings::save(file);
+}
+
+void LootState::InitialiseGameData(gui::Game& game) {
+  game.Init();
+}
+
+std::optional<locale> LootState::InitialiseGames(
+    const std::string& cmdLineGame) {
+  auto logger = getLogger();
+
+  // Generating a locale can be slow, and is independent of game detection.
+  std::future<std::optional<locale>> languageLocale =
+      std::async(std::launch::async, [this]() -> std::optional<locale> {
+        if (getLanguage() == MessageContent::defaultLanguage) {
+          return std::nullopt;
+        }
+
+        Timeline::ScopedSpan span(startupTimeline_,
+                                  "Language locale generation");
+        return generateLocale(LootPaths::getL10nPath(), getLanguage());
+      });
+
   // Detect games & select startup game
   //-----------------------------------
 
@@ -182,9 +263,17 @@ void LootState::init(const std::string& cmdLineGame, bool autoSort) {
   if (logger) {
     logger->debug("Detecting installed games.");
   }
-  LoadInstalledGames(getGameSettings(), LootPaths::getLootDataPath());
+  SetWarmGamesMemoryBudget(static_cast<size_t>(getGameCacheMemoryBudget()) *
+                           1024 * 1024);
+  {
+    Timeline::ScopedSpan span(startupTimeline_, "Game detection");
+    LoadInstalledGames(getGameSettings(), LootPaths::getLootDataPath());
+  }
+
+  auto newLocale = languageLocale.get();
 
   try {
+    Timeline::ScopedSpan span(startupTimeline_, "Game initialisation");
     SetInitialGame(cmdLineGame);
     if (logger) {
       logger->debug("Game selected is {}", GetCurrentGame().Name());
@@ -194,37 +283,17 @@ void LootState::init(const std::string& cmdLineGame, bool autoSort) {
       logger->error("Game-specific settings could not be initialised: {}",
                      e.what());
     }
+    // Translate using the new locale, as it hasn't been imbued yet.
     initErrors_.push_back(
         (format(translate(
-             "Error: Game-specific settings could not be initialised. %1%")) %
+                    "Error: Game-specific settings could not be initialised. "
+                    "%1%")
+                    .str(newLocale.value_or(locale()))) %
          e.what())
             .str());
   }
-}
 
-const std::vector<std::string>& LootState::getInitErrors() const {
-  return initErrors_;
-}
-
-void LootState::save(const std::filesystem::path& file) {
-  try {
-    storeLastGame(GetCurrentGame().FolderName());
-  } catch (std::runtime_error& e) {
-    auto logger = getLogger();
-    if (logger) {
-      logger->error("Couldn't set last game: {}", e.what());
-    }
-  }
-  updateLastVersion();
-  LootSettings::save(file);
-}
-
-std::optional<std::filesystem::path> LootState::FindGamePath(const GameSettings& gameSettings) const {
-  return gameSettings.FindGamePath();
-}
-
-void LootState::InitialiseGameData(gui::Game& game) {
-  game.Init();
+  return newLocale;
 }
 
 void LootState::SetInitialGame(std::string preferredGame) {
@@ -26,8 +26,13 @@
 #ifndef LOOT_GUI_STATE_LOOT_STATE
 #define LOOT_GUI_STATE_LOOT_STATE
 
+#include <future>
+#include <locale>
+#include <optional>
+
 #include "gui/state/game/games_manager.h"
 #include "gui/state/loot_settings.h"
+#include "gui/state/timeline.h"
 #include "gui/state/unapplied_change_counter.h"
 
 namespace loot {
@@ -36,20 +41,32 @@ public:
   LootState(const std::filesystem::path& lootAppPath, 
             const std::filesystem::path& lootDataPath);
 
+  // Game detection and initialisation continue in the background after this
+  // returns: call waitForInit() before using any game state.
   void init(const std::string& cmdLineGame, bool autoSort);
+  void waitForInit();
   const std::vector<std::string>& getInitErrors() const;
 
+  Timeline& getStartupTimeline();
+
+  // Stores the current game as the last game and records the current LOOT
+  // version, so that they're saved with the other settings.
+  void storeLastGameAndVersion();
   void save(const std::filesystem::path& file);
 
   void storeGameSettings(std::vector<GameSettings> gameSettings);
 
 private:
-  std::optional<std::filesystem::path> FindGamePath(const GameSettings& gameSettings) const;
   void InitialiseGameData(gui::Game& game);
 
+  // Returns the locale for the selected language, if it's not the default
+  // language, so that it can be imbued on the thread that's using the UI.
+  std::optional<std::locale> InitialiseGames(const std::string& cmdLineGame);
   void SetInitialGame(std::string cmdLineGame);
 
   std::vector<std::string> initErrors_;
+  std::future<std::optional<std::locale>> gamesInitialisation_;
+  Timeline startupTimeline_;
 
   // Mutex used to protect access to member variables.
   std::mutex mutex_;
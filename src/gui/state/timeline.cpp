@@ -0,0 +1,90 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/timeline.h"
+
+#include <algorithm>
+#include <map>
+
+#include "gui/state/logging.h"
+
+using std::chrono::duration_cast;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+
+namespace loot {
+Timeline::ScopedSpan::ScopedSpan(Timeline& timeline, const std::string& name) :
+    timeline_(timeline),
+    name_(name),
+    start_(steady_clock::now()) {}
+
+Timeline::ScopedSpan::~ScopedSpan() {
+  timeline_.Record(name_, start_, steady_clock::now());
+}
+
+Timeline::Timeline() : origin_(steady_clock::now()) {}
+
+void Timeline::Record(const std::string& name,
+                      steady_clock::time_point start,
+                      steady_clock::time_point end) {
+  std::lock_guard<std::mutex> guard(mutex_);
+
+  spans_.push_back(Span{name, start, end, std::this_thread::get_id()});
+}
+
+std::vector<Timeline::Span> Timeline::GetSpans() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+
+  return spans_;
+}
+
+void Timeline::Log(const std::string& title) const {
+  auto logger = getLogger();
+  if (!logger) {
+    return;
+  }
+
+  auto spans = GetSpans();
+  std::stable_sort(spans.begin(), spans.end(), [](const Span& a, const Span& b) {
+    return a.start < b.start;
+  });
+
+  // Thread IDs aren't very readable, so number threads in order of use.
+  std::map<std::thread::id, size_t> threadNumbers;
+  for (const auto& span : spans) {
+    threadNumbers.emplace(span.threadId, threadNumbers.size());
+  }
+
+  logger->info("{}:", title);
+  for (const auto& span : spans) {
+    logger->info("  {:>6} ms - {:>6} ms ({:>5} ms) [thread {}] {}",
+                 duration_cast<milliseconds>(span.start - origin_).count(),
+                 duration_cast<milliseconds>(span.end - origin_).count(),
+                 duration_cast<milliseconds>(span.end - span.start).count(),
+                 threadNumbers.at(span.threadId),
+                 span.name);
+  }
+}
+}
@@ -0,0 +1,80 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_TIMELINE
+#define LOOT_GUI_STATE_TIMELINE
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace loot {
+// Records when named tasks ran relative to the timeline's creation, so that
+// the order in which they ran and how they overlapped can be logged.
+class Timeline {
+public:
+  struct Span {
+    std::string name;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point end;
+    std::thread::id threadId;
+  };
+
+  // Records a span from its construction to its destruction.
+  class ScopedSpan {
+  public:
+    ScopedSpan(Timeline& timeline, const std::string& name);
+    ~ScopedSpan();
+
+    ScopedSpan(const ScopedSpan&) = delete;
+    ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+  private:
+    Timeline& timeline_;
+    std::string name_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  Timeline();
+
+  void Record(const std::string& name,
+              std::chrono::steady_clock::time_point start,
+              std::chrono::steady_clock::time_point end);
+
+  std::vector<Span> GetSpans() const;
+
+  void Log(const std::string& title) const;
+
+private:
+  const std::chrono::steady_clock::time_point origin_;
+  std::vector<Span> spans_;
+
+  mutable std::mutex mutex_;
+};
+}
+
+#endif
@@ -0,0 +1,149 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/trace_buffer.h"
+
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <thread>
+
+using std::chrono::duration;
+using std::chrono::steady_clock;
+
+namespace loot {
+TraceBuffer::TraceBuffer(size_t capacity) :
+    capacity_(capacity),
+    slots_(new Slot[capacity]()),
+    nextIndex_(0) {}
+
+void TraceBuffer::Record(const char* message, std::string_view detail) {
+  auto index = nextIndex_.fetch_add(1, std::memory_order_relaxed);
+  auto& slot = slots_[index % capacity_];
+
+  // An odd sequence number marks the slot as being written.
+  slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot.message.store(message, std::memory_order_relaxed);
+  slot.time.store(steady_clock::now().time_since_epoch().count(),
+                  std::memory_order_relaxed);
+  slot.threadId.store(std::hash<std::thread::id>()(std::this_thread::get_id()),
+                      std::memory_order_relaxed);
+
+  auto length = std::min(detail.size(), MAX_DETAIL_LENGTH);
+  // Don't truncate in the middle of a UTF-8 character.
+  if (length < detail.size()) {
+    while (length > 0 && (detail[length] & 0xC0) == 0x80) {
+      --length;
+    }
+  }
+
+  for (size_t word = 0; word < DETAIL_WORDS; ++word) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+      auto position = word * sizeof(uint64_t) + i;
+      if (position < length) {
+        value |= static_cast<uint64_t>(
+                     static_cast<unsigned char>(detail[position]))
+                 << (8 * i);
+      }
+    }
+    slot.detail[word].store(value, std::memory_order_relaxed);
+  }
+
+  slot.sequence.store(2 * index + 2, std::memory_order_release);
+}
+
+std::vector<std::string> TraceBuffer::Format() const {
+  struct Event {
+    const char* message;
+    int64_t time;
+    uint64_t threadId;
+    std::string detail;
+  };
+
+  auto end = nextIndex_.load(std::memory_order_acquire);
+  auto begin = end > capacity_ ? end - capacity_ : 0;
+
+  std::vector<Event> events;
+  for (auto index = begin; index < end; ++index) {
+    const auto& slot = slots_[index % capacity_];
+
+    auto sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != 2 * index + 2) {
+      continue;
+    }
+
+    Event event;
+    event.message = slot.message.load(std::memory_order_relaxed);
+    event.time = slot.time.load(std::memory_order_relaxed);
+    event.threadId = slot.threadId.load(std::memory_order_relaxed);
+
+    char detail[MAX_DETAIL_LENGTH];
+    for (size_t word = 0; word < DETAIL_WORDS; ++word) {
+      auto value = slot.detail[word].load(std::memory_order_relaxed);
+      for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+        detail[word * sizeof(uint64_t) + i] =
+            static_cast<char>((value >> (8 * i)) & 0xFF);
+      }
+    }
+
+    // Check that the slot wasn't overwritten while it was being read.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+      continue;
+    }
+
+    event.detail.assign(detail,
+                        std::find(detail, detail + MAX_DETAIL_LENGTH, '\0'));
+    events.push_back(std::move(event));
+  }
+
+  // Thread IDs aren't very readable, so number threads in order of use.
+  std::map<uint64_t, size_t> threadNumbers;
+  auto now = steady_clock::now().time_since_epoch().count();
+
+  std::vector<std::string> lines;
+  for (const auto& event : events) {
+    auto threadNumber =
+        threadNumbers.emplace(event.threadId, threadNumbers.size())
+            .first->second;
+    auto age = duration<double>(steady_clock::duration(now - event.time));
+
+    std::ostringstream line;
+    line << "[-" << std::fixed << std::setprecision(3) << age.count()
+         << " s] [thread " << threadNumber << "] " << event.message;
+    if (!event.detail.empty()) {
+      line << ": " << event.detail;
+    }
+    lines.push_back(line.str());
+  }
+
+  return lines;
+}
+}
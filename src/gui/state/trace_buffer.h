@@ -0,0 +1,81 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_TRACE_BUFFER
+#define LOOT_GUI_STATE_TRACE_BUFFER
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace loot {
+// A fixed-size record of the most recent trace events, cheap enough to be
+// always recording so that the events leading up to a failure are available
+// even when debug logging is disabled. Recording is lock-free: an event is
+// stored as a pointer to its static message, the time, the thread and a
+// truncated copy of one detail string, and is only formatted when the buffer
+// is read. Once the buffer is full, each event replaces the oldest.
+class TraceBuffer {
+public:
+  // Longer details are truncated.
+  static constexpr size_t MAX_DETAIL_LENGTH = 96;
+
+  explicit TraceBuffer(size_t capacity = 2048);
+
+  TraceBuffer(const TraceBuffer&) = delete;
+  TraceBuffer& operator=(const TraceBuffer&) = delete;
+
+  // The message must outlive the buffer, e.g. it could be a string literal.
+  void Record(const char* message, std::string_view detail = {});
+
+  // Formats the recorded events, oldest first, with times relative to now.
+  // Events that are being overwritten while this runs are skipped.
+  std::vector<std::string> Format() const;
+
+private:
+  static constexpr size_t DETAIL_WORDS = MAX_DETAIL_LENGTH / sizeof(uint64_t);
+
+  // Every field is atomic so that a slot can be read while it's being
+  // overwritten: the sequence number shows whether that happened.
+  struct Slot {
+    std::atomic<uint64_t> sequence;
+    std::atomic<const char*> message;
+    std::atomic<int64_t> time;
+    std::atomic<uint64_t> threadId;
+    std::array<std::atomic<uint64_t>, DETAIL_WORDS> detail;
+  };
+
+  const size_t capacity_;
+  const std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> nextIndex_;
+};
+}
+
+#endif
@@ -0,0 +1,166 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include "gui/state/tracing.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#include <json.hpp>
+
+#include "gui/state/logging.h"
+
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+
+namespace loot {
+namespace {
+struct TraceEvent {
+  const char* name;
+  std::string detail;
+  steady_clock::time_point start;
+  steady_clock::time_point end;
+  unsigned int threadNumber;
+};
+
+std::atomic<bool> tracingEnabled(false);
+std::mutex tracingMutex;
+std::filesystem::path traceFile;
+steady_clock::time_point traceOrigin;
+std::vector<TraceEvent> traceEvents;
+
+// Threads are numbered in the order that they first record a span, as that's
+// easier to read than their platform IDs.
+unsigned int getThreadNumber() {
+  static std::atomic<unsigned int> nextThreadNumber(1);
+  thread_local unsigned int threadNumber = nextThreadNumber.fetch_add(1);
+  return threadNumber;
+}
+
+int64_t toMicroseconds(steady_clock::duration duration) {
+  return duration_cast<microseconds>(duration).count();
+}
+
+nlohmann::json toTraceEventsJson(const std::vector<TraceEvent>& events,
+                                 steady_clock::time_point origin) {
+  auto jsonEvents = nlohmann::json::array();
+  for (const auto& event : events) {
+    nlohmann::json jsonEvent = {
+        {"name", event.name},
+        {"cat", "loot"},
+        {"ph", "X"},
+        {"ts", toMicroseconds(event.start - origin)},
+        {"dur", toMicroseconds(event.end - event.start)},
+        {"pid", 1},
+        {"tid", event.threadNumber},
+    };
+
+    if (!event.detail.empty()) {
+      jsonEvent["args"] = {{"detail", event.detail}};
+    }
+
+    jsonEvents.push_back(jsonEvent);
+  }
+
+  return {{"traceEvents", jsonEvents}, {"displayTimeUnit", "ms"}};
+}
+}
+
+void startTracing(const std::filesystem::path& outputFile) {
+  static std::once_flag registerStop;
+  std::call_once(registerStop, []() { std::atexit(stopTracing); });
+
+  std::lock_guard<std::mutex> guard(tracingMutex);
+  traceFile = outputFile;
+  traceOrigin = steady_clock::now();
+  traceEvents.clear();
+  tracingEnabled.store(true, std::memory_order_relaxed);
+}
+
+void stopTracing() {
+  std::vector<TraceEvent> events;
+  std::filesystem::path file;
+  steady_clock::time_point origin;
+  {
+    std::lock_guard<std::mutex> guard(tracingMutex);
+    if (!tracingEnabled.exchange(false, std::memory_order_relaxed)) {
+      return;
+    }
+
+    events.swap(traceEvents);
+    file = traceFile;
+    origin = traceOrigin;
+  }
+
+  std::ofstream out(file);
+  out << toTraceEventsJson(events, origin).dump();
+  out.close();
+
+  auto logger = getLogger();
+  if (logger) {
+    if (out.fail()) {
+      logger->error("Failed to write trace events to \"{}\"",
+                    file.u8string());
+    } else {
+      logger->info("Wrote {} trace events to \"{}\"",
+                   events.size(),
+                   file.u8string());
+    }
+  }
+}
+
+bool isTracingEnabled() {
+  return tracingEnabled.load(std::memory_order_relaxed);
+}
+
+TraceSpan::TraceSpan(const char* name, std::string_view detail) :
+    name_(nullptr) {
+  if (isTracingEnabled()) {
+    name_ = name;
+    detail_ = detail;
+    start_ = steady_clock::now();
+  }
+}
+
+TraceSpan::~TraceSpan() {
+  if (name_ == nullptr) {
+    return;
+  }
+
+  auto end = steady_clock::now();
+  auto threadNumber = getThreadNumber();
+
+  std::lock_guard<std::mutex> guard(tracingMutex);
+  // Tracing may have stopped or restarted since the span started.
+  if (isTracingEnabled() && start_ >= traceOrigin) {
+    traceEvents.push_back(
+        TraceEvent{name_, std::move(detail_), start_, end, threadNumber});
+  }
+}
+}
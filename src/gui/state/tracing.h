@@ -0,0 +1,65 @@
+/*  LOOT
+
+    A load order optimisation tool for
+    Morrowind, Oblivion, Skyrim, Skyrim Special Edition, Skyrim VR,
+    Fallout 3, Fallout: New Vegas, Fallout 4 and Fallout 4 VR.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_GUI_STATE_TRACING
+#define LOOT_GUI_STATE_TRACING
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace loot {
+// Starts recording trace spans, which are written to the given file in
+// Chrome's trace event format when tracing stops, so that they can be viewed
+// in Perfetto or chrome://tracing. Tracing stops on exit if it hasn't already.
+void startTracing(const std::filesystem::path& outputFile);
+
+// Stops recording trace spans and writes out those that were recorded.
+void stopTracing();
+
+bool isTracingEnabled();
+
+// Records a span from its construction to its destruction if tracing was
+// enabled when it was constructed. Otherwise it does nothing, so spans can be
+// left in hot code. The name must outlive the span, e.g. be a string literal.
+// The detail is only copied while tracing, so in hot code pass a string the
+// caller already holds, or check isTracingEnabled() before building one.
+class TraceSpan {
+public:
+  explicit TraceSpan(const char* name, std::string_view detail = {});
+  ~TraceSpan();
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+  const char* name_;
+  std::string detail_;
+  std::chrono::steady_clock::time_point start_;
+};
+}
+
+#endif
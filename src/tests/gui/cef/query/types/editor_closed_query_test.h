@@ -75,6 +75,9 @@ public:
   }
 
   bool IsPluginActive(const std::string& pluginName) const { return false; }
+  std::optional<uint32_t> FindPluginCrc(const PluginInterface& plugin) const {
+    return std::nullopt;
+  }
   std::optional<short> GetActiveLoadOrderIndex(
       const std::shared_ptr<const PluginInterface>& plugin,
       const std::vector<std::string>& loadOrder) const {
@@ -120,6 +123,20 @@ public:
   void AddUserMetadata(PluginMetadata metadata) { userMetadata = metadata; }
   void SaveUserMetadata() {}
 
+  std::set<std::string> CheckForCyclicInteractions(
+      const std::string& pluginName) {
+    pluginsCheckedForCycles.push_back(pluginName);
+    return pluginsWithChangedCycles;
+  }
+
+  std::set<std::string> GetDependentPlugins(const std::string& pluginName) {
+    return dependentPlugins;
+  }
+
+  std::vector<std::string> pluginsCheckedForCycles;
+  std::set<std::string> pluginsWithChangedCycles;
+  std::set<std::string> dependentPlugins;
+
   static constexpr auto NO_MASTERLIST_METADATA_PLUGIN = "no non-user metadata";
   static constexpr auto MASTERLIST_LATE_GROUP_PLUGIN =
       "masterlist metadata with Late group";
@@ -144,7 +161,8 @@ TEST(EditorClosedQuery,
                            {"group", "default"}}}};
   EditorClosedQuery<TestGame> query(game, counter, "en", json);
 
-  nlohmann::json responseJson = nlohmann::json::parse(query.executeLogic());
+  nlohmann::json responseJson =
+      nlohmann::json::parse(query.executeLogic()).at("plugins").at(0);
 
   EXPECT_EQ(TestGame::NO_MASTERLIST_METADATA_PLUGIN,
             responseJson.at("name").get<std::string>());
@@ -162,7 +180,8 @@ TEST(EditorClosedQuery, shouldLeaveGroupUnsetIfThereIsNoNonUserMetadata) {
                           }}};
   EditorClosedQuery<TestGame> query(game, counter, "en", json);
 
-  nlohmann::json responseJson = nlohmann::json::parse(query.executeLogic());
+  nlohmann::json responseJson =
+      nlohmann::json::parse(query.executeLogic()).at("plugins").at(0);
 
   EXPECT_EQ(TestGame::NO_MASTERLIST_METADATA_PLUGIN,
             responseJson.at("name").get<std::string>());
@@ -180,7 +199,8 @@ TEST(EditorClosedQuery,
        {{"name", TestGame::NO_MASTERLIST_METADATA_PLUGIN}, {"group", "DLC"}}}};
   EditorClosedQuery<TestGame> query(game, counter, "en", json);
 
-  nlohmann::json responseJson = nlohmann::json::parse(query.executeLogic());
+  nlohmann::json responseJson =
+      nlohmann::json::parse(query.executeLogic()).at("plugins").at(0);
 
   EXPECT_EQ(TestGame::NO_MASTERLIST_METADATA_PLUGIN,
             responseJson.at("name").get<std::string>());
@@ -198,7 +218,8 @@ TEST(EditorClosedQuery,
                            {"group", "default"}}}};
   EditorClosedQuery<TestGame> query(game, counter, "en", json);
 
-  nlohmann::json responseJson = nlohmann::json::parse(query.executeLogic());
+  nlohmann::json responseJson =
+      nlohmann::json::parse(query.executeLogic()).at("plugins").at(0);
 
   EXPECT_EQ(TestGame::MASTERLIST_DEFAULT_GROUP_PLUGIN,
             responseJson.at("name").get<std::string>());
@@ -216,7 +237,8 @@ TEST(EditorClosedQuery,
        {{"name", TestGame::MASTERLIST_NO_GROUP_PLUGIN}, {"group", "default"}}}};
   EditorClosedQuery<TestGame> query(game, counter, "en", json);
 
-  nlohmann::json responseJson = nlohmann::json::parse(query.executeLogic());
+  nlohmann::json responseJson =
+      nlohmann::json::parse(query.executeLogic()).at("plugins").at(0);
 
   EXPECT_EQ(TestGame::MASTERLIST_NO_GROUP_PLUGIN,
             responseJson.at("name").get<std::string>());
@@ -234,7 +256,8 @@ TEST(EditorClosedQuery,
                            {"group", "default"}}}};
   EditorClosedQuery<TestGame> query(game, counter, "en", json);
 
-  nlohmann::json responseJson = nlohmann::json::parse(query.executeLogic());
+  nlohmann::json responseJson =
+      nlohmann::json::parse(query.executeLogic()).at("plugins").at(0);
 
   EXPECT_EQ(TestGame::MASTERLIST_DLC_GROUP_PLUGIN,
             responseJson.at("name").get<std::string>());
@@ -253,7 +276,8 @@ TEST(EditorClosedQuery,
                            {"group", "DLC"}}}};
   EditorClosedQuery<TestGame> query(game, counter, "en", json);
 
-  nlohmann::json responseJson = nlohmann::json::parse(query.executeLogic());
+  nlohmann::json responseJson =
+      nlohmann::json::parse(query.executeLogic()).at("plugins").at(0);
 
   EXPECT_EQ(TestGame::MASTERLIST_DEFAULT_GROUP_PLUGIN,
             responseJson.at("name").get<std::string>());
@@ -271,7 +295,8 @@ TEST(EditorClosedQuery,
        {{"name", TestGame::MASTERLIST_NO_GROUP_PLUGIN}, {"group", "DLC"}}}};
   EditorClosedQuery<TestGame> query(game, counter, "en", json);
 
-  nlohmann::json responseJson = nlohmann::json::parse(query.executeLogic());
+  nlohmann::json responseJson =
+      nlohmann::json::parse(query.executeLogic()).at("plugins").at(0);
 
   EXPECT_EQ(TestGame::MASTERLIST_NO_GROUP_PLUGIN,
             responseJson.at("name").get<std::string>());
@@ -290,13 +315,110 @@ TEST(
        {{"name", TestGame::MASTERLIST_LATE_GROUP_PLUGIN}, {"group", "DLC"}}}};
   EditorClosedQuery<TestGame> query(game, counter, "en", json);
 
-  nlohmann::json responseJson = nlohmann::json::parse(query.executeLogic());
+  nlohmann::json responseJson =
+      nlohmann::json::parse(query.executeLogic()).at("plugins").at(0);
 
   EXPECT_EQ(TestGame::MASTERLIST_LATE_GROUP_PLUGIN,
             responseJson.at("name").get<std::string>());
   EXPECT_EQ("DLC", responseJson.at("group").get<std::string>());
   EXPECT_EQ("DLC", responseJson.at("userlist").at("group").get<std::string>());
 }
+
+TEST(EditorClosedQuery, shouldCheckForCyclicInteractionsIfEditsAreApplied) {
+  TestGame game;
+  UnappliedChangeCounter counter;
+  nlohmann::json json = {{"applyEdits", true},
+                         {"metadata",
+                          {
+                              {"name", TestGame::NO_MASTERLIST_METADATA_PLUGIN},
+                          }}};
+  EditorClosedQuery<TestGame> query(game, counter, "en", json);
+
+  query.executeLogic();
+
+  EXPECT_EQ(std::vector<std::string>({TestGame::NO_MASTERLIST_METADATA_PLUGIN}),
+            game.pluginsCheckedForCycles);
+}
+
+TEST(EditorClosedQuery,
+     shouldNotCheckForCyclicInteractionsIfEditsAreNotApplied) {
+  TestGame game;
+  UnappliedChangeCounter counter;
+  nlohmann::json json = {{"applyEdits", false},
+                         {"metadata",
+                          {
+                              {"name", TestGame::NO_MASTERLIST_METADATA_PLUGIN},
+                          }}};
+  EditorClosedQuery<TestGame> query(game, counter, "en", json);
+
+  query.executeLogic();
+
+  EXPECT_TRUE(game.pluginsCheckedForCycles.empty());
+}
+
+TEST(EditorClosedQuery,
+     shouldReturnTheEditedPluginFirstFollowedByAffectedPlugins) {
+  TestGame game;
+  game.pluginsWithChangedCycles = {TestGame::MASTERLIST_NO_GROUP_PLUGIN,
+                                   TestGame::NO_MASTERLIST_METADATA_PLUGIN};
+  UnappliedChangeCounter counter;
+  nlohmann::json json = {{"applyEdits", true},
+                         {"metadata",
+                          {
+                              {"name", TestGame::NO_MASTERLIST_METADATA_PLUGIN},
+                          }}};
+  EditorClosedQuery<TestGame> query(game, counter, "en", json);
+
+  nlohmann::json responseJson = nlohmann::json::parse(query.executeLogic());
+
+  ASSERT_EQ(2, responseJson.at("plugins").size());
+  EXPECT_EQ(TestGame::NO_MASTERLIST_METADATA_PLUGIN,
+            responseJson.at("plugins").at(0).at("name").get<std::string>());
+  EXPECT_EQ(TestGame::MASTERLIST_NO_GROUP_PLUGIN,
+            responseJson.at("plugins").at(1).at("name").get<std::string>());
+}
+
+TEST(EditorClosedQuery, shouldReturnPluginsWhoseMetadataListsTheEditedPlugin) {
+  TestGame game;
+  game.dependentPlugins = {TestGame::MASTERLIST_LATE_GROUP_PLUGIN};
+  game.pluginsWithChangedCycles = {TestGame::MASTERLIST_NO_GROUP_PLUGIN};
+  UnappliedChangeCounter counter;
+  nlohmann::json json = {{"applyEdits", true},
+                         {"metadata",
+                          {
+                              {"name", TestGame::NO_MASTERLIST_METADATA_PLUGIN},
+                          }}};
+  EditorClosedQuery<TestGame> query(game, counter, "en", json);
+
+  nlohmann::json responseJson = nlohmann::json::parse(query.executeLogic());
+
+  std::set<std::string> affectedPlugins;
+  for (const auto& plugin : responseJson.at("plugins")) {
+    affectedPlugins.insert(plugin.at("name").get<std::string>());
+  }
+  EXPECT_EQ(std::set<std::string>({TestGame::NO_MASTERLIST_METADATA_PLUGIN,
+                                   TestGame::MASTERLIST_LATE_GROUP_PLUGIN,
+                                   TestGame::MASTERLIST_NO_GROUP_PLUGIN}),
+            affectedPlugins);
+}
+
+TEST(EditorClosedQuery, shouldReturnOnlyTheEditedPluginIfEditsAreNotApplied) {
+  TestGame game;
+  game.pluginsWithChangedCycles = {TestGame::MASTERLIST_NO_GROUP_PLUGIN};
+  UnappliedChangeCounter counter;
+  nlohmann::json json = {{"applyEdits", false},
+                         {"metadata",
+                          {
+                              {"name", TestGame::NO_MASTERLIST_METADATA_PLUGIN},
+                          }}};
+  EditorClosedQuery<TestGame> query(game, counter, "en", json);
+
+  nlohmann::json responseJson = nlohmann::json::parse(query.executeLogic());
+
+  ASSERT_EQ(1, responseJson.at("plugins").size());
+  EXPECT_EQ(TestGame::NO_MASTERLIST_METADATA_PLUGIN,
+            responseJson.at("plugins").at(0).at("name").get<std::string>());
+}
 }
 }
 #endif
@@ -98,6 +98,14 @@ TEST(CompareFilenames, shouldBeCaseInsensitiveAndLocaleInvariant) {
   // Reset locale.
   std::locale::global(boost::locale::generator().generate(""));
 }
+
+TEST(NormalizeFilename, shouldMatchTheCaseInsensitivityOfCompareFilenames) {
+  EXPECT_EQ(NormalizeFilename("Blank.esm"), NormalizeFilename("BLANK.ESM"));
+  EXPECT_EQ(NormalizeFilename(u8"non\u00C1scii.esp"),
+            NormalizeFilename(u8"non\u00E1scii.esp"));
+  EXPECT_EQ(NormalizeFilename(u8"\u03a1"), NormalizeFilename(u8"\u03c1"));
+  EXPECT_NE(NormalizeFilename("Blank.esm"), NormalizeFilename("Blank.esp"));
+}
 }
 }
 
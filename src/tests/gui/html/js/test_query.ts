@@ -2,7 +2,8 @@ import { mocked } from 'ts-jest/utils';
 import {
   getVersion,
   getInitErrors,
-  getConflictingPlugins
+  getConflictingPlugins,
+  getConflictingPluginNames
 } from '../../../../gui/html/js/query';
 
 describe('query()', () => {
@@ -14,6 +15,13 @@ describe('query()', () => {
           onFailure(-1, 'error message');
         } else if (request === '{"name":"getInitErrors"}') {
           onSuccess('{"errors": []}');
+        } else if (
+          request ===
+          '{"name":"getConflictingPlugins","pluginName":"plugin.esp","namesOnly":true}'
+        ) {
+          onSuccess(
+            '{"generalMessages": [], "conflictingPlugins": ["plugin.esp"], "plugins": []}'
+          );
         } else {
           onSuccess('{"generalMessages": [], "plugins": []}');
         }
@@ -38,6 +46,13 @@ describe('query()', () => {
       expect(response.plugins.length).toBe(0);
     }));
 
+  test('should request only conflicting plugin names when getting conflicting plugin names', () =>
+    getConflictingPluginNames('plugin.esp').then(response => {
+      expect(mocked(window.cefQuery).mock.calls.length).toBe(1);
+      expect(response.conflictingPlugins).toEqual(['plugin.esp']);
+      expect(response.plugins.length).toBe(0);
+    }));
+
   test('should fail with an Error object when an error occurs', () =>
     getVersion().catch(error => {
       expect(mocked(window.cefQuery).mock.calls.length).toBe(1);
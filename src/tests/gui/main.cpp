@@ -31,12 +31,24 @@
 #include "tests/gui/cef/query/types/editor_closed_query_test.h"
 #include "tests/gui/cef/query/types/get_settings_query_test.h"
 #include "tests/gui/cef/query/types/get_themes_query_test.h"
+#include "tests/gui/state/auto_sort_test.h"
+#include "tests/gui/state/debounced_writer_test.h"
+#include "tests/gui/state/game/conflict_index_test.h"
+#include "tests/gui/state/game/crc_cache_test.h"
 #include "tests/gui/state/game/game_settings_test.h"
 #include "tests/gui/state/game/game_test.h"
 #include "tests/gui/state/game/games_manager_test.h"
 #include "tests/gui/state/game/helpers_test.h"
+#include "tests/gui/state/game/interaction_graph_test.h"
+#include "tests/gui/state/game/load_order_journal_test.h"
+#include "tests/gui/state/game/load_order_profiles_test.h"
+#include "tests/gui/state/game/masterlist_snapshot_test.h"
+#include "tests/gui/state/logging_test.h"
 #include "tests/gui/state/loot_paths_test.h"
 #include "tests/gui/state/loot_settings_test.h"
+#include "tests/gui/state/timeline_test.h"
+#include "tests/gui/state/trace_buffer_test.h"
+#include "tests/gui/state/tracing_test.h"
 #include "tests/gui/state/unapplied_change_counter_test.h"
 #include "tests/gui/helpers_test.h"
 
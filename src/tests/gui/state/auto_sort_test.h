@@ -0,0 +1,136 @@
+/*  LOOT
+
+    A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+    Fallout: New Vegas.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_AUTO_SORT_TEST
+#define LOOT_TESTS_GUI_STATE_AUTO_SORT_TEST
+
+#include <algorithm>
+#include <fstream>
+
+#include "gui/state/auto_sort.h"
+
+#include "tests/common_game_test_fixture.h"
+
+namespace loot {
+namespace test {
+class AutoSortTest : public CommonGameTestFixture {
+protected:
+  AutoSortTest() :
+      game_(GameSettings(GetParam(), "folder")
+                .SetMinimumHeaderVersion(0.0f)
+                .SetGamePath(dataPath.parent_path())
+                .SetGameLocalPath(localPath),
+            lootDataPath) {}
+
+  void SetUp() {
+    CommonGameTestFixture::SetUp();
+
+    game_.Init();
+  }
+
+  std::vector<std::string> getSpanNames() const {
+    std::vector<std::string> names;
+    for (const auto& span : timeline_.GetSpans()) {
+      names.push_back(span.name);
+    }
+    return names;
+  }
+
+  gui::Game game_;
+  Timeline timeline_;
+};
+
+// Pass an empty first argument, as it's a prefix for the test instantation,
+// but we only have the one so no prefix is necessary.
+INSTANTIATE_TEST_CASE_P(,
+                        AutoSortTest,
+                        ::testing::Values(GameType::tes4,
+                                          GameType::tes5,
+                                          GameType::fo4));
+
+TEST_P(AutoSortTest, autoSortShouldLoadSortAndApplyTheLoadOrder) {
+  std::ofstream out(game_.UserlistPath());
+  out << "plugins:\n"
+      << "  - name: '" << blankEsp << "'\n"
+      << "    after: [ '" << blankDifferentEsp << "' ]\n";
+  out.close();
+
+  EXPECT_TRUE(AutoSort(game_, false, timeline_));
+
+  EXPECT_FALSE(game_.GetPlugins().empty());
+
+  auto loadOrder = game_.GetLoadOrder();
+  EXPECT_EQ(game_.SortPlugins(), loadOrder);
+  auto blankEspPos = std::find(loadOrder.begin(), loadOrder.end(), blankEsp);
+  auto blankDifferentEspPos =
+      std::find(loadOrder.begin(), loadOrder.end(), blankDifferentEsp);
+  EXPECT_TRUE(blankDifferentEspPos < blankEspPos);
+
+  // The load order from before sorting should have been recorded.
+  ASSERT_EQ(1, game_.CountRecordedLoadOrders());
+  EXPECT_NE(loadOrder, game_.GetRecordedLoadOrder(0));
+
+  EXPECT_EQ(std::vector<std::string>({
+                "Plugin and metadata loading",
+                "Error checking",
+                "Sorting",
+                "Load order application",
+            }),
+            getSpanNames());
+}
+
+TEST_P(AutoSortTest, autoSortShouldNotSortIfThereAreErrorMessages) {
+  std::ofstream out(game_.UserlistPath());
+  out << "globals:\n"
+      << "  - type: error\n"
+      << "    content: 'An error'\n";
+  out.close();
+
+  auto loadOrder = game_.GetLoadOrder();
+
+  EXPECT_FALSE(AutoSort(game_, false, timeline_));
+
+  EXPECT_EQ(loadOrder, game_.GetLoadOrder());
+  EXPECT_EQ(std::vector<std::string>({
+                "Plugin and metadata loading",
+                "Error checking",
+            }),
+            getSpanNames());
+}
+
+TEST_P(AutoSortTest, autoSortShouldNotSetTheLoadOrderIfItIsAlreadySorted) {
+  ASSERT_TRUE(AutoSort(game_, false, timeline_));
+
+  auto loadOrder = game_.GetLoadOrder();
+  auto recordCount = game_.CountRecordedLoadOrders();
+
+  EXPECT_TRUE(AutoSort(game_, false, timeline_));
+
+  EXPECT_EQ(loadOrder, game_.GetLoadOrder());
+  EXPECT_EQ(recordCount, game_.CountRecordedLoadOrders());
+}
+}
+}
+
+#endif
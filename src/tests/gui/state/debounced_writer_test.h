@@ -0,0 +1,113 @@
+/*  LOOT
+
+    A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+    Fallout: New Vegas.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_DEBOUNCED_WRITER_TEST
+#define LOOT_TESTS_GUI_STATE_DEBOUNCED_WRITER_TEST
+
+#include "gui/state/debounced_writer.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+namespace loot {
+namespace test {
+TEST(DebouncedWriter, shouldOnlyRunTheLastOfABurstOfWrites) {
+  std::atomic<int> writeCount(0);
+  std::atomic<int> lastWrite(0);
+  DebouncedWriter writer(std::chrono::milliseconds(100));
+
+  for (int i = 1; i <= 10; ++i) {
+    writer.Schedule([&, i]() {
+      ++writeCount;
+      lastWrite = i;
+    });
+  }
+  EXPECT_EQ(0, writeCount);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  EXPECT_EQ(1, writeCount);
+  EXPECT_EQ(10, lastWrite);
+}
+
+TEST(DebouncedWriter, flushShouldRunAPendingWriteWithoutWaitingForTheDelay) {
+  bool written = false;
+  DebouncedWriter writer(std::chrono::hours(1));
+
+  writer.Schedule([&]() { written = true; });
+  writer.Flush();
+
+  EXPECT_TRUE(written);
+}
+
+TEST(DebouncedWriter, flushShouldDoNothingIfNoWriteIsPending) {
+  DebouncedWriter writer(std::chrono::hours(1));
+
+  EXPECT_NO_THROW(writer.Flush());
+}
+
+TEST(DebouncedWriter, aWriteThatThrowsShouldNotStopLaterWrites) {
+  bool written = false;
+  DebouncedWriter writer(std::chrono::hours(1));
+
+  writer.Schedule([]() { throw std::runtime_error("error"); });
+  EXPECT_THROW(writer.Flush(), std::runtime_error);
+  writer.Schedule([&]() { written = true; });
+  writer.Flush();
+
+  EXPECT_TRUE(written);
+}
+
+TEST(DebouncedWriter, flushShouldOnlyThrowTheErrorFromAFailedWriteOnce) {
+  DebouncedWriter writer(std::chrono::hours(1));
+
+  writer.Schedule([]() { throw std::runtime_error("error"); });
+  EXPECT_THROW(writer.Flush(), std::runtime_error);
+  EXPECT_NO_THROW(writer.Flush());
+}
+
+TEST(DebouncedWriter,
+     flushShouldThrowTheErrorFromAWriteThatFailedBeforeItWasCalled) {
+  DebouncedWriter writer(std::chrono::milliseconds(0));
+
+  writer.Schedule([]() { throw std::runtime_error("error"); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  EXPECT_THROW(writer.Flush(), std::runtime_error);
+}
+
+TEST(DebouncedWriter, destructorShouldRunAPendingWrite) {
+  bool written = false;
+  {
+    DebouncedWriter writer(std::chrono::hours(1));
+    writer.Schedule([&]() { written = true; });
+  }
+
+  EXPECT_TRUE(written);
+}
+}
+}
+
+#endif
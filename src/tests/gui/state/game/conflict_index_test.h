@@ -0,0 +1,138 @@
+/*  LOOT
+
+    A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+    Fallout: New Vegas.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_GAME_CONFLICT_INDEX_TEST
+#define LOOT_TESTS_GUI_STATE_GAME_CONFLICT_INDEX_TEST
+
+#include "gui/state/game/conflict_index.h"
+
+#include "gui/state/game/game.h"
+#include "tests/common_game_test_fixture.h"
+
+namespace loot {
+namespace gui {
+namespace test {
+class ConflictIndexTest : public loot::test::CommonGameTestFixture {
+protected:
+  ConflictIndexTest() :
+      game_(GameSettings(GetParam(), u8"non\u00C1sciiFolder")
+                .SetMinimumHeaderVersion(0.0f)
+                .SetGamePath(dataPath.parent_path())
+                .SetGameLocalPath(localPath),
+            "") {}
+
+  void SetUp() {
+    CommonGameTestFixture::SetUp();
+
+    game_.Init();
+    game_.LoadAllInstalledPlugins(false);
+  }
+
+  size_t GetIndex(const std::string& pluginName) {
+    return game_.GetPluginSnapshot()->GetIndex(pluginName).value();
+  }
+
+  Game game_;
+};
+
+// Pass an empty first argument, as it's a prefix for the test instantation,
+// but we only have the one so no prefix is necessary.
+INSTANTIATE_TEST_CASE_P(,
+                        ConflictIndexTest,
+                        ::testing::Values(GameType::tes4,
+                                          GameType::tes5,
+                                          GameType::fo3,
+                                          GameType::fonv,
+                                          GameType::fo4,
+                                          GameType::tes5se));
+
+TEST_P(ConflictIndexTest, pluginsThatOverrideTheSameRecordsShouldConflict) {
+  ConflictIndex index(game_.GetPluginSnapshot());
+
+  EXPECT_TRUE(index.DoPluginsConflict(GetIndex(blankEsm),
+                                      GetIndex(blankMasterDependentEsm)));
+  EXPECT_TRUE(index.DoPluginsConflict(GetIndex(blankMasterDependentEsm),
+                                      GetIndex(blankEsm)));
+}
+
+TEST_P(ConflictIndexTest, pluginsWithNoRecordsInCommonShouldNotConflict) {
+  ConflictIndex index(game_.GetPluginSnapshot());
+
+  EXPECT_FALSE(index.DoPluginsConflict(GetIndex(blankEsm), GetIndex(blankEsp)));
+}
+
+TEST_P(ConflictIndexTest,
+       getConflictingPluginsShouldMatchCheckingEachPairIndividually) {
+  ConflictIndex index(game_.GetPluginSnapshot());
+  const auto& plugins = game_.GetPluginSnapshot()->GetPlugins();
+
+  auto pluginIndex = GetIndex(blankEsm);
+  std::vector<size_t> expected;
+  for (size_t i = 0; i < plugins.size(); ++i) {
+    if (plugins[pluginIndex]->DoFormIDsOverlap(*plugins[i])) {
+      expected.push_back(i);
+    }
+  }
+
+  EXPECT_EQ(expected, index.GetConflictingPlugins(pluginIndex));
+}
+
+TEST_P(ConflictIndexTest, doPluginsConflictShouldThrowIfAnIndexIsOutOfRange) {
+  ConflictIndex index(game_.GetPluginSnapshot());
+  auto size = game_.GetPluginSnapshot()->Size();
+
+  EXPECT_THROW(index.DoPluginsConflict(0, size), std::out_of_range);
+}
+
+TEST_P(ConflictIndexTest,
+       getConflictingPluginsShouldThrowIfTheIndexIsOutOfRange) {
+  ConflictIndex index(game_.GetPluginSnapshot());
+  auto size = game_.GetPluginSnapshot()->Size();
+
+  EXPECT_THROW(index.GetConflictingPlugins(size), std::out_of_range);
+}
+
+TEST_P(ConflictIndexTest,
+       gameShouldReuseItsConflictIndexWhileItsPluginsAreUnchanged) {
+  auto index = game_.GetConflictIndex();
+
+  EXPECT_EQ(index, game_.GetConflictIndex());
+
+  game_.LoadAllInstalledPlugins(false);
+
+  EXPECT_NE(index, game_.GetConflictIndex());
+}
+
+TEST_P(ConflictIndexTest, fullyLoadingPluginsShouldBuildTheConflictIndex) {
+  game_.LoadAllInstalledPlugins(false);
+
+  auto index = game_.GetConflictIndex();
+
+  EXPECT_EQ(game_.GetPluginSnapshot(), index->GetSnapshot());
+}
+}
+}
+}
+
+#endif
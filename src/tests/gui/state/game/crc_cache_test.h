@@ -0,0 +1,156 @@
+/*  LOOT
+
+    A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+    Fallout: New Vegas.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_GAME_CRC_CACHE_TEST
+#define LOOT_TESTS_GUI_STATE_GAME_CRC_CACHE_TEST
+
+#include "gui/state/game/crc_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "loot/exception/file_access_error.h"
+#include "tests/common_game_test_fixture.h"
+
+namespace loot {
+namespace gui {
+namespace test {
+class CrcCacheTest : public loot::test::CommonGameTestFixture {
+protected:
+  CrcCacheTest() : cacheFile_(lootDataPath / "crc.cache") {}
+
+  void appendToFile(const std::filesystem::path& file) {
+    std::ofstream out(file, std::ios::binary | std::ios::app);
+    out << "extra";
+  }
+
+  const std::filesystem::path cacheFile_;
+};
+
+// Pass an empty first argument, as it's a prefix for the test instantation,
+// but we only have the one so no prefix is necessary.
+INSTANTIATE_TEST_CASE_P(,
+                        CrcCacheTest,
+                        ::testing::Values(GameType::tes5));
+
+TEST_P(CrcCacheTest, calculateCrc32ShouldReturnTheStandardCrcOfTheGivenBytes) {
+  const std::string data = "123456789";
+  auto bytes = reinterpret_cast<const unsigned char*>(data.data());
+
+  EXPECT_EQ(0, CalculateCrc32(bytes, 0, 0));
+  EXPECT_EQ(0xCBF43926, CalculateCrc32(bytes, data.size(), 0));
+}
+
+TEST_P(CrcCacheTest, calculateCrc32ShouldContinueFromTheGivenCrc) {
+  std::string data(100, '\0');
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<char>(i * 7);
+  }
+  auto bytes = reinterpret_cast<const unsigned char*>(data.data());
+
+  auto crc = CalculateCrc32(bytes, 37, 0);
+  crc = CalculateCrc32(bytes + 37, data.size() - 37, crc);
+
+  EXPECT_EQ(CalculateCrc32(bytes, data.size(), 0), crc);
+}
+
+TEST_P(CrcCacheTest, calculateCrc32ShouldReturnTheCrcOfTheGivenFile) {
+  EXPECT_EQ(blankEsmCrc, CalculateCrc32(dataPath / blankEsm));
+}
+
+TEST_P(CrcCacheTest, calculateCrc32ShouldThrowIfTheFileDoesNotExist) {
+  EXPECT_THROW(CalculateCrc32(dataPath / missingEsp), FileAccessError);
+}
+
+TEST_P(CrcCacheTest, findShouldReturnNulloptIfTheFileHasNoEntry) {
+  CrcCache cache(cacheFile_);
+
+  EXPECT_FALSE(cache.Find(dataPath / blankEsm).has_value());
+}
+
+TEST_P(CrcCacheTest, getCrcShouldCalculateAndCacheACrcThatIsNotCached) {
+  CrcCache cache(cacheFile_);
+
+  EXPECT_EQ(blankEsmCrc, cache.GetCrc(dataPath / blankEsm));
+  EXPECT_EQ(blankEsmCrc, cache.Find(dataPath / blankEsm).value());
+}
+
+TEST_P(CrcCacheTest, getCrcShouldUseAnInsertedCrc) {
+  CrcCache cache(cacheFile_);
+  cache.Insert(dataPath / blankEsm, 0x12345678);
+
+  EXPECT_EQ(0x12345678, cache.GetCrc(dataPath / blankEsm));
+}
+
+TEST_P(CrcCacheTest,
+       findShouldReturnNulloptIfTheFileHasChangedSinceItWasCached) {
+  CrcCache cache(cacheFile_);
+  cache.GetCrc(dataPath / blankEsm);
+
+  appendToFile(dataPath / blankEsm);
+
+  EXPECT_FALSE(cache.Find(dataPath / blankEsm).has_value());
+  EXPECT_NE(blankEsmCrc, cache.GetCrc(dataPath / blankEsm));
+}
+
+TEST_P(CrcCacheTest, cachedCrcsShouldBeSavedToTheCacheFile) {
+  {
+    CrcCache cache(cacheFile_);
+    cache.GetCrc(dataPath / blankEsm);
+    cache.Flush();
+  }
+
+  ASSERT_TRUE(std::filesystem::exists(cacheFile_));
+
+  CrcCache cache(cacheFile_);
+  EXPECT_EQ(blankEsmCrc, cache.Find(dataPath / blankEsm).value());
+}
+
+TEST_P(CrcCacheTest, savingShouldDropEntriesForFilesThatNoLongerExist) {
+  {
+    CrcCache cache(cacheFile_);
+    cache.GetCrc(dataPath / blankEsm);
+    cache.GetCrc(dataPath / blankEsp);
+    std::filesystem::remove(dataPath / blankEsp);
+  }
+
+  auto lines = readFileLines(cacheFile_);
+  EXPECT_EQ(2, lines.size());
+}
+
+TEST_P(CrcCacheTest, anUnrecognisedCacheFileShouldBeIgnored) {
+  std::ofstream out(cacheFile_);
+  out << "not a cache" << std::endl;
+  out.close();
+
+  CrcCache cache(cacheFile_);
+
+  EXPECT_FALSE(cache.Find(dataPath / blankEsm).has_value());
+}
+}
+}
+}
+
+#endif
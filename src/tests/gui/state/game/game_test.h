@@ -25,7 +25,15 @@ along with LOOT.  If not, see
 #ifndef LOOT_TESTS_GUI_STATE_GAME_GAME_TEST
 #define LOOT_TESTS_GUI_STATE_GAME_GAME_TEST
 
+#include <algorithm>
+#include <chrono>
 #include <fstream>
+#include <future>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
 
 #include "gui/state/game/game.h"
 
@@ -55,10 +63,7 @@ protected:
       info_(std::vector<MessageContent>({
           MessageContent("info"),
       })),
-      loadOrderBackupFile0("loadorder.bak.0"),
-      loadOrderBackupFile1("loadorder.bak.1"),
-      loadOrderBackupFile2("loadorder.bak.2"),
-      loadOrderBackupFile3("loadorder.bak.3"),
+      loadOrderJournalFile("loadorder.journal"),
       defaultGameSettings(GameSettings(GetParam(), u8"non\u00C1sciiFolder")
                               .SetMinimumHeaderVersion(0.0f)
                               .SetGamePath(dataPath.parent_path())
@@ -73,10 +78,7 @@ protected:
   }
 
   std::vector<std::string> loadOrderToSet_;
-  const std::string loadOrderBackupFile0;
-  const std::string loadOrderBackupFile1;
-  const std::string loadOrderBackupFile2;
-  const std::string loadOrderBackupFile3;
+  const std::string loadOrderJournalFile;
 
   const std::vector<MessageContent> info_;
 
@@ -115,10 +117,53 @@ TEST_P(GameTest, constructingFromGameSettingsShouldUseTheirValues) {
 
   EXPECT_EQ(settings.GamePath(), game.GamePath());
   auto lootGamePath = lootDataPath / u8path(defaultGameSettings.FolderName());
-  EXPECT_EQ(lootGamePath / "masterlist.yaml", game.MasterlistPath());
+  auto masterlistRepositoryPath =
+      lootDataPath / "masterlists" /
+      u8path(GetMasterlistRepositoryFolderName("foo", "foo"));
+  EXPECT_EQ(masterlistRepositoryPath / "masterlist.yaml",
+            game.MasterlistPath());
   EXPECT_EQ(lootGamePath / "userlist.yaml", game.UserlistPath());
 }
 
+TEST_P(GameTest,
+       gamesWithTheSameRepositoryShouldShareAMasterlistButNotAUserlist) {
+  GameSettings otherSettings(GetParam(), "other");
+  otherSettings.SetRepoURL(defaultGameSettings.RepoURL())
+      .SetRepoBranch(defaultGameSettings.RepoBranch());
+
+  Game game(defaultGameSettings, lootDataPath);
+  Game otherGame(otherSettings, lootDataPath);
+
+  EXPECT_EQ(game.MasterlistPath(), otherGame.MasterlistPath());
+  EXPECT_NE(game.UserlistPath(), otherGame.UserlistPath());
+}
+
+TEST_P(GameTest,
+       gamesWithDifferentRepositoryBranchesShouldNotShareAMasterlist) {
+  GameSettings otherSettings = defaultGameSettings;
+  otherSettings.SetRepoBranch(defaultGameSettings.RepoBranch() + "-other");
+
+  Game game(defaultGameSettings, lootDataPath);
+  Game otherGame(otherSettings, lootDataPath);
+
+  EXPECT_NE(game.MasterlistPath(), otherGame.MasterlistPath());
+}
+
+TEST_P(GameTest, initShouldMoveAMasterlistFromTheGameFolder) {
+  using std::filesystem::u8path;
+  Game game(defaultGameSettings, lootDataPath);
+  auto lootGamePath = lootDataPath / u8path(game.FolderName());
+  std::filesystem::create_directories(lootGamePath);
+  std::ofstream out(lootGamePath / "masterlist.yaml");
+  out << "bash_tags: []";
+  out.close();
+
+  ASSERT_NO_THROW(game.Init());
+
+  EXPECT_FALSE(std::filesystem::exists(lootGamePath / "masterlist.yaml"));
+  EXPECT_TRUE(std::filesystem::exists(game.MasterlistPath()));
+}
+
 TEST_P(GameTest, copyConstructorShouldCopyGameData) {
   Game game1 = CreateInitialisedGame(lootDataPath);
   game1.AppendMessage(Message(MessageType::say, "1"));
@@ -562,6 +607,50 @@ TEST_P(
   }
 }
 
+TEST_P(GameTest,
+       planPluginRedatesShouldListRedatesWithoutChangingAnyTimestamps) {
+  using std::filesystem::u8path;
+
+  Game game = CreateInitialisedGame("");
+  game.Init();
+  game.LoadAllInstalledPlugins(true);
+
+  std::vector<std::pair<std::string, bool>> loadOrder = getInitialLoadOrder();
+
+  auto time = std::filesystem::last_write_time(dataPath / u8path(masterFile));
+  for (size_t i = 1; i < loadOrder.size(); ++i) {
+    auto pluginPath = dataPath / u8path(loadOrder[i].first);
+    if (!std::filesystem::exists(pluginPath))
+      pluginPath += ".ghost";
+
+    std::filesystem::last_write_time(pluginPath,
+                                     time - i * std::chrono::seconds(60));
+  }
+
+  auto redates = game.PlanPluginRedates();
+
+  if (GetParam() != GameType::tes5 && GetParam() != GameType::tes5se) {
+    EXPECT_TRUE(redates.empty());
+  } else {
+    ASSERT_EQ(loadOrder.size() - 1, redates.size());
+    for (size_t i = 0; i < redates.size(); ++i) {
+      EXPECT_EQ(loadOrder[i + 1].first, redates[i].pluginName);
+      EXPECT_EQ(time - (i + 1) * std::chrono::seconds(60),
+                redates[i].currentTime);
+      EXPECT_EQ(time + (i + 1) * std::chrono::seconds(60), redates[i].newTime);
+    }
+  }
+
+  for (size_t i = 1; i < loadOrder.size(); ++i) {
+    auto pluginPath = dataPath / u8path(loadOrder[i].first);
+    if (!std::filesystem::exists(pluginPath))
+      pluginPath += ".ghost";
+
+    EXPECT_EQ(time - i * std::chrono::seconds(60),
+              std::filesystem::last_write_time(pluginPath));
+  }
+}
+
 TEST_P(
     GameTest,
     loadAllInstalledPluginsWithHeadersOnlyTrueShouldLoadTheHeadersOfAllInstalledPlugins) {
@@ -610,6 +699,34 @@ TEST_P(GameTest,
             game.GetMessages()[0].GetContent()[0].GetText());
 }
 
+TEST_P(GameTest,
+       refreshLoadOrderStateShouldReturnFalseIfNoPluginFilesHaveChanged) {
+  Game game = CreateInitialisedGame("");
+  game.LoadAllInstalledPlugins(true);
+
+  EXPECT_FALSE(game.RefreshLoadOrderState());
+}
+
+TEST_P(GameTest, refreshLoadOrderStateShouldReturnTrueIfAPluginWasInstalled) {
+  Game game = CreateInitialisedGame("");
+  game.LoadAllInstalledPlugins(true);
+
+  std::filesystem::copy(dataPath / blankEsp, dataPath / "new.esp");
+
+  EXPECT_TRUE(game.RefreshLoadOrderState());
+}
+
+TEST_P(GameTest, refreshLoadOrderStateShouldReturnTrueIfAPluginWasChanged) {
+  Game game = CreateInitialisedGame("");
+  game.LoadAllInstalledPlugins(true);
+
+  std::ofstream out(dataPath / blankEsp, std::ios::binary | std::ios::app);
+  out << "extra";
+  out.close();
+
+  EXPECT_TRUE(game.RefreshLoadOrderState());
+}
+
 TEST_P(GameTest, pluginsShouldNotBeFullyLoadedByDefault) {
   Game game = CreateInitialisedGame("");
 
@@ -632,6 +749,110 @@ TEST_P(GameTest, pluginsShouldBeFullyLoadedAfterFullyLoadingThem) {
   EXPECT_TRUE(game.ArePluginsFullyLoaded());
 }
 
+TEST_P(GameTest, findPluginCrcShouldFindACrcCalculatedInTheBackground) {
+  Game game = CreateInitialisedGame(lootDataPath);
+  game.LoadAllInstalledPlugins(true);
+
+  game.CachePluginCrcsInBackground();
+
+  auto plugin = game.GetPlugin(blankEsm);
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!game.FindPluginCrc(*plugin).has_value() &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  EXPECT_EQ(blankEsmCrc, game.FindPluginCrc(*plugin).value());
+}
+
+TEST_P(GameTest, findPluginCrcShouldWorkWithoutALootDataPath) {
+  Game game = CreateInitialisedGame("");
+  game.LoadAllInstalledPlugins(false);
+
+  EXPECT_EQ(blankEsmCrc, game.FindPluginCrc(*game.GetPlugin(blankEsm)).value());
+
+  game.LoadAllInstalledPlugins(true);
+
+  EXPECT_FALSE(game.FindPluginCrc(*game.GetPlugin(blankEsm)).has_value());
+}
+
+TEST_P(GameTest, findPluginCrcShouldGetTheCrcOfAGhostedPlugin) {
+  Game game = CreateInitialisedGame(lootDataPath);
+  game.LoadAllInstalledPlugins(false);
+  auto crc = game.GetPlugin(blankMasterDependentEsm)->GetCRC();
+  ASSERT_TRUE(crc.has_value());
+
+  game.LoadAllInstalledPlugins(true);
+  auto plugin = game.GetPlugin(blankMasterDependentEsm);
+
+  ASSERT_FALSE(plugin->GetCRC().has_value());
+  EXPECT_EQ(crc, game.FindPluginCrc(*plugin));
+}
+
+TEST_P(GameTest, findPluginCrcShouldNotCalculateACrcThatIsNotKnown) {
+  Game game = CreateInitialisedGame(lootDataPath);
+  game.LoadAllInstalledPlugins(true);
+
+  EXPECT_FALSE(game.FindPluginCrc(*game.GetPlugin(blankEsm)).has_value());
+}
+
+TEST_P(GameTest, findPluginCrcShouldFindACrcCachedByAFullLoad) {
+  Game game = CreateInitialisedGame(lootDataPath);
+  game.LoadAllInstalledPlugins(false);
+  game.LoadAllInstalledPlugins(true);
+
+  auto plugin = game.GetPlugin(blankEsm);
+  ASSERT_FALSE(plugin->GetCRC().has_value());
+  EXPECT_EQ(blankEsmCrc, game.FindPluginCrc(*plugin).value());
+}
+
+TEST_P(GameTest, pluginSnapshotShouldBeEmptyBeforePluginsAreLoaded) {
+  Game game = CreateInitialisedGame("");
+
+  EXPECT_TRUE(game.GetPluginSnapshot()->IsEmpty());
+  EXPECT_TRUE(game.GetPlugins().empty());
+}
+
+TEST_P(GameTest, loadingPluginsShouldReplaceThePluginSnapshotWithANewerOne) {
+  Game game = CreateInitialisedGame("");
+
+  auto initialSnapshot = game.GetPluginSnapshot();
+  ASSERT_NO_THROW(game.LoadAllInstalledPlugins(true));
+  auto headersSnapshot = game.GetPluginSnapshot();
+  ASSERT_NO_THROW(game.LoadAllInstalledPlugins(false));
+  auto fullSnapshot = game.GetPluginSnapshot();
+
+  EXPECT_TRUE(initialSnapshot->IsEmpty());
+  EXPECT_LT(initialSnapshot->GetVersion(), headersSnapshot->GetVersion());
+  EXPECT_LT(headersSnapshot->GetVersion(), fullSnapshot->GetVersion());
+  EXPECT_EQ(game.GetPlugins().size(), fullSnapshot->Size());
+}
+
+TEST_P(GameTest, pluginSnapshotShouldRecordPluginActiveStates) {
+  Game game = CreateInitialisedGame("");
+  ASSERT_NO_THROW(game.LoadAllInstalledPlugins(true));
+
+  auto snapshot = game.GetPluginSnapshot();
+  auto masterIndex = snapshot->GetIndex(masterFile);
+  auto blankEspIndex = snapshot->GetIndex(blankEsp);
+
+  ASSERT_TRUE(masterIndex.has_value());
+  ASSERT_TRUE(blankEspIndex.has_value());
+  EXPECT_TRUE(snapshot->IsActive(masterIndex.value()));
+  EXPECT_FALSE(snapshot->IsActive(blankEspIndex.value()));
+}
+
+TEST_P(GameTest, getPluginShouldFindLoadedPluginsCaseInsensitively) {
+  Game game = CreateInitialisedGame("");
+  ASSERT_NO_THROW(game.LoadAllInstalledPlugins(true));
+
+  auto plugin = game.GetPlugin("BLANK.ESM");
+
+  ASSERT_NE(nullptr, plugin);
+  EXPECT_EQ(blankEsm, plugin->GetName());
+  EXPECT_EQ(nullptr, game.GetPlugin("missing.esp"));
+}
+
 TEST_P(GameTest,
        GetActiveLoadOrderIndexShouldReturnNulloptForAPluginThatIsNotActive) {
   Game game(defaultGameSettings, "");
@@ -675,67 +896,327 @@ TEST_P(
   EXPECT_EQ(0, index.value());
 }
 
+TEST_P(GameTest, sortPluginsShouldGiveTheSameResultIfNothingHasChanged) {
+  Game game = CreateInitialisedGame("");
+
+  auto firstSort = game.SortPlugins();
+  auto firstSortMessages = game.GetMessages();
+  auto secondSort = game.SortPlugins();
+
+  ASSERT_FALSE(firstSort.empty());
+  EXPECT_EQ(firstSort, secondSort);
+  EXPECT_EQ(firstSortMessages, game.GetMessages());
+  // Sorting fully loads plugins, so their CRCs should be available.
+  ASSERT_NE(nullptr, game.GetPlugin(blankEsm));
+  EXPECT_EQ(blankEsmCrc, game.GetPlugin(blankEsm)->GetCRC().value());
+}
+
+TEST_P(GameTest, sortPluginsShouldUseUserMetadataAddedSinceTheLastSort) {
+  Game game = CreateInitialisedGame("");
+
+  auto sorted = game.SortPlugins();
+  ASSERT_FALSE(sorted.empty());
+
+  PluginMetadata metadata(blankEsp);
+  metadata.SetLoadAfterFiles({File(blankDifferentPluginDependentEsp)});
+  game.AddUserMetadata(metadata);
+
+  sorted = game.SortPlugins();
+
+  auto blankEspPos = std::find(sorted.begin(), sorted.end(), blankEsp);
+  auto otherPos = std::find(
+      sorted.begin(), sorted.end(), blankDifferentPluginDependentEsp);
+  ASSERT_NE(sorted.end(), blankEspPos);
+  ASSERT_NE(sorted.end(), otherPos);
+  EXPECT_GT(blankEspPos, otherPos);
+}
+
+TEST_P(GameTest,
+       saveUserMetadataShouldWriteTheUserlistOnceWritesAreFlushed) {
+  Game game = CreateInitialisedGame(lootDataPath);
+
+  PluginMetadata metadata(blankEsp);
+  metadata.SetLoadAfterFiles({File(blankDifferentPluginDependentEsp)});
+  game.AddUserMetadata(metadata);
+  game.SaveUserMetadata();
+  game.FlushUserMetadata();
+
+  auto tempPath = game.UserlistPath();
+  tempPath += ".tmp";
+  EXPECT_TRUE(std::filesystem::exists(game.UserlistPath()));
+  EXPECT_FALSE(std::filesystem::exists(tempPath));
+
+  Game otherGame = CreateInitialisedGame(lootDataPath);
+  otherGame.LoadMetadata();
+
+  auto userMetadata = otherGame.GetUserMetadata(blankEsp);
+  ASSERT_TRUE(userMetadata.has_value());
+  EXPECT_EQ(metadata.GetLoadAfterFiles(),
+            userMetadata.value().GetLoadAfterFiles());
+}
+
+TEST_P(GameTest, flushUserMetadataShouldThrowIfTheUserlistCouldNotBeWritten) {
+  Game game = CreateInitialisedGame(lootDataPath);
+
+  // A directory can't be replaced by the written userlist.
+  std::filesystem::create_directories(game.UserlistPath());
+
+  game.AddUserMetadata(PluginMetadata(blankEsp));
+  game.SaveUserMetadata();
+
+  EXPECT_THROW(game.FlushUserMetadata(), std::exception);
+  EXPECT_NO_THROW(game.FlushUserMetadata());
+}
+
+TEST_P(GameTest,
+       updateMasterlistSnapshotShouldWriteASnapshotOfTheLoadedMasterlist) {
+  Game game = CreateInitialisedGame(lootDataPath);
+  std::filesystem::create_directories(game.MasterlistPath().parent_path());
+  std::ofstream out(game.MasterlistPath());
+  out << "bash_tags: [Relev]\nplugins:\n  - name: " << blankEsm
+      << "\n    tag: [Relev]";
+  out.close();
+
+  EXPECT_FALSE(game.GetMasterlistSnapshot().has_value());
+
+  game.LoadMetadataInBackground();
+  game.LoadAllInstalledPlugins(true);
+  game.UpdateMasterlistSnapshot();
+
+  auto snapshot = game.GetMasterlistSnapshot();
+  ASSERT_TRUE(snapshot.has_value());
+  EXPECT_EQ(std::vector<std::string>({"Relev"}),
+            snapshot.value().GetKnownBashTags());
+
+  auto metadata = snapshot.value().GetPluginMetadata(blankEsm);
+  ASSERT_TRUE(metadata.has_value());
+  EXPECT_EQ(std::vector<Tag>({Tag("Relev")}), metadata.value().GetTags());
+}
+
+#ifndef _WIN32
+TEST_P(GameTest, pluginsShouldLoadWhileMetadataIsParsedInTheBackground) {
+  Game game = CreateInitialisedGame(lootDataPath);
+  std::filesystem::create_directories(game.MasterlistPath().parent_path());
+
+  // Reading from a FIFO blocks until something is written to it, so the
+  // parse can't finish until the test lets it.
+  ASSERT_EQ(0, mkfifo(game.MasterlistPath().c_str(), 0600));
+
+  game.LoadMetadataInBackground();
+
+  auto pluginsLoad = std::async(
+      std::launch::async, [&game]() { game.LoadAllInstalledPlugins(true); });
+  auto status = pluginsLoad.wait_for(std::chrono::seconds(10));
+
+  std::ofstream out(game.MasterlistPath());
+  out << "bash_tags: [Relev]";
+  out.close();
+  pluginsLoad.wait();
+
+  EXPECT_EQ(std::future_status::ready, status);
+  EXPECT_FALSE(game.GetPlugins().empty());
+  EXPECT_EQ(std::vector<std::string>({"Relev"}), game.GetKnownBashTags());
+}
+#endif
+
+TEST_P(GameTest,
+       getMasterlistSnapshotShouldIgnoreASnapshotOfAnotherMasterlist) {
+  Game game = CreateInitialisedGame(lootDataPath);
+  std::filesystem::create_directories(game.MasterlistPath().parent_path());
+  std::ofstream out(game.MasterlistPath());
+  out << "bash_tags: [Relev]";
+  out.close();
+
+  game.LoadMetadata();
+  game.LoadAllInstalledPlugins(true);
+  game.UpdateMasterlistSnapshot();
+  ASSERT_TRUE(game.GetMasterlistSnapshot().has_value());
+
+  out.open(game.MasterlistPath());
+  out << "bash_tags: [Delev]";
+  out.close();
+
+  EXPECT_FALSE(game.GetMasterlistSnapshot().has_value());
+}
+
+TEST_P(GameTest, sortPluginsInBackgroundShouldNotCountAsASort) {
+  // Declared first so that it outlives the sort's thread.
+  std::promise<bool> sortResult;
+  Game game = CreateInitialisedGame(lootDataPath);
+  game.LoadMetadata();
+  auto messages = game.GetMessages();
+
+  game.SortPluginsInBackground(
+      [&](bool loadOrderIsSorted) { sortResult.set_value(loadOrderIsSorted); });
+  auto status = sortResult.get_future().wait_for(std::chrono::seconds(10));
+
+  EXPECT_EQ(std::future_status::ready, status);
+  EXPECT_EQ(messages, game.GetMessages());
+  EXPECT_EQ("You have not sorted your load order this session\\.",
+            game.GetMessages().back().GetContent()[0].GetText());
+}
+
+TEST_P(GameTest,
+       sortPluginsShouldGiveTheBackgroundSortResultIfNothingHasChanged) {
+  std::promise<bool> sortResult;
+  Game game = CreateInitialisedGame(lootDataPath);
+  game.LoadMetadata();
+
+  game.SortPluginsInBackground(
+      [&](bool loadOrderIsSorted) { sortResult.set_value(loadOrderIsSorted); });
+  auto loadOrder = game.GetLoadOrder();
+  auto sorted = game.SortPlugins();
+
+  ASSERT_FALSE(sorted.empty());
+  EXPECT_EQ(sorted == loadOrder, sortResult.get_future().get());
+}
+
+TEST_P(GameTest,
+       sortPluginsShouldNotGiveTheBackgroundSortResultIfUserMetadataHasChanged) {
+  std::promise<bool> sortResult;
+  Game game = CreateInitialisedGame(lootDataPath);
+  game.LoadMetadata();
+
+  game.SortPluginsInBackground(
+      [&](bool loadOrderIsSorted) { sortResult.set_value(loadOrderIsSorted); });
+  sortResult.get_future().wait();
+
+  PluginMetadata metadata(blankEsp);
+  metadata.SetLoadAfterFiles({File(blankDifferentPluginDependentEsp)});
+  game.AddUserMetadata(metadata);
+
+  auto sorted = game.SortPlugins();
+
+  auto blankEspPos = std::find(sorted.begin(), sorted.end(), blankEsp);
+  auto otherPos = std::find(
+      sorted.begin(), sorted.end(), blankDifferentPluginDependentEsp);
+  ASSERT_NE(sorted.end(), blankEspPos);
+  ASSERT_NE(sorted.end(), otherPos);
+  EXPECT_GT(blankEspPos, otherPos);
+}
+
+TEST_P(GameTest, sortPluginsShouldSortIfTheBackgroundSortWasCancelled) {
+  Game game = CreateInitialisedGame(lootDataPath);
+  game.LoadMetadata();
+
+  game.SortPluginsInBackground(nullptr);
+  game.CancelBackgroundSort();
+
+  EXPECT_FALSE(game.SortPlugins().empty());
+}
+
+TEST_P(GameTest,
+       checkForCyclicInteractionsShouldReportACycleUntilItIsResolved) {
+  Game game = CreateInitialisedGame("");
+  ASSERT_NO_THROW(game.LoadAllInstalledPlugins(true));
+
+  PluginMetadata metadata(blankEsm);
+  metadata.SetLoadAfterFiles({File(blankMasterDependentEsp)});
+  game.AddUserMetadata(metadata);
+
+  auto changedPlugins = game.CheckForCyclicInteractions(blankEsm);
+
+  EXPECT_EQ(std::set<std::string>({blankEsm, blankMasterDependentEsp}),
+            changedPlugins);
+  for (const auto& pluginName : changedPlugins) {
+    auto messages = game.CheckInstallValidity(game.GetPlugin(pluginName),
+                                              PluginMetadata(pluginName));
+    ASSERT_EQ(1, messages.size());
+    EXPECT_EQ(MessageType::error, messages[0].GetType());
+  }
+
+  EXPECT_TRUE(game.CheckForCyclicInteractions(blankMasterDependentEsp).empty());
+
+  game.ClearUserMetadata(blankEsm);
+
+  EXPECT_EQ(changedPlugins, game.CheckForCyclicInteractions(blankEsm));
+  for (const auto& pluginName : changedPlugins) {
+    EXPECT_TRUE(game.CheckInstallValidity(game.GetPlugin(pluginName),
+                                          PluginMetadata(pluginName))
+                    .empty());
+  }
+}
+
+TEST_P(GameTest, applyLoadOrderProfileShouldSetTheSavedLoadOrder) {
+  Game game = CreateInitialisedGame(lootDataPath);
+
+  auto initialLoadOrder = game.GetLoadOrder();
+  game.SaveLoadOrderProfile("initial");
+  ASSERT_NO_THROW(game.SetLoadOrder(loadOrderToSet_));
+  ASSERT_NE(initialLoadOrder, game.GetLoadOrder());
+
+  auto diff = game.DiffLoadOrderProfile("initial", std::nullopt);
+  EXPECT_TRUE(diff.added.empty());
+  EXPECT_TRUE(diff.removed.empty());
+  EXPECT_FALSE(diff.moved.empty());
+
+  EXPECT_EQ(initialLoadOrder, game.ApplyLoadOrderProfile("initial"));
+  EXPECT_EQ(initialLoadOrder, game.GetLoadOrder());
+  EXPECT_TRUE(game.DiffLoadOrderProfile("initial", std::nullopt).moved.empty());
+}
+
+TEST_P(GameTest, applyLoadOrderProfileShouldThrowIfTheProfileDoesNotExist) {
+  Game game = CreateInitialisedGame(lootDataPath);
+
+  EXPECT_THROW(game.ApplyLoadOrderProfile("missing"), std::invalid_argument);
+}
+
+TEST_P(GameTest, loadOrderProfilesShouldNotBeSavedWithoutALootDataPath) {
+  Game game = CreateInitialisedGame("");
+
+  EXPECT_THROW(game.SaveLoadOrderProfile("initial"), std::runtime_error);
+  EXPECT_TRUE(game.GetLoadOrderProfileNames().empty());
+  EXPECT_FALSE(std::filesystem::exists(game.LoadOrderProfilesPath()));
+}
+
+TEST_P(GameTest, deleteLoadOrderProfileShouldRemoveTheSavedProfile) {
+  Game game = CreateInitialisedGame(lootDataPath);
+  game.SaveLoadOrderProfile("first");
+  game.SaveLoadOrderProfile("second");
+
+  EXPECT_TRUE(game.DeleteLoadOrderProfile("first"));
+  EXPECT_FALSE(game.DeleteLoadOrderProfile("first"));
+  EXPECT_EQ(std::vector<std::string>({"second"}),
+            game.GetLoadOrderProfileNames());
+}
+
 TEST_P(GameTest, setLoadOrderWithoutLoadedPluginsShouldIgnoreCurrentState) {
   using std::filesystem::u8path;
   Game game(defaultGameSettings, lootDataPath);
   game.Init();
 
   auto lootGamePath = lootDataPath / u8path(game.FolderName());
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile0));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile1));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile2));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile3));
+  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderJournalFile));
 
-  auto initialLoadOrder = getLoadOrder();
   ASSERT_NO_THROW(game.SetLoadOrder(loadOrderToSet_));
 
-  EXPECT_TRUE(std::filesystem::exists(lootGamePath / loadOrderBackupFile0));
-  EXPECT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile1));
-  EXPECT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile2));
-  EXPECT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile3));
-
-  auto loadOrder = readFileLines(lootGamePath / loadOrderBackupFile0);
-
-  EXPECT_TRUE(loadOrder.empty());
+  EXPECT_TRUE(std::filesystem::exists(lootGamePath / loadOrderJournalFile));
+  ASSERT_EQ(1, game.CountRecordedLoadOrders());
+  EXPECT_TRUE(game.GetRecordedLoadOrder(0).empty());
 }
 
-TEST_P(GameTest, setLoadOrderShouldCreateABackupOfTheCurrentLoadOrder) {
+TEST_P(GameTest, setLoadOrderShouldRecordTheCurrentLoadOrder) {
   using std::filesystem::u8path;
   Game game(defaultGameSettings, lootDataPath);
   game.Init();
   game.LoadAllInstalledPlugins(true);
 
   auto lootGamePath = lootDataPath / u8path(game.FolderName());
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile0));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile1));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile2));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile3));
+  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderJournalFile));
 
   auto initialLoadOrder = getLoadOrder();
   ASSERT_NO_THROW(game.SetLoadOrder(loadOrderToSet_));
 
-  EXPECT_TRUE(std::filesystem::exists(lootGamePath / loadOrderBackupFile0));
-  EXPECT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile1));
-  EXPECT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile2));
-  EXPECT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile3));
-
-  auto loadOrder = readFileLines(lootGamePath / loadOrderBackupFile0);
-
-  EXPECT_EQ(initialLoadOrder, loadOrder);
+  EXPECT_TRUE(std::filesystem::exists(lootGamePath / loadOrderJournalFile));
+  ASSERT_EQ(1, game.CountRecordedLoadOrders());
+  EXPECT_EQ(initialLoadOrder, game.GetRecordedLoadOrder(0));
 }
 
-TEST_P(GameTest, setLoadOrderShouldRollOverExistingBackups) {
-  using std::filesystem::u8path;
+TEST_P(GameTest, setLoadOrderShouldRecordEachLoadOrderThatIsReplaced) {
   Game game(defaultGameSettings, lootDataPath);
   game.Init();
   game.LoadAllInstalledPlugins(true);
 
-  auto lootGamePath = lootDataPath / u8path(game.FolderName());
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile0));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile1));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile2));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile3));
-
   auto initialLoadOrder = getLoadOrder();
   ASSERT_NO_THROW(game.SetLoadOrder(loadOrderToSet_));
 
@@ -748,30 +1229,39 @@ TEST_P(GameTest, setLoadOrderShouldRollOverExistingBackups) {
 
   ASSERT_NO_THROW(game.SetLoadOrder(loadOrderToSet_));
 
-  EXPECT_TRUE(std::filesystem::exists(lootGamePath / loadOrderBackupFile0));
-  EXPECT_TRUE(std::filesystem::exists(lootGamePath / loadOrderBackupFile1));
-  EXPECT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile2));
-  EXPECT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile3));
+  ASSERT_EQ(2, game.CountRecordedLoadOrders());
+  EXPECT_EQ(firstSetLoadOrder, game.GetRecordedLoadOrder(0));
+  EXPECT_EQ(initialLoadOrder, game.GetRecordedLoadOrder(1));
+  EXPECT_THROW(game.GetRecordedLoadOrder(2), std::out_of_range);
 
-  auto loadOrder = readFileLines(lootGamePath / loadOrderBackupFile0);
-  EXPECT_EQ(firstSetLoadOrder, loadOrder);
+  // The journal should be read back by a new game object.
+  Game otherGame(defaultGameSettings, lootDataPath);
+  otherGame.Init();
 
-  loadOrder = readFileLines(lootGamePath / loadOrderBackupFile1);
-  EXPECT_EQ(initialLoadOrder, loadOrder);
+  ASSERT_EQ(2, otherGame.CountRecordedLoadOrders());
+  EXPECT_EQ(firstSetLoadOrder, otherGame.GetRecordedLoadOrder(0));
+  EXPECT_EQ(initialLoadOrder, otherGame.GetRecordedLoadOrder(1));
 }
 
-TEST_P(GameTest, setLoadOrderShouldKeepUpToThreeBackups) {
-  using std::filesystem::u8path;
+TEST_P(GameTest, setLoadOrderShouldNotRecordAnUnchangedLoadOrder) {
   Game game(defaultGameSettings, lootDataPath);
   game.Init();
+  game.LoadAllInstalledPlugins(true);
 
-  auto lootGamePath = lootDataPath / u8path(game.FolderName());
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile0));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile1));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile2));
-  ASSERT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile3));
+  ASSERT_NO_THROW(game.SetLoadOrder(loadOrderToSet_));
+  ASSERT_EQ(1, game.CountRecordedLoadOrders());
+
+  ASSERT_NO_THROW(game.SetLoadOrder(loadOrderToSet_));
+
+  EXPECT_EQ(1, game.CountRecordedLoadOrders());
+  EXPECT_EQ(loadOrderToSet_, game.GetLoadOrder());
+}
+
+TEST_P(GameTest, restoreLoadOrderShouldSetARecordedLoadOrder) {
+  Game game(defaultGameSettings, lootDataPath);
+  game.Init();
+  game.LoadAllInstalledPlugins(true);
 
-  auto initialLoadOrder = getLoadOrder();
   ASSERT_NO_THROW(game.SetLoadOrder(loadOrderToSet_));
 
   auto firstSetLoadOrder = loadOrderToSet_;
@@ -783,37 +1273,17 @@ TEST_P(GameTest, setLoadOrderShouldKeepUpToThreeBackups) {
 
   ASSERT_NO_THROW(game.SetLoadOrder(loadOrderToSet_));
 
-  auto secondSetLoadOrder = loadOrderToSet_;
-
   ASSERT_NE(blankMasterDependentEsp, loadOrderToSet_[7]);
   ASSERT_NE(blankEsp, loadOrderToSet_[8]);
   loadOrderToSet_[7] = blankMasterDependentEsp;
   loadOrderToSet_[8] = blankEsp;
 
   ASSERT_NO_THROW(game.SetLoadOrder(loadOrderToSet_));
+  ASSERT_EQ(firstSetLoadOrder, game.GetRecordedLoadOrder(1));
 
-  auto thirdSetLoadOrder = loadOrderToSet_;
-
-  ASSERT_NE(blankDifferentMasterDependentEsm, loadOrderToSet_[3]);
-  ASSERT_NE(blankDifferentEsm, loadOrderToSet_[4]);
-  loadOrderToSet_[3] = blankDifferentMasterDependentEsm;
-  loadOrderToSet_[4] = blankDifferentEsm;
-
-  ASSERT_NO_THROW(game.SetLoadOrder(loadOrderToSet_));
-
-  EXPECT_TRUE(std::filesystem::exists(lootGamePath / loadOrderBackupFile0));
-  EXPECT_TRUE(std::filesystem::exists(lootGamePath / loadOrderBackupFile1));
-  EXPECT_TRUE(std::filesystem::exists(lootGamePath / loadOrderBackupFile2));
-  EXPECT_FALSE(std::filesystem::exists(lootGamePath / loadOrderBackupFile3));
-
-  auto loadOrder = readFileLines(lootGamePath / loadOrderBackupFile0);
-  EXPECT_EQ(thirdSetLoadOrder, loadOrder);
-
-  loadOrder = readFileLines(lootGamePath / loadOrderBackupFile1);
-  EXPECT_EQ(secondSetLoadOrder, loadOrder);
-
-  loadOrder = readFileLines(lootGamePath / loadOrderBackupFile2);
-  EXPECT_EQ(firstSetLoadOrder, loadOrder);
+  EXPECT_EQ(firstSetLoadOrder, game.RestoreLoadOrder(1));
+  EXPECT_EQ(firstSetLoadOrder, game.GetLoadOrder());
+  EXPECT_EQ(4, game.CountRecordedLoadOrders());
 }
 
 TEST_P(GameTest, aMessageShouldBeCachedByDefault) {
@@ -27,12 +27,17 @@ along with LOOT.  If not, see
 
 #include "gui/state/game/games_manager.h"
 
+#include <future>
+
 #include "tests/common_game_test_fixture.h"
 
 namespace loot {
 namespace test {
 class TestGamesManager : public GamesManager {
 public:
+  TestGamesManager() :
+      TestGamesManager(std::make_shared<std::promise<void>>()) {}
+
   int GetInitialiseCount(const std::string& folderName) {
     auto it = initialiseCounts_.find(folderName);
     if (it == initialiseCounts_.end()) {
@@ -43,15 +48,26 @@ public:
   }
 
 private:
-  std::optional<std::filesystem::path> FindGamePath(
-      const GameSettings& gameSettings) const {
-    if (gameSettings.Type() == GameType::tes5 ||
-        gameSettings.Type() == GameType::fonv) {
-      return gameSettings.GamePath() / gameSettings.FolderName();
-    }
-
-    return std::nullopt;
-  }
+  explicit TestGamesManager(std::shared_ptr<std::promise<void>> slowDrive) :
+      GamesManager(
+          [slowDriveReady = slowDrive->get_future().share()](
+              const GameSettings& gameSettings)
+              -> std::optional<std::filesystem::path> {
+            if (gameSettings.Type() == GameType::tes5 ||
+                gameSettings.Type() == GameType::fonv) {
+              return gameSettings.GamePath() / gameSettings.FolderName();
+            }
+
+            // Simulate a game on a drive that doesn't respond until this
+            // manager is destroyed.
+            if (gameSettings.Type() == GameType::fo4) {
+              slowDriveReady.wait();
+              return gameSettings.GamePath() / gameSettings.FolderName();
+            }
+
+            return std::nullopt;
+          }),
+      slowDrive_(slowDrive) {}
 
   void InitialiseGameData(gui::Game& game) {
     auto it = initialiseCounts_.find(game.FolderName());
@@ -62,7 +78,18 @@ private:
     }
   }
 
+  size_t EstimateMemoryUsage(const gui::Game& game) const {
+    return GAME_MEMORY_USAGE;
+  }
+
+  void UnloadGameData(gui::Game& game) {}
+
   mutable std::map<std::string, unsigned int> initialiseCounts_;
+  // Destroying the promise lets any probe of the slow drive finish.
+  std::shared_ptr<std::promise<void>> slowDrive_;
+
+public:
+  static constexpr size_t GAME_MEMORY_USAGE = 100;
 };
 
 TEST(GamesManager,
@@ -98,6 +125,22 @@ TEST(GamesManager, loadInstalledGamesShouldSetTheGamePathsOfInstalledGames) {
   EXPECT_EQ("FalloutNV", settings[2].GamePath());
 }
 
+TEST(GamesManager,
+     loadInstalledGamesShouldTreatAGameThatTakesTooLongToDetectAsNotInstalled) {
+  TestGamesManager manager;
+  manager.SetGameDetectionTimeout(std::chrono::milliseconds(500));
+  manager.LoadInstalledGames(
+      {
+          GameSettings(GameType::tes5),
+          GameSettings(GameType::fo4),
+          GameSettings(GameType::fonv),
+      },
+      std::filesystem::path());
+
+  EXPECT_EQ(std::vector<std::string>({"Skyrim", "FalloutNV"}),
+            manager.GetInstalledGameFolderNames());
+}
+
 TEST(
     GamesManager,
     loadInstalledGamesShouldThrowAnExceptionIfTheCurrentGameIsNoLongerInstalled) {
@@ -299,6 +342,71 @@ TEST(GamesManager, setCurrentGameShouldInitialiseGameData) {
       1, manager.GetInitialiseCount(GameSettings(GameType::tes5).FolderName()));
 }
 
+TEST(GamesManager,
+     setCurrentGameShouldNotReinitialiseARecentlyUsedGameWithinTheBudget) {
+  TestGamesManager manager;
+  manager.SetWarmGamesMemoryBudget(2 * TestGamesManager::GAME_MEMORY_USAGE);
+  manager.LoadInstalledGames(
+      {
+          GameSettings(GameType::tes5),
+          GameSettings(GameType::fonv),
+      },
+      std::filesystem::path());
+
+  auto skyrim = GameSettings(GameType::tes5).FolderName();
+  auto falloutNV = GameSettings(GameType::fonv).FolderName();
+  manager.SetCurrentGame(skyrim);
+  manager.SetCurrentGame(falloutNV);
+  manager.SetCurrentGame(skyrim);
+
+  EXPECT_EQ(skyrim, manager.GetCurrentGame().FolderName());
+  EXPECT_EQ(1, manager.GetInitialiseCount(skyrim));
+  EXPECT_EQ(1, manager.GetInitialiseCount(falloutNV));
+}
+
+TEST(GamesManager,
+     setCurrentGameShouldReinitialiseAGameThatWasEvictedToStayWithinTheBudget) {
+  TestGamesManager manager;
+  manager.SetWarmGamesMemoryBudget(TestGamesManager::GAME_MEMORY_USAGE);
+  manager.LoadInstalledGames(
+      {
+          GameSettings(GameType::tes5),
+          GameSettings(GameType::fonv),
+      },
+      std::filesystem::path());
+
+  auto skyrim = GameSettings(GameType::tes5).FolderName();
+  auto falloutNV = GameSettings(GameType::fonv).FolderName();
+  manager.SetCurrentGame(skyrim);
+  manager.SetCurrentGame(falloutNV);
+  manager.SetCurrentGame(skyrim);
+
+  EXPECT_EQ(2, manager.GetInitialiseCount(skyrim));
+  EXPECT_EQ(1, manager.GetInitialiseCount(falloutNV));
+}
+
+TEST(GamesManager,
+     loadInstalledGamesShouldKeepARecentlyUsedGameWarmIfItsSettingsAreUnchanged) {
+  TestGamesManager manager;
+  manager.SetWarmGamesMemoryBudget(2 * TestGamesManager::GAME_MEMORY_USAGE);
+  std::vector<GameSettings> gamesSettings({
+      GameSettings(GameType::tes5),
+      GameSettings(GameType::fonv),
+  });
+  manager.LoadInstalledGames(gamesSettings, std::filesystem::path());
+
+  auto skyrim = GameSettings(GameType::tes5).FolderName();
+  auto falloutNV = GameSettings(GameType::fonv).FolderName();
+  manager.SetCurrentGame(skyrim);
+  manager.SetCurrentGame(falloutNV);
+
+  manager.LoadInstalledGames(gamesSettings, std::filesystem::path());
+  manager.SetCurrentGame(skyrim);
+
+  EXPECT_EQ(1, manager.GetInitialiseCount(skyrim));
+  EXPECT_EQ(1, manager.GetInitialiseCount(falloutNV));
+}
+
 TEST(GamesManager,
      getFirstInstalledGameFolderNameShouldReturnNulloptIfNoGamesAreInstalled) {
   TestGamesManager manager;
@@ -345,6 +453,37 @@ TEST(
   });
   EXPECT_EQ(expectedFolderNames, manager.GetInstalledGameFolderNames());
 }
+
+TEST(GamesManager, updateAllMasterlistsShouldReturnEmptyIfNoGamesAreInstalled) {
+  TestGamesManager manager;
+
+  EXPECT_TRUE(manager.UpdateAllMasterlists().empty());
+}
+
+TEST(GamesManager,
+     updateAllMasterlistsShouldRecordAnErrorForEachGameThatCouldNotBeUpdated) {
+  TestGamesManager manager;
+  manager.LoadInstalledGames(
+      {
+          GameSettings(GameType::tes5),
+          GameSettings(GameType::fonv),
+      },
+      std::filesystem::path());
+
+  // The games' paths don't exist, so game handles can't be created for them.
+  auto summaries = manager.UpdateAllMasterlists(2);
+
+  ASSERT_EQ(2, summaries.size());
+  EXPECT_EQ(GameSettings(GameType::tes5).FolderName(),
+            summaries[0].folderName);
+  EXPECT_EQ(GameSettings(GameType::fonv).FolderName(),
+            summaries[1].folderName);
+  for (const auto& summary : summaries) {
+    EXPECT_TRUE(summary.error.has_value());
+    EXPECT_FALSE(summary.wasChanged);
+    EXPECT_FALSE(summary.isUsingFallback);
+  }
+}
 }
 }
 
@@ -189,6 +189,43 @@ TEST(ToMessage,
       message.GetContent(MessageContent::defaultLanguage).GetText());
 }
 
+TEST(GetMasterlistRepositoryFolderName,
+     shouldBeTheSameForTheSameRepositoryAndBranch) {
+  EXPECT_EQ(GetMasterlistRepositoryFolderName(
+                "https://github.com/loot/skyrimse.git", "v0.15"),
+            GetMasterlistRepositoryFolderName(
+                "https://github.com/loot/skyrimse.git", "v0.15"));
+}
+
+TEST(GetMasterlistRepositoryFolderName,
+     shouldBeDifferentForDifferentRepositoriesOrBranches) {
+  auto folderName = GetMasterlistRepositoryFolderName(
+      "https://github.com/loot/skyrimse.git", "v0.15");
+
+  EXPECT_NE(folderName,
+            GetMasterlistRepositoryFolderName(
+                "https://github.com/loot/skyrimse.git", "master"));
+  EXPECT_NE(folderName,
+            GetMasterlistRepositoryFolderName(
+                "https://github.com/other/skyrimse.git", "v0.15"));
+}
+
+TEST(GetMasterlistRepositoryFolderName,
+     shouldStartWithTheRepositoryNameWithoutItsExtension) {
+  auto folderName = GetMasterlistRepositoryFolderName(
+      "https://github.com/loot/skyrimse.git", "v0.15");
+
+  EXPECT_EQ(0, folderName.rfind("skyrimse-", 0));
+  EXPECT_EQ(std::string("skyrimse-").length() + 8, folderName.length());
+}
+
+TEST(GetMasterlistRepositoryFolderName,
+     shouldReplaceCharactersThatAreNotSafeInFolderNames) {
+  auto folderName = GetMasterlistRepositoryFolderName("C:\\repos\\a*b?", "");
+
+  EXPECT_EQ(0, folderName.rfind("a_b_-", 0));
+}
+
 TEST(SplitRegistryPath, shouldAssumeHKLMIfNoRootKeyIsGiven) {
   auto[rootKey, subKey, value] = SplitRegistryPath("sub\\key\\value");
 
@@ -225,6 +262,28 @@ TEST(SplitRegistryPath, shouldThrowIfInputIsEmptyOrOnlyBackslashes) {
   EXPECT_THROW(SplitRegistryPath("\\"), std::invalid_argument);
   EXPECT_THROW(SplitRegistryPath(""), std::invalid_argument);
 }
+
+TEST(HasSameMetadata, shouldIgnoreNames) {
+  PluginMetadata lhs("A.esp");
+  lhs.SetGroup("group");
+  PluginMetadata rhs("B.esp");
+  rhs.SetGroup("group");
+
+  EXPECT_TRUE(HasSameMetadata(lhs, rhs));
+}
+
+TEST(HasSameMetadata, shouldBeFalseIfAnyMetadataDiffers) {
+  PluginMetadata lhs("A.esp");
+  lhs.SetTags({Tag("Relev")});
+  PluginMetadata rhs("A.esp");
+
+  EXPECT_FALSE(HasSameMetadata(lhs, rhs));
+
+  rhs.SetTags({Tag("Relev")});
+  rhs.SetLoadAfterFiles({File("B.esp")});
+
+  EXPECT_FALSE(HasSameMetadata(lhs, rhs));
+}
 }
 }
 
@@ -0,0 +1,251 @@
+/*  LOOT
+
+    A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+    Fallout: New Vegas.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_GAME_INTERACTION_GRAPH_TEST
+#define LOOT_TESTS_GUI_STATE_GAME_INTERACTION_GRAPH_TEST
+
+#include "gui/state/game/interaction_graph.h"
+
+#include <gtest/gtest.h>
+
+#include "loot/exception/cyclic_interaction_error.h"
+#include "loot/exception/undefined_group_error.h"
+
+namespace loot {
+namespace gui {
+namespace test {
+class GraphTestPlugin : public PluginInterface {
+public:
+  GraphTestPlugin(std::string name,
+                  bool isMaster,
+                  std::vector<std::string> masters = {}) :
+      name_(name),
+      isMaster_(isMaster),
+      masters_(masters) {}
+
+  std::string GetName() const override { return name_; }
+
+  float GetHeaderVersion() const { return 0.0f; }
+
+  std::optional<std::string> GetVersion() const { return std::nullopt; }
+
+  std::vector<std::string> GetMasters() const { return masters_; }
+
+  std::vector<Tag> GetBashTags() const { return {}; }
+
+  std::optional<uint32_t> GetCRC() const { return std::nullopt; }
+
+  bool IsMaster() const { return isMaster_; }
+
+  bool IsLightMaster() const { return false; }
+
+  bool IsValidAsLightMaster() const { return false; }
+
+  bool IsEmpty() const { return false; }
+
+  bool LoadsArchive() const { return false; }
+
+  bool DoFormIDsOverlap(const PluginInterface& plugin) const { return false; }
+
+private:
+  const std::string name_;
+  const bool isMaster_;
+  const std::vector<std::string> masters_;
+};
+
+class InteractionGraphTest : public ::testing::Test {
+protected:
+  InteractionGraphTest() :
+      snapshot_(std::make_shared<PluginSnapshot>(
+          std::vector<std::shared_ptr<const PluginInterface>>({
+              std::make_shared<GraphTestPlugin>("A.esm", true),
+              std::make_shared<GraphTestPlugin>(
+                  "B.esp", false, std::vector<std::string>({"A.esm"})),
+              std::make_shared<GraphTestPlugin>("C.esp", false),
+          }),
+          [](const std::string&) { return true; })) {}
+
+  PluginMetadata LoadAfter(const std::string& pluginName,
+                           const std::string& fileName) {
+    PluginMetadata metadata(pluginName);
+    metadata.SetLoadAfterFiles({File(fileName)});
+    return metadata;
+  }
+
+  std::shared_ptr<const PluginSnapshot> snapshot_;
+};
+
+TEST_F(InteractionGraphTest, findCycleShouldReturnNulloptIfThereIsNoCycle) {
+  InteractionGraph graph(snapshot_);
+  graph.SetMetadata(LoadAfter("C.esp", "B.esp"), true);
+
+  EXPECT_FALSE(graph.FindCycle("A.esm").has_value());
+  EXPECT_FALSE(graph.FindCycle("B.esp").has_value());
+  EXPECT_FALSE(graph.FindCycle("C.esp").has_value());
+}
+
+TEST_F(InteractionGraphTest,
+       findCycleShouldReturnNulloptIfThePluginIsNotInTheSnapshot) {
+  InteractionGraph graph(snapshot_);
+
+  EXPECT_FALSE(graph.FindCycle("D.esp").has_value());
+}
+
+TEST_F(InteractionGraphTest,
+       findCycleShouldFindACycleCausedByLoadAfterMetadata) {
+  InteractionGraph graph(snapshot_);
+  graph.SetMetadata(LoadAfter("B.esp", "C.esp"), false);
+  graph.SetMetadata(LoadAfter("C.esp", "B.esp"), true);
+
+  auto cycle = graph.FindCycle("C.esp");
+
+  ASSERT_TRUE(cycle.has_value());
+  ASSERT_EQ(2, cycle.value().size());
+  EXPECT_EQ("C.esp", cycle.value()[0].GetName());
+  EXPECT_EQ(EdgeType::masterlistLoadAfter,
+            cycle.value()[0].GetTypeOfEdgeToNextVertex());
+  EXPECT_EQ("B.esp", cycle.value()[1].GetName());
+  EXPECT_EQ(EdgeType::userLoadAfter,
+            cycle.value()[1].GetTypeOfEdgeToNextVertex());
+}
+
+TEST_F(InteractionGraphTest, findCycleShouldFindACycleInvolvingMasters) {
+  InteractionGraph graph(snapshot_);
+  graph.SetMetadata(LoadAfter("A.esm", "B.esp"), true);
+
+  auto cycle = graph.FindCycle("A.esm");
+
+  ASSERT_TRUE(cycle.has_value());
+  ASSERT_EQ(2, cycle.value().size());
+  EXPECT_EQ("A.esm", cycle.value()[0].GetName());
+  EXPECT_EQ(EdgeType::master, cycle.value()[0].GetTypeOfEdgeToNextVertex());
+  EXPECT_EQ("B.esp", cycle.value()[1].GetName());
+  EXPECT_EQ(EdgeType::userLoadAfter,
+            cycle.value()[1].GetTypeOfEdgeToNextVertex());
+}
+
+TEST_F(InteractionGraphTest, findCycleShouldFindACycleInvolvingTheMasterFlag) {
+  InteractionGraph graph(snapshot_);
+  graph.SetMetadata(LoadAfter("A.esm", "C.esp"), true);
+
+  auto cycle = graph.FindCycle("C.esp");
+
+  ASSERT_TRUE(cycle.has_value());
+  ASSERT_EQ(2, cycle.value().size());
+  EXPECT_EQ("C.esp", cycle.value()[0].GetName());
+  EXPECT_EQ(EdgeType::userLoadAfter,
+            cycle.value()[0].GetTypeOfEdgeToNextVertex());
+  EXPECT_EQ("A.esm", cycle.value()[1].GetName());
+  EXPECT_EQ(EdgeType::masterFlag,
+            cycle.value()[1].GetTypeOfEdgeToNextVertex());
+}
+
+TEST_F(InteractionGraphTest,
+       setMetadataShouldReplaceEdgesFromTheSameSourceOnly) {
+  InteractionGraph graph(snapshot_);
+  graph.SetMetadata(LoadAfter("B.esp", "C.esp"), false);
+  graph.SetMetadata(LoadAfter("C.esp", "B.esp"), true);
+  ASSERT_TRUE(graph.FindCycle("C.esp").has_value());
+
+  graph.SetMetadata(PluginMetadata("C.esp"), true);
+  EXPECT_FALSE(graph.FindCycle("C.esp").has_value());
+
+  graph.SetMetadata(LoadAfter("C.esp", "B.esp"), true);
+  graph.SetMetadata(PluginMetadata("B.esp"), true);
+  EXPECT_TRUE(graph.FindCycle("C.esp").has_value());
+}
+
+TEST_F(InteractionGraphTest,
+       getDependentPluginsShouldReturnPluginsWhoseMetadataListsThePlugin) {
+  InteractionGraph graph(snapshot_);
+  PluginMetadata metadata("B.esp");
+  metadata.SetRequirements({File("C.esp")});
+  graph.SetMetadata(metadata, false);
+  metadata = PluginMetadata("A.esm");
+  metadata.SetIncompatibilities({File("C.esp")});
+  graph.SetMetadata(metadata, true);
+
+  EXPECT_EQ(std::set<std::string>({"A.esm", "B.esp"}),
+            graph.GetDependentPlugins("C.esp"));
+  EXPECT_TRUE(graph.GetDependentPlugins("B.esp").empty());
+}
+
+TEST_F(InteractionGraphTest,
+       getDependentPluginsShouldNotReturnPluginsThatOnlyHaveItAsAMaster) {
+  InteractionGraph graph(snapshot_);
+
+  EXPECT_TRUE(graph.GetDependentPlugins("A.esm").empty());
+}
+
+TEST_F(InteractionGraphTest,
+       setMetadataShouldReplaceIncompatibilitiesFromTheSameSourceOnly) {
+  InteractionGraph graph(snapshot_);
+  PluginMetadata metadata("B.esp");
+  metadata.SetIncompatibilities({File("C.esp")});
+  graph.SetMetadata(metadata, false);
+  graph.SetMetadata(metadata, true);
+
+  graph.SetMetadata(PluginMetadata("B.esp"), true);
+  EXPECT_EQ(std::set<std::string>({"B.esp"}),
+            graph.GetDependentPlugins("C.esp"));
+
+  graph.SetMetadata(PluginMetadata("B.esp"), false);
+  EXPECT_TRUE(graph.GetDependentPlugins("C.esp").empty());
+}
+
+TEST(ValidateGroups, shouldNotThrowIfGroupsAreValid) {
+  std::vector<Group> masterlistGroups({Group("early"), Group("late", {"early"})});
+  std::vector<Group> userGroups({Group("later", {"late", "default"})});
+
+  EXPECT_NO_THROW(ValidateGroups(masterlistGroups, userGroups));
+}
+
+TEST(ValidateGroups, shouldThrowIfAGroupLoadsAfterAnUndefinedGroup) {
+  std::vector<Group> masterlistGroups({Group("early")});
+  std::vector<Group> userGroups({Group("late", {"missing"})});
+
+  EXPECT_THROW(ValidateGroups(masterlistGroups, userGroups),
+               UndefinedGroupError);
+}
+
+TEST(ValidateGroups, shouldThrowIfGroupsFormACycle) {
+  std::vector<Group> masterlistGroups({Group("early"), Group("late", {"early"})});
+  std::vector<Group> userGroups({Group("early", {"late"})});
+
+  try {
+    ValidateGroups(masterlistGroups, userGroups);
+    FAIL();
+  } catch (CyclicInteractionError& e) {
+    ASSERT_EQ(2, e.GetCycle().size());
+    EXPECT_EQ(EdgeType::masterlistLoadAfter,
+              e.GetCycle()[0].GetTypeOfEdgeToNextVertex());
+    EXPECT_EQ(EdgeType::userLoadAfter,
+              e.GetCycle()[1].GetTypeOfEdgeToNextVertex());
+  }
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,185 @@
+/*  LOOT
+
+    A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+    Fallout: New Vegas.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_GAME_LOAD_ORDER_JOURNAL_TEST
+#define LOOT_TESTS_GUI_STATE_GAME_LOAD_ORDER_JOURNAL_TEST
+
+#include "gui/state/game/load_order_journal.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <fstream>
+
+#include "tests/common_game_test_fixture.h"
+
+namespace loot {
+namespace gui {
+namespace test {
+class LoadOrderJournalTest : public loot::test::CommonGameTestFixture {
+protected:
+  LoadOrderJournalTest() :
+      journalFile_(lootDataPath / "loadorder.journal"),
+      loadOrder_({"A.esm", "B.esm", "C.esp", "D.esp", "E.esp", "F.esp"}) {}
+
+  // Each load order has two plugins swapped relative to the previous one.
+  std::vector<std::vector<std::string>> RecordLoadOrders(
+      LoadOrderJournal& journal,
+      size_t count) {
+    std::vector<std::vector<std::string>> loadOrders;
+    for (size_t i = 0; i < count; ++i) {
+      std::swap(loadOrder_[i % loadOrder_.size()],
+                loadOrder_[(i + 1) % loadOrder_.size()]);
+      journal.Record(loadOrder_);
+      loadOrders.push_back(loadOrder_);
+    }
+
+    return loadOrders;
+  }
+
+  const std::filesystem::path journalFile_;
+  std::vector<std::string> loadOrder_;
+};
+
+// Pass an empty first argument, as it's a prefix for the test instantation,
+// but we only have the one so no prefix is necessary.
+INSTANTIATE_TEST_CASE_P(,
+                        LoadOrderJournalTest,
+                        ::testing::Values(GameType::tes5));
+
+TEST_P(LoadOrderJournalTest, countLoadOrdersShouldBeZeroIfTheFileDoesNotExist) {
+  LoadOrderJournal journal(journalFile_);
+
+  EXPECT_EQ(0, journal.CountLoadOrders());
+  EXPECT_THROW(journal.GetLoadOrder(0), std::out_of_range);
+}
+
+TEST_P(LoadOrderJournalTest, recordShouldOnlyAppendToTheFile) {
+  LoadOrderJournal journal(journalFile_);
+  RecordLoadOrders(journal, 1);
+  auto firstRecord = readFileLines(journalFile_);
+
+  RecordLoadOrders(journal, 1);
+  auto records = readFileLines(journalFile_);
+
+  ASSERT_GT(records.size(), firstRecord.size());
+  EXPECT_TRUE(
+      std::equal(firstRecord.begin(), firstRecord.end(), records.begin()));
+}
+
+TEST_P(LoadOrderJournalTest,
+       getLoadOrderShouldReturnEachRecordedLoadOrderAcrossCheckpoints) {
+  LoadOrderJournal journal(journalFile_, 50, 3);
+  auto loadOrders = RecordLoadOrders(journal, 10);
+
+  ASSERT_EQ(loadOrders.size(), journal.CountLoadOrders());
+  for (size_t age = 0; age < loadOrders.size(); ++age) {
+    EXPECT_EQ(loadOrders[loadOrders.size() - 1 - age],
+              journal.GetLoadOrder(age));
+  }
+
+  LoadOrderJournal reloadedJournal(journalFile_, 50, 3);
+  ASSERT_EQ(loadOrders.size(), reloadedJournal.CountLoadOrders());
+  for (size_t age = 0; age < loadOrders.size(); ++age) {
+    EXPECT_EQ(loadOrders[loadOrders.size() - 1 - age],
+              reloadedJournal.GetLoadOrder(age));
+  }
+}
+
+TEST_P(LoadOrderJournalTest, recordShouldRetainAtMostTheMaximumLoadOrders) {
+  LoadOrderJournal journal(journalFile_, 4, 2);
+  auto loadOrders = RecordLoadOrders(journal, 11);
+
+  EXPECT_GE(journal.CountLoadOrders(), 4);
+  EXPECT_LT(journal.CountLoadOrders(), 6);
+  EXPECT_EQ(loadOrders.back(), journal.GetLoadOrder(0));
+
+  LoadOrderJournal reloadedJournal(journalFile_, 4, 2);
+  ASSERT_EQ(journal.CountLoadOrders(), reloadedJournal.CountLoadOrders());
+  for (size_t age = 0; age < journal.CountLoadOrders(); ++age) {
+    EXPECT_EQ(loadOrders[loadOrders.size() - 1 - age],
+              reloadedJournal.GetLoadOrder(age));
+  }
+}
+
+TEST_P(LoadOrderJournalTest, loadShouldDiscardAnIncompleteFinalRecord) {
+  std::vector<std::vector<std::string>> loadOrders;
+  {
+    LoadOrderJournal journal(journalFile_);
+    loadOrders = RecordLoadOrders(journal, 3);
+  }
+  std::filesystem::resize_file(journalFile_,
+                               std::filesystem::file_size(journalFile_) - 2);
+
+  LoadOrderJournal journal(journalFile_);
+
+  ASSERT_EQ(2, journal.CountLoadOrders());
+  EXPECT_EQ(loadOrders[1], journal.GetLoadOrder(0));
+
+  RecordLoadOrders(journal, 1);
+
+  LoadOrderJournal reloadedJournal(journalFile_);
+  ASSERT_EQ(3, reloadedJournal.CountLoadOrders());
+  EXPECT_EQ(loadOrder_, reloadedJournal.GetLoadOrder(0));
+}
+
+TEST_P(LoadOrderJournalTest,
+       loadShouldMoveTheJournalAsideIfARecordBeforeTheLastIsBad) {
+  {
+    LoadOrderJournal journal(journalFile_);
+    RecordLoadOrders(journal, 3);
+  }
+
+  // The first record is a checkpoint of the six plugins, so its header and
+  // plugin names are followed by the second record's header.
+  auto lines = readFileLines(journalFile_);
+  ASSERT_EQ('D', lines.at(7).at(0));
+  lines[7] = "X";
+  {
+    std::ofstream out(journalFile_, std::ios::binary | std::ios::trunc);
+    for (const auto& line : lines) {
+      out << line << '\n';
+    }
+  }
+
+  auto backupFile = journalFile_;
+  backupFile += ".bak";
+
+  LoadOrderJournal journal(journalFile_);
+
+  EXPECT_EQ(0, journal.CountLoadOrders());
+  EXPECT_FALSE(std::filesystem::exists(journalFile_));
+  EXPECT_EQ(lines, readFileLines(backupFile));
+
+  RecordLoadOrders(journal, 1);
+
+  LoadOrderJournal reloadedJournal(journalFile_);
+  ASSERT_EQ(1, reloadedJournal.CountLoadOrders());
+  EXPECT_EQ(loadOrder_, reloadedJournal.GetLoadOrder(0));
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,160 @@
+/*  LOOT
+
+    A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+    Fallout: New Vegas.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_GAME_LOAD_ORDER_PROFILES_TEST
+#define LOOT_TESTS_GUI_STATE_GAME_LOAD_ORDER_PROFILES_TEST
+
+#include "gui/state/game/load_order_profiles.h"
+
+#include <gtest/gtest.h>
+
+#include "tests/common_game_test_fixture.h"
+
+namespace loot {
+namespace gui {
+namespace test {
+class LoadOrderProfilesTest : public loot::test::CommonGameTestFixture {
+protected:
+  LoadOrderProfilesTest() : profilesFile_(lootDataPath / "profiles.toml") {}
+
+  const std::filesystem::path profilesFile_;
+  LoadOrderProfiles profiles_;
+};
+
+// Pass an empty first argument, as it's a prefix for the test instantation,
+// but we only have the one so no prefix is necessary.
+INSTANTIATE_TEST_CASE_P(,
+                        LoadOrderProfilesTest,
+                        ::testing::Values(GameType::tes5));
+
+TEST_P(LoadOrderProfilesTest, getLoadOrderShouldReturnNulloptForAnUnknownName) {
+  EXPECT_FALSE(profiles_.GetLoadOrder("profile").has_value());
+}
+
+TEST_P(LoadOrderProfilesTest, setLoadOrderShouldReplaceAnExistingProfile) {
+  profiles_.SetLoadOrder("profile", {"A.esm", "B.esp"});
+  profiles_.SetLoadOrder("profile", {"B.esp"});
+
+  EXPECT_EQ(std::vector<std::string>({"B.esp"}),
+            profiles_.GetLoadOrder("profile").value());
+}
+
+TEST_P(LoadOrderProfilesTest,
+       profilesShouldShareCaseInsensitivelyEqualPluginNames) {
+  profiles_.SetLoadOrder("first", {"A.esm", "B.esp"});
+  profiles_.SetLoadOrder("second", {"b.esp", "a.esm"});
+
+  EXPECT_EQ(std::vector<std::string>({"B.esp", "A.esm"}),
+            profiles_.GetLoadOrder("second").value());
+}
+
+TEST_P(LoadOrderProfilesTest, removeShouldReturnFalseForAnUnknownName) {
+  EXPECT_FALSE(profiles_.Remove("profile"));
+}
+
+TEST_P(LoadOrderProfilesTest, removeShouldRemoveTheNamedProfile) {
+  profiles_.SetLoadOrder("first", {"A.esm"});
+  profiles_.SetLoadOrder("second", {"B.esp"});
+
+  EXPECT_TRUE(profiles_.Remove("first"));
+  EXPECT_EQ(std::vector<std::string>({"second"}), profiles_.GetNames());
+}
+
+TEST_P(LoadOrderProfilesTest, loadShouldClearProfilesIfTheFileDoesNotExist) {
+  profiles_.SetLoadOrder("profile", {"A.esm"});
+
+  profiles_.Load(profilesFile_);
+
+  EXPECT_TRUE(profiles_.GetNames().empty());
+}
+
+TEST_P(LoadOrderProfilesTest, loadShouldReadProfilesThatWereSaved) {
+  profiles_.SetLoadOrder("first", {"A.esm", "B.esp", "C.esp"});
+  profiles_.SetLoadOrder("second", {"C.esp", "A.esm"});
+  profiles_.Remove("first");
+  profiles_.Save(profilesFile_);
+
+  LoadOrderProfiles profiles;
+  profiles.Load(profilesFile_);
+
+  EXPECT_EQ(std::vector<std::string>({"second"}), profiles.GetNames());
+  EXPECT_EQ(std::vector<std::string>({"C.esp", "A.esm"}),
+            profiles.GetLoadOrder("second").value());
+}
+
+TEST_P(LoadOrderProfilesTest, saveShouldReplaceTheFileWithoutLeavingATempFile) {
+  profiles_.SetLoadOrder("first", {"A.esm"});
+  profiles_.Save(profilesFile_);
+  profiles_.Remove("first");
+  profiles_.SetLoadOrder("second", {"B.esp"});
+  profiles_.Save(profilesFile_);
+
+  LoadOrderProfiles profiles;
+  profiles.Load(profilesFile_);
+
+  EXPECT_EQ(std::vector<std::string>({"second"}), profiles.GetNames());
+  EXPECT_FALSE(std::filesystem::exists(profilesFile_.string() + ".tmp"));
+}
+
+TEST(DiffLoadOrders, shouldListAddedRemovedAndMovedPlugins) {
+  auto diff = DiffLoadOrders({"A.esm", "B.esp", "C.esp", "D.esp"},
+                             {"A.esm", "c.esp", "D.esp", "B.esp", "E.esp"});
+
+  EXPECT_EQ(std::vector<std::string>({"E.esp"}), diff.added);
+  EXPECT_TRUE(diff.removed.empty());
+  EXPECT_EQ(std::vector<std::string>({"B.esp"}), diff.moved);
+
+  diff = DiffLoadOrders({"A.esm", "B.esp"}, {"A.esm"});
+
+  EXPECT_TRUE(diff.added.empty());
+  EXPECT_EQ(std::vector<std::string>({"B.esp"}), diff.removed);
+  EXPECT_TRUE(diff.moved.empty());
+}
+
+TEST(DiffLoadOrders, shouldListOnlyTheFewestPluginsThatNeedToMove) {
+  auto diff = DiffLoadOrders({"E.esp", "A.esm", "B.esp", "C.esp", "D.esp"},
+                             {"A.esm", "B.esp", "C.esp", "D.esp", "E.esp"});
+
+  EXPECT_EQ(std::vector<std::string>({"E.esp"}), diff.moved);
+}
+
+TEST(FitLoadOrder,
+     shouldDropUninstalledPluginsAndKeepUnprofiledPluginsInPlace) {
+  auto loadOrder = FitLoadOrder(
+      {"B.esm", "missing.esp", "D.esp", "a.esm"},
+      {"A.esm", "New1.esp", "B.esm", "C.esp", "D.esp", "New2.esp"});
+
+  EXPECT_EQ(std::vector<std::string>({"B.esm",
+                                      "C.esp",
+                                      "D.esp",
+                                      "New2.esp",
+                                      "A.esm",
+                                      "New1.esp"}),
+            loadOrder);
+}
+}
+}
+}
+
+#endif
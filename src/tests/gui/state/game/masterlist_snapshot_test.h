@@ -0,0 +1,142 @@
+/*  LOOT
+
+    A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+    Fallout: New Vegas.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_GAME_MASTERLIST_SNAPSHOT_TEST
+#define LOOT_TESTS_GUI_STATE_GAME_MASTERLIST_SNAPSHOT_TEST
+
+#include "gui/state/game/masterlist_snapshot.h"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "tests/common_game_test_fixture.h"
+
+namespace loot {
+namespace gui {
+namespace test {
+class MasterlistSnapshotTest : public loot::test::CommonGameTestFixture {
+protected:
+  MasterlistSnapshotTest() :
+      snapshotFile_(lootDataPath / "masterlist.snapshot"),
+      masterlistFile_(lootDataPath / "masterlist.yaml") {}
+
+  void writeFile(const std::filesystem::path& file,
+                 const std::string& content) {
+    std::ofstream out(file, std::ios::binary);
+    out << content;
+  }
+
+  const std::filesystem::path snapshotFile_;
+  const std::filesystem::path masterlistFile_;
+};
+
+// Pass an empty first argument, as it's a prefix for the test instantation,
+// but we only have the one so no prefix is necessary.
+INSTANTIATE_TEST_CASE_P(,
+                        MasterlistSnapshotTest,
+                        ::testing::Values(GameType::tes5));
+
+TEST_P(MasterlistSnapshotTest, loadShouldReturnNulloptIfTheFileDoesNotExist) {
+  EXPECT_FALSE(MasterlistSnapshot::Load(snapshotFile_).has_value());
+}
+
+TEST_P(MasterlistSnapshotTest, loadShouldReturnNulloptIfTheFileIsInvalid) {
+  writeFile(snapshotFile_, "not a snapshot");
+
+  EXPECT_FALSE(MasterlistSnapshot::Load(snapshotFile_).has_value());
+}
+
+TEST_P(MasterlistSnapshotTest, loadShouldReturnNulloptIfTheFileIsTruncated) {
+  MasterlistSnapshot snapshot("hash");
+  snapshot.SetKnownBashTags({"Relev", "Delev"});
+  snapshot.Save(snapshotFile_);
+
+  auto size = std::filesystem::file_size(snapshotFile_);
+  std::filesystem::resize_file(snapshotFile_, size - 1);
+
+  EXPECT_FALSE(MasterlistSnapshot::Load(snapshotFile_).has_value());
+}
+
+TEST_P(MasterlistSnapshotTest, loadShouldReadWhatSaveWrote) {
+  PluginMetadata metadata(blankEsm);
+  metadata.SetGroup("group");
+  metadata.SetTags({Tag("Relev"), Tag("Delev", false)});
+  metadata.SetMessages({Message(MessageType::warn, "warning")});
+  metadata.SetDirtyInfo(
+      {PluginCleaningData(0x12345678, "utility", {}, 1, 2, 3)});
+  metadata.SetCleanInfo({PluginCleaningData(0x87654321, "utility")});
+
+  MasterlistSnapshot snapshot("hash");
+  snapshot.SetGeneralMessages({Message(MessageType::say, "note")});
+  snapshot.SetGroups({Group("default"), Group("group", {"default"})});
+  snapshot.SetKnownBashTags({"Relev", "Delev"});
+  snapshot.AddPluginMetadata(metadata);
+  snapshot.Save(snapshotFile_);
+
+  auto loaded = MasterlistSnapshot::Load(snapshotFile_);
+
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ("hash", loaded.value().GetMasterlistHash());
+  EXPECT_EQ(snapshot.GetGeneralMessages(), loaded.value().GetGeneralMessages());
+  EXPECT_EQ(snapshot.GetGroups(), loaded.value().GetGroups());
+  EXPECT_EQ(snapshot.GetKnownBashTags(), loaded.value().GetKnownBashTags());
+
+  auto loadedMetadata = loaded.value().GetPluginMetadata(blankEsm);
+  ASSERT_TRUE(loadedMetadata.has_value());
+  EXPECT_EQ(metadata.GetGroup(), loadedMetadata.value().GetGroup());
+  EXPECT_EQ(metadata.GetTags(), loadedMetadata.value().GetTags());
+  EXPECT_EQ(metadata.GetMessages(), loadedMetadata.value().GetMessages());
+  EXPECT_EQ(metadata.GetDirtyInfo(), loadedMetadata.value().GetDirtyInfo());
+  EXPECT_EQ(metadata.GetCleanInfo(), loadedMetadata.value().GetCleanInfo());
+}
+
+TEST_P(MasterlistSnapshotTest, getPluginMetadataShouldBeCaseInsensitive) {
+  MasterlistSnapshot snapshot("hash");
+  snapshot.AddPluginMetadata(PluginMetadata(blankEsm));
+
+  EXPECT_TRUE(snapshot.GetPluginMetadata(boost::to_lower_copy(blankEsm))
+                  .has_value());
+  EXPECT_FALSE(snapshot.GetPluginMetadata(blankEsp).has_value());
+}
+
+TEST_P(MasterlistSnapshotTest, hashMasterlistShouldOnlyChangeWithItsContent) {
+  writeFile(masterlistFile_, "plugins: []");
+  auto hash = HashMasterlist(masterlistFile_);
+
+  writeFile(masterlistFile_, "plugins: []");
+  EXPECT_EQ(hash, HashMasterlist(masterlistFile_));
+
+  writeFile(masterlistFile_, "plugins: [ ]");
+  EXPECT_NE(hash, HashMasterlist(masterlistFile_));
+}
+
+TEST_P(MasterlistSnapshotTest, hashMasterlistShouldThrowIfTheFileDoesNotExist) {
+  EXPECT_THROW(HashMasterlist(masterlistFile_), FileAccessError);
+}
+}
+}
+}
+
+#endif
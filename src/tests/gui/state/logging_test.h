@@ -0,0 +1,93 @@
+/*  LOOT
+
+    A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+    Fallout: New Vegas.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_LOGGING_TEST
+#define LOOT_TESTS_GUI_STATE_LOGGING_TEST
+
+#include "gui/state/logging.h"
+
+#include <gtest/gtest.h>
+#include <spdlog/sinks/null_sink.h>
+
+namespace loot {
+namespace test {
+class LoggingTest : public ::testing::Test {
+protected:
+  LoggingTest() :
+      logger_(std::make_shared<spdlog::logger>(
+          "logging_test",
+          std::make_shared<spdlog::sinks::null_sink_mt>())),
+      evaluations_(0) {}
+
+  int countEvaluation() { return ++evaluations_; }
+
+  std::shared_ptr<spdlog::logger> logger_;
+  int evaluations_;
+};
+
+TEST_F(LoggingTest, getLoggerShouldReturnTheSameLoggerEachTime) {
+  auto logger = getLogger();
+
+  ASSERT_NE(nullptr, logger);
+  EXPECT_EQ(logger, getLogger());
+}
+
+TEST_F(LoggingTest, logMacrosShouldNotEvaluateArgumentsIfTheLevelIsFiltered) {
+  logger_->set_level(spdlog::level::warn);
+
+  LOOT_LOG_TRACE(logger_, "{}", countEvaluation());
+  LOOT_LOG_DEBUG(logger_, "{}", countEvaluation());
+  LOOT_LOG_INFO(logger_, "{}", countEvaluation());
+
+  EXPECT_EQ(0, evaluations_);
+}
+
+TEST_F(LoggingTest, logMacrosShouldEvaluateArgumentsIfTheLevelIsNotFiltered) {
+  logger_->set_level(spdlog::level::warn);
+
+  LOOT_LOG_WARN(logger_, "{}", countEvaluation());
+  LOOT_LOG_ERROR(logger_, "{}", countEvaluation());
+
+  EXPECT_EQ(2, evaluations_);
+}
+
+TEST_F(LoggingTest, logMacrosShouldNotEvaluateArgumentsIfThereIsNoLogger) {
+  logger_.reset();
+
+  LOOT_LOG_ERROR(logger_, "{}", countEvaluation());
+
+  EXPECT_EQ(0, evaluations_);
+}
+
+TEST_F(LoggingTest, logMacrosShouldEvaluateTheLoggerExpressionOnce) {
+  logger_->set_level(spdlog::level::trace);
+
+  LOOT_LOG_INFO((countEvaluation(), logger_), "message");
+
+  EXPECT_EQ(1, evaluations_);
+}
+}
+}
+
+#endif
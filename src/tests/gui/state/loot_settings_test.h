@@ -80,6 +80,7 @@ TEST_P(LootSettingsTest, defaultConstructorShouldSetDefaultValues) {
   EXPECT_FALSE(settings_.isDebugLoggingEnabled());
   EXPECT_TRUE(settings_.updateMasterlist());
   EXPECT_TRUE(settings_.isLootUpdateCheckEnabled());
+  EXPECT_EQ(512, settings_.getGameCacheMemoryBudget());
   EXPECT_EQ("auto", settings_.getGame());
   EXPECT_EQ("auto", settings_.getLastGame());
   EXPECT_TRUE(settings_.getLastVersion().empty());
@@ -180,6 +181,7 @@ TEST_P(LootSettingsTest, loadingShouldReadFromATomlFile) {
   out << "enableDebugLogging = true" << endl
       << "updateMasterlist = true" << endl
       << "enableLootUpdateCheck = false" << endl
+      << "gameCacheMemoryBudget = 256" << endl
       << "game = \"Oblivion\"" << endl
       << "lastGame = \"Skyrim\"" << endl
       << "language = \"fr\"" << endl
@@ -212,6 +214,7 @@ TEST_P(LootSettingsTest, loadingShouldReadFromATomlFile) {
   EXPECT_TRUE(settings_.isDebugLoggingEnabled());
   EXPECT_TRUE(settings_.updateMasterlist());
   EXPECT_FALSE(settings_.isLootUpdateCheckEnabled());
+  EXPECT_EQ(256, settings_.getGameCacheMemoryBudget());
   EXPECT_EQ("Oblivion", settings_.getGame());
   EXPECT_EQ("Skyrim", settings_.getLastGame());
   EXPECT_EQ("0.7.1", settings_.getLastVersion());
@@ -443,6 +446,7 @@ TEST_P(LootSettingsTest, saveShouldWriteSettingsToPassedTomlFile) {
   settings_.enableDebugLogging(true);
   settings_.updateMasterlist(true);
   settings_.enableLootUpdateCheck(false);
+  settings_.setGameCacheMemoryBudget(128);
   settings_.setDefaultGame(game);
   settings_.storeLastGame(lastGame);
   settings_.setLanguage(language);
@@ -462,6 +466,7 @@ TEST_P(LootSettingsTest, saveShouldWriteSettingsToPassedTomlFile) {
   EXPECT_TRUE(settings.isDebugLoggingEnabled());
   EXPECT_TRUE(settings.updateMasterlist());
   EXPECT_FALSE(settings.isLootUpdateCheckEnabled());
+  EXPECT_EQ(128, settings.getGameCacheMemoryBudget());
   EXPECT_EQ(game, settings.getGame());
   EXPECT_EQ(lastGame, settings.getLastGame());
   EXPECT_EQ(language, settings.getLanguage());
@@ -537,6 +542,106 @@ TEST_P(LootSettingsTest, updateLastVersionShouldSetValueToCurrentLootVersion) {
 
   EXPECT_EQ(currentVersion, settings_.getLastVersion());
 }
+
+TEST_P(LootSettingsTest, saveShouldWriteIfTheFileDoesNotExist) {
+  settings_.save(settingsFile_);
+
+  EXPECT_TRUE(std::filesystem::exists(settingsFile_));
+}
+
+TEST_P(LootSettingsTest, saveShouldNotLeaveATemporaryFileBehind) {
+  settings_.setTheme("dark");
+  settings_.save(settingsFile_);
+
+  auto tempFile = settingsFile_;
+  tempFile += ".tmp";
+  EXPECT_FALSE(std::filesystem::exists(tempFile));
+}
+
+TEST_P(LootSettingsTest, saveShouldNotWriteIfNothingHasChangedSinceLoading) {
+  std::ofstream out(settingsFile_);
+  out << "theme = \"dark\"" << std::endl;
+  out.close();
+
+  settings_.load(settingsFile_, lootDataPath);
+  settings_.setTheme("dark");
+  settings_.save(settingsFile_);
+
+  EXPECT_EQ(std::vector<std::string>({"theme = \"dark\""}),
+            readFileLines(settingsFile_));
+}
+
+TEST_P(LootSettingsTest, saveShouldWriteIfASettingHasChangedSinceLoading) {
+  std::ofstream out(settingsFile_);
+  out << "theme = \"dark\"" << std::endl;
+  out.close();
+
+  settings_.load(settingsFile_, lootDataPath);
+  settings_.storeFilterState("hideCRCs", true);
+  settings_.save(settingsFile_);
+
+  LootSettings settings;
+  settings.load(settingsFile_, lootDataPath);
+
+  EXPECT_EQ("dark", settings.getTheme());
+  EXPECT_TRUE(settings.getFilters().at("hideCRCs"));
+}
+
+TEST_P(LootSettingsTest,
+       saveShouldNotWriteIfNothingHasChangedSinceTheLastSave) {
+  settings_.setTheme("dark");
+  settings_.save(settingsFile_);
+
+  std::ofstream out(settingsFile_);
+  out << "theme = \"light\"" << std::endl;
+  out.close();
+
+  settings_.save(settingsFile_);
+
+  EXPECT_EQ(std::vector<std::string>({"theme = \"light\""}),
+            readFileLines(settingsFile_));
+}
+
+TEST_P(LootSettingsTest, changesShouldNotBeSavedAutomaticallyByDefault) {
+  settings_.setTheme("dark");
+  settings_.flushAutoSave();
+
+  EXPECT_FALSE(std::filesystem::exists(settingsFile_));
+}
+
+TEST_P(LootSettingsTest, changesShouldBeSavedAutomaticallyOnceEnabled) {
+  settings_.enableAutoSave(settingsFile_);
+
+  settings_.setTheme("dark");
+  settings_.storeFilterState("hideCRCs", true);
+  settings_.flushAutoSave();
+
+  LootSettings settings;
+  settings.load(settingsFile_, lootDataPath);
+
+  EXPECT_EQ("dark", settings.getTheme());
+  EXPECT_TRUE(settings.getFilters().at("hideCRCs"));
+}
+
+TEST_P(LootSettingsTest, unchangedValuesShouldNotBeSavedAutomatically) {
+  settings_.enableAutoSave(settingsFile_);
+
+  settings_.setTheme(settings_.getTheme());
+  settings_.storeLastGame(settings_.getLastGame());
+  settings_.flushAutoSave();
+
+  EXPECT_FALSE(std::filesystem::exists(settingsFile_));
+}
+
+TEST_P(LootSettingsTest, flushAutoSaveShouldThrowIfAnAutomaticSaveFailed) {
+  // A directory can't be replaced by the saved settings file.
+  std::filesystem::create_directories(settingsFile_);
+  settings_.enableAutoSave(settingsFile_);
+
+  settings_.setTheme("dark");
+
+  EXPECT_THROW(settings_.flushAutoSave(), std::exception);
+}
 }
 }
 
@@ -0,0 +1,80 @@
+/*  LOOT
+
+    A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+    Fallout: New Vegas.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_TIMELINE_TEST
+#define LOOT_TESTS_GUI_STATE_TIMELINE_TEST
+
+#include "gui/state/timeline.h"
+
+#include <gtest/gtest.h>
+
+namespace loot {
+namespace test {
+TEST(Timeline, shouldHaveNoSpansByDefault) {
+  Timeline timeline;
+
+  EXPECT_TRUE(timeline.GetSpans().empty());
+}
+
+TEST(Timeline, scopedSpanShouldRecordASpanWhenItIsDestroyed) {
+  Timeline timeline;
+
+  {
+    Timeline::ScopedSpan span(timeline, "test");
+    EXPECT_TRUE(timeline.GetSpans().empty());
+  }
+
+  auto spans = timeline.GetSpans();
+  ASSERT_EQ(1, spans.size());
+  EXPECT_EQ("test", spans[0].name);
+  EXPECT_LE(spans[0].start, spans[0].end);
+  EXPECT_EQ(std::this_thread::get_id(), spans[0].threadId);
+}
+
+TEST(Timeline, shouldRecordSpansFromMultipleThreads) {
+  Timeline timeline;
+
+  std::thread thread([&]() { Timeline::ScopedSpan span(timeline, "thread"); });
+  {
+    Timeline::ScopedSpan span(timeline, "main");
+  }
+  thread.join();
+
+  auto spans = timeline.GetSpans();
+  ASSERT_EQ(2, spans.size());
+  EXPECT_NE(spans[0].threadId, spans[1].threadId);
+}
+
+TEST(Timeline, logShouldNotThrow) {
+  Timeline timeline;
+  timeline.Record("test",
+                  std::chrono::steady_clock::now(),
+                  std::chrono::steady_clock::now());
+
+  EXPECT_NO_THROW(timeline.Log("Test timeline"));
+}
+}
+}
+
+#endif
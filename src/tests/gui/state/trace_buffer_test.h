@@ -0,0 +1,131 @@
+/*  LOOT
+
+    A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+    Fallout: New Vegas.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_TRACE_BUFFER_TEST
+#define LOOT_TESTS_GUI_STATE_TRACE_BUFFER_TEST
+
+#include "gui/state/trace_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+namespace loot {
+namespace test {
+std::string getDetail(const std::string& line) {
+  auto position = line.find(": ");
+  if (position == std::string::npos) {
+    return "";
+  }
+
+  return line.substr(position + 2);
+}
+
+TEST(TraceBuffer, shouldHaveNoEventsByDefault) {
+  TraceBuffer buffer;
+
+  EXPECT_TRUE(buffer.Format().empty());
+}
+
+TEST(TraceBuffer, formatShouldIncludeEachEventsMessageAndDetail) {
+  TraceBuffer buffer;
+
+  buffer.Record("first");
+  buffer.Record("second", "detail");
+
+  auto lines = buffer.Format();
+  ASSERT_EQ(2, lines.size());
+  EXPECT_NE(std::string::npos, lines[0].find("] first"));
+  EXPECT_EQ("", getDetail(lines[0]));
+  EXPECT_NE(std::string::npos, lines[1].find("] second: detail"));
+  EXPECT_EQ("detail", getDetail(lines[1]));
+}
+
+TEST(TraceBuffer, recordShouldReplaceTheOldestEventOnceTheBufferIsFull) {
+  TraceBuffer buffer(4);
+
+  for (int i = 0; i < 10; ++i) {
+    buffer.Record("event", std::to_string(i));
+  }
+
+  auto lines = buffer.Format();
+  ASSERT_EQ(4, lines.size());
+  EXPECT_EQ("6", getDetail(lines[0]));
+  EXPECT_EQ("9", getDetail(lines[3]));
+}
+
+TEST(TraceBuffer, recordShouldTruncateLongDetails) {
+  TraceBuffer buffer;
+
+  buffer.Record("event", std::string(TraceBuffer::MAX_DETAIL_LENGTH + 10, 'a'));
+
+  auto lines = buffer.Format();
+  ASSERT_EQ(1, lines.size());
+  EXPECT_EQ(std::string(TraceBuffer::MAX_DETAIL_LENGTH, 'a'),
+            getDetail(lines[0]));
+}
+
+TEST(TraceBuffer, recordShouldNotTruncateInTheMiddleOfAUtf8Character) {
+  TraceBuffer buffer;
+
+  auto detail = std::string(TraceBuffer::MAX_DETAIL_LENGTH - 1, 'a');
+  buffer.Record("event", detail + u8"é");
+
+  auto lines = buffer.Format();
+  ASSERT_EQ(1, lines.size());
+  EXPECT_EQ(detail, getDetail(lines[0]));
+}
+
+TEST(TraceBuffer, formatShouldNotReturnPartiallyWrittenEvents) {
+  TraceBuffer buffer(16);
+  std::atomic<bool> stop(false);
+
+  std::vector<std::thread> threads;
+  for (char c = 'a'; c < 'e'; ++c) {
+    threads.emplace_back([&, c]() {
+      const std::string detail(40, c);
+      while (!stop) {
+        buffer.Record("event", detail);
+      }
+    });
+  }
+
+  for (int i = 0; i < 100; ++i) {
+    for (const auto& line : buffer.Format()) {
+      auto detail = getDetail(line);
+      EXPECT_EQ(40, detail.size());
+      EXPECT_EQ(std::string(40, detail[0]), detail);
+    }
+  }
+
+  stop = true;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+}
+}
+
+#endif
@@ -0,0 +1,126 @@
+/*  LOOT
+
+    A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+    Fallout: New Vegas.
+
+    Copyright (C) 2020    Oliver Hamlet
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#ifndef LOOT_TESTS_GUI_STATE_TRACING_TEST
+#define LOOT_TESTS_GUI_STATE_TRACING_TEST
+
+#include "gui/state/tracing.h"
+
+#include <fstream>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <json.hpp>
+
+#include "tests/gui/test_helpers.h"
+
+namespace loot {
+namespace test {
+class TracingTest : public ::testing::Test {
+public:
+  TracingTest() : traceFile_(getTempPath()) {}
+
+protected:
+  void TearDown() override {
+    stopTracing();
+    std::filesystem::remove(traceFile_);
+  }
+
+  nlohmann::json readTraceFile() const {
+    std::ifstream in(traceFile_);
+    return nlohmann::json::parse(in);
+  }
+
+  const std::filesystem::path traceFile_;
+};
+
+TEST_F(TracingTest, tracingShouldBeDisabledByDefault) {
+  EXPECT_FALSE(isTracingEnabled());
+}
+
+TEST_F(TracingTest, stopTracingShouldDoNothingIfTracingWasNotStarted) {
+  stopTracing();
+
+  EXPECT_FALSE(std::filesystem::exists(traceFile_));
+}
+
+TEST_F(TracingTest, stopTracingShouldWriteRecordedSpansAsCompleteEvents) {
+  startTracing(traceFile_);
+  EXPECT_TRUE(isTracingEnabled());
+  { TraceSpan span("first"); }
+  { TraceSpan span("second", "detail"); }
+  stopTracing();
+
+  EXPECT_FALSE(isTracingEnabled());
+
+  auto json = readTraceFile();
+  auto events = json.at("traceEvents");
+  ASSERT_EQ(2, events.size());
+
+  EXPECT_EQ("first", events[0].at("name"));
+  EXPECT_EQ("X", events[0].at("ph"));
+  EXPECT_LE(0, events[0].at("ts").get<int64_t>());
+  EXPECT_LE(0, events[0].at("dur").get<int64_t>());
+  EXPECT_FALSE(events[0].contains("args"));
+
+  EXPECT_EQ("second", events[1].at("name"));
+  EXPECT_EQ("detail", events[1].at("args").at("detail"));
+  EXPECT_LE(events[0].at("ts").get<int64_t>(),
+            events[1].at("ts").get<int64_t>());
+}
+
+TEST_F(TracingTest, spansShouldNotBeRecordedIfTracingIsStoppedBeforeTheyEnd) {
+  startTracing(traceFile_);
+  {
+    TraceSpan span("span");
+    stopTracing();
+  }
+
+  EXPECT_TRUE(readTraceFile().at("traceEvents").empty());
+}
+
+TEST_F(TracingTest, spansShouldNotBeRecordedIfTheyStartBeforeTracingStarts) {
+  {
+    TraceSpan span("span");
+    startTracing(traceFile_);
+  }
+  stopTracing();
+
+  EXPECT_TRUE(readTraceFile().at("traceEvents").empty());
+}
+
+TEST_F(TracingTest, spansOnDifferentThreadsShouldHaveDifferentThreadIds) {
+  startTracing(traceFile_);
+  { TraceSpan span("main"); }
+  std::thread([]() { TraceSpan span("other"); }).join();
+  stopTracing();
+
+  auto events = readTraceFile().at("traceEvents");
+  ASSERT_EQ(2, events.size());
+  EXPECT_NE(events[0].at("tid"), events[1].at("tid"));
+}
+}
+}
+
+#endif